@@ -0,0 +1,303 @@
+"""Micro-benchmarks of the core kernels.
+
+Times the compiled loops behind ufuncs, casts, copies, reductions,
+sorting, take and put, fancy indexing, dot, FFT and the random samplers,
+and reports each case as time per call, elements/s and GB/s of memory traffic.
+
+Usage::
+
+    python kernels.py                       # run everything
+    python kernels.py -k sort -k take       # only cases matching a pattern
+    python kernels.py --save base.json      # store a baseline
+    python kernels.py --compare base.json   # flag cases slower than it
+
+With --compare, the exit status is 1 if any case is slower than the
+baseline by more than --threshold (default 10%).  Baselines are only
+meaningful on the machine they were taken on.
+"""
+import re
+import sys
+import time
+from optparse import OptionParser
+from timeit import default_timer
+
+try:
+    import json
+except ImportError:
+    import simplejson as json
+
+import numpy as np
+
+SIZES = [1000, 1000000]
+FLOAT_TYPES = ['f4', 'f8']
+INT_TYPES = ['i4', 'i8']
+
+
+class Case(object):
+    """One benchmark: `func` processes `nelem` elements and moves `nbytes`
+    bytes per call."""
+
+    def __init__(self, name, func, nelem, nbytes):
+        self.name = name
+        self.func = func
+        self.nelem = nelem
+        self.nbytes = nbytes
+
+    def time(self, mintime=0.2, repeat=3):
+        """Best time per call, calling often enough that each of the
+        `repeat` measurements takes at least `mintime` seconds."""
+        func = self.func
+        number = 1
+        while True:
+            t = default_timer()
+            for i in xrange(number):
+                func()
+            t = default_timer() - t
+            if t >= mintime / 10 or number >= 1 << 20:
+                break
+            number *= 10
+        number = max(1, int(number * mintime / max(t, 1e-9)))
+        best = None
+        for r in range(repeat):
+            t = default_timer()
+            for i in xrange(number):
+                func()
+            t = (default_timer() - t) / number
+            if best is None or t < best:
+                best = t
+        return best
+
+
+def _data(n, dtype, stride=1, seed=0):
+    rs = np.random.RandomState(seed)
+    a = (rs.random_sample(n*stride) * 100).astype(dtype)
+    return a[::stride]
+
+
+def ufunc_cases():
+    binary = [np.add, np.multiply, np.divide]
+    unary = [np.sqrt, np.exp, np.negative]
+    for n in SIZES:
+        for dt in FLOAT_TYPES + INT_TYPES:
+            size = np.dtype(dt).itemsize
+            for stride in [1, 2]:
+                a = _data(n, dt, stride, 0)
+                b = _data(n, dt, stride, 1) + 1
+                out = np.empty(n, dt)
+                for uf in binary:
+                    yield Case('ufunc.%s.%s.s%d.%d' % (uf.__name__, dt,
+                                                      stride, n),
+                               lambda uf=uf, a=a, b=b, out=out: uf(a, b, out),
+                               n, 3*n*size)
+                if dt in INT_TYPES:
+                    continue
+                for uf in unary:
+                    yield Case('ufunc.%s.%s.s%d.%d' % (uf.__name__, dt,
+                                                      stride, n),
+                               lambda uf=uf, a=a, out=out: uf(a, out),
+                               n, 2*n*size)
+
+
+def cast_cases():
+    pairs = [('f8', 'f4'), ('f4', 'f8'), ('i4', 'f8'), ('f8', 'i8'),
+             ('i8', 'i4'), ('f8', 'c16'), ('?', 'f8')]
+    for n in SIZES:
+        for src, dst in pairs:
+            a = _data(n, src)
+            out = np.empty(n, dst)
+            nbytes = n * (np.dtype(src).itemsize + np.dtype(dst).itemsize)
+            # Assigning into an existing array goes through CastTo.
+            def f(a=a, out=out):
+                out[...] = a
+            yield Case('cast.%s->%s.%d' % (src, dst, n), f, n, nbytes)
+
+
+def copy_cases():
+    for n in [100, 1000, 4000]:
+        for dt in ['f4', 'f8', 'c16']:
+            a = _data(n*n, dt).reshape(n, n)
+            nbytes = 2 * a.size * a.itemsize
+            yield Case('copy.%s.%d' % (dt, n), lambda a=a: a.copy(),
+                       a.size, nbytes)
+            yield Case('copy.transposed.%s.%d' % (dt, n),
+                       lambda a=a: np.ascontiguousarray(a.T), a.size, nbytes)
+            yield Case('ravel.transposed.%s.%d' % (dt, n),
+                       lambda a=a: a.T.ravel(), a.size, nbytes)
+
+
+def reduce_cases():
+    for dt in FLOAT_TYPES + INT_TYPES:
+        size = np.dtype(dt).itemsize
+        a = _data(1000000, dt)
+        yield Case('reduce.add.%s.1d' % dt, lambda a=a: np.add.reduce(a),
+                   a.size, a.size*size)
+        yield Case('reduce.maximum.%s.1d' % dt,
+                   lambda a=a: np.maximum.reduce(a), a.size, a.size*size)
+        m = a.reshape(1000, 1000)
+        for axis in [0, 1]:
+            yield Case('reduce.add.%s.axis%d' % (dt, axis),
+                       lambda m=m, axis=axis: np.add.reduce(m, axis),
+                       m.size, m.size*size)
+
+
+def sort_cases():
+    n = 100000
+    for dt in ['i4', 'i8', 'f4', 'f8']:
+        size = np.dtype(dt).itemsize
+        a = _data(n, dt)
+        for kind in ['quicksort', 'mergesort', 'heapsort']:
+            yield Case('sort.%s.%s' % (kind, dt),
+                       lambda a=a, kind=kind: np.sort(a, kind=kind),
+                       n, 2*n*size)
+            yield Case('argsort.%s.%s' % (kind, dt),
+                       lambda a=a, kind=kind: a.argsort(kind=kind),
+                       n, n*(size + np.intp(0).itemsize))
+    a = np.sort(_data(n, 'f8'))
+    yield Case('sort.quicksort.f8.sorted', lambda a=a: np.sort(a), n, 16*n)
+
+
+def index_cases():
+    n = 1000000
+    a = _data(n, 'f8')
+    ind = np.random.RandomState(2).randint(0, n, n // 10)
+    v = _data(ind.size, 'f8')
+    mask = a > 50
+    ni = ind.size
+    isize = np.intp(0).itemsize
+    yield Case('take.f8', lambda: a.take(ind), ni, ni*(16 + isize))
+    yield Case('put.f8', lambda: a.put(ind, v), ni, ni*(16 + isize))
+    yield Case('fancy.get.f8', lambda: a[ind], ni, ni*(16 + isize))
+    def setitem():
+        a[ind] = v
+    yield Case('fancy.set.f8', setitem, ni, ni*(16 + isize))
+    yield Case('fancy.bool.get.f8', lambda: a[mask], n, n*9)
+    m = a.reshape(1000, 1000)
+    rows = ind[:100] % 1000
+    yield Case('fancy.rows.f8', lambda: m[rows], 100*1000, 2*100*1000*8)
+
+
+def dot_cases():
+    for n in [100, 1000]:
+        v = _data(n*n, 'f8')
+        yield Case('dot.vv.%d' % (n*n), lambda v=v: np.dot(v, v),
+                   n*n, 2*n*n*8)
+        m = v.reshape(n, n)
+        x = v[:n]
+        yield Case('dot.mv.%d' % n, lambda m=m, x=x: np.dot(m, x),
+                   n*n, n*n*8)
+    for n in [100, 300]:
+        m = _data(n*n, 'f8').reshape(n, n)
+        yield Case('dot.mm.%d' % n, lambda m=m: np.dot(m, m),
+                   n*n*n, 3*n*n*8)
+
+
+def fft_cases():
+    for n in [1024, 1000, 1021, 65536]:
+        a = _data(n, 'c16') + 1j
+        yield Case('fft.c16.%d' % n, lambda a=a: np.fft.fft(a), n, 2*n*16)
+        r = _data(n, 'f8')
+        yield Case('rfft.f8.%d' % n, lambda r=r: np.fft.rfft(r), n,
+                   n*8 + (n//2 + 1)*16)
+
+
+def random_cases():
+    n = 1000000
+    rs = np.random.RandomState(0)
+    samplers = [
+        ('random_sample', lambda: rs.random_sample(n)),
+        ('randint', lambda: rs.randint(0, 1000, n)),
+        ('standard_normal', lambda: rs.standard_normal(n)),
+        ('standard_normal.zig',
+         lambda: rs.standard_normal(n, method='zig')),
+        ('standard_exponential', lambda: rs.standard_exponential(n)),
+        ('standard_gamma', lambda: rs.standard_gamma(2.5, n)),
+        ('binomial', lambda: rs.binomial(10, 0.3, n)),
+        ('poisson', lambda: rs.poisson(3.0, n)),
+        ]
+    for name, f in samplers:
+        yield Case('random.%s' % name, f, n, n*8)
+
+
+GROUPS = [ufunc_cases, cast_cases, copy_cases, reduce_cases, sort_cases,
+          index_cases, dot_cases, fft_cases, random_cases]
+
+
+def all_cases(patterns=None):
+    for group in GROUPS:
+        for case in group():
+            if patterns and not [p for p in patterns
+                                 if re.search(p, case.name)]:
+                continue
+            yield case
+
+
+def main(argv):
+    parser = OptionParser(usage='%prog [options]')
+    parser.add_option('-k', dest='patterns', action='append', default=[],
+                      help='only run cases whose name matches this regular '
+                           'expression (may be repeated)')
+    parser.add_option('--mintime', type='float', default=0.2,
+                      help='minimum seconds per measurement')
+    parser.add_option('--repeat', type='int', default=3,
+                      help='measurements per case; the best is kept')
+    parser.add_option('--save', metavar='FILE',
+                      help='write the results to FILE as JSON')
+    parser.add_option('--compare', metavar='FILE',
+                      help='compare against a baseline saved with --save')
+    parser.add_option('--threshold', type='float', default=0.1,
+                      help='relative slowdown that counts as a regression')
+    options, args = parser.parse_args(argv)
+
+    baseline = {}
+    if options.compare:
+        f = open(options.compare)
+        try:
+            baseline = json.load(f)['results']
+        finally:
+            f.close()
+
+    results = {}
+    regressions = []
+    print '%-40s %12s %12s %9s %s' % ('case', 'time', 'elem/s', 'GB/s',
+                                      'vs. baseline' if baseline else '')
+    print '-'*79
+    for case in all_cases(options.patterns):
+        try:
+            t = case.time(options.mintime, options.repeat)
+        except Exception, e:
+            print '%-40s failed (%s)' % (case.name, e)
+            continue
+        results[case.name] = {'time': t, 'elements': case.nelem,
+                              'bytes': case.nbytes}
+        line = '%-40s %10.3gus %12.4g %9.3f' % (case.name, t*1e6,
+                                                case.nelem / t,
+                                                case.nbytes / t / 1e9)
+        if case.name in baseline:
+            ratio = t / baseline[case.name]['time']
+            line += ' %6.2fx' % ratio
+            if ratio > 1 + options.threshold:
+                line += ' SLOWER'
+                regressions.append(case.name)
+        print line
+        sys.stdout.flush()
+    print '-'*79
+
+    if options.save:
+        f = open(options.save, 'w')
+        try:
+            json.dump({'numpy': np.__version__, 'python': sys.version,
+                       'platform': sys.platform, 'date': time.ctime(),
+                       'results': results}, f, indent=1, sort_keys=True)
+        finally:
+            f.close()
+    if regressions:
+        print '%d case(s) slower than the baseline by more than %d%%:' % (
+            len(regressions), options.threshold*100)
+        for name in regressions:
+            print '    ' + name
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
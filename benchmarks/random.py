@@ -0,0 +1,30 @@
+from benchmark import Benchmark
+
+modules = ['numpy']
+b = Benchmark(modules,runs=3,reps=10)
+
+N = 1000000
+b.title = 'Drawing %d standard normals, polar method' % N
+b['numpy'] = ('rs.standard_normal(%d)' % N,
+              'rs = np.random.RandomState(0)')
+b.run()
+
+b.title = 'Drawing %d standard normals, Ziggurat method' % N
+b['numpy'] = ('rs.standard_normal(%d, method="zig")' % N,
+              'rs = np.random.RandomState(0)')
+b.run()
+
+b.title = 'Drawing %d standard exponentials, inversion' % N
+b['numpy'] = ('rs.standard_exponential(%d)' % N,
+              'rs = np.random.RandomState(0)')
+b.run()
+
+b.title = 'Drawing %d standard exponentials, Ziggurat method' % N
+b['numpy'] = ('rs.standard_exponential(%d, method="zig")' % N,
+              'rs = np.random.RandomState(0)')
+b.run()
+
+b.title = 'Drawing %d gamma(2.5) variates' % N
+b['numpy'] = ('rs.standard_gamma(2.5, %d)' % N,
+              'rs = np.random.RandomState(0)')
+b.run()
@@ -3221,7 +3221,7 @@ add_newdoc('numpy.core.multiarray', 'ndarray', ('take',
 
 add_newdoc('numpy.core.multiarray', 'ndarray', ('tofile',
     """
-    a.tofile(fid, sep="", format="%s")
+    a.tofile(fid, sep="", format="%s", byteorder=None)
 
     Write array to a file as text or binary (default).
 
@@ -3241,6 +3241,14 @@ add_newdoc('numpy.core.multiarray', 'ndarray', ('tofile',
         Format string for text file output.
         Each entry in the array is formatted to text by first converting
         it to the closest Python type, and then using "format" % item.
+        Without a format, floats are written with the fewest digits that
+        read back to the same value; "%r" does the same.
+    byteorder : {None, '<', '>', '=', 'S'}, optional
+        Byte order of the binary output.  By default the data is written
+        in the byte order of `a`.  Otherwise the elements are swapped on
+        the way out as needed, without making a swapped copy of `a`.  'S'
+        always swaps, and is the only choice that swaps the fields of a
+        record array.  Ignored for text output.
 
     Notes
     -----
@@ -3793,12 +3801,13 @@ add_newdoc('numpy.lib._compiled_base', 'digitize',
 
 add_newdoc('numpy.lib._compiled_base', 'bincount',
     """
-    bincount(x, weights=None)
+    bincount(x, weights=None, minlength=None)
 
     Count number of occurrences of each value in array of non-negative ints.
 
     The number of bins (of size 1) is one larger than the largest value in
-    `x`. Each bin gives the number of occurrences of its index value in `x`.
+    `x`, or `minlength` if that is larger. Each bin gives the number of
+    occurrences of its index value in `x`.
     If `weights` is specified the input array is weighted by it, i.e. if a
     value ``n`` is found at position ``i``, ``out[n] += weight[i]`` instead
     of ``out[n] += 1``.
@@ -3809,12 +3818,15 @@ add_newdoc('numpy.lib._compiled_base', 'bincount',
         Input array.
     weights : array_like, optional
         Weights, array of the same shape as `x`.
+    minlength : int, optional
+        A minimum number of bins for the output array. `x` may be empty
+        if this is given.
 
     Returns
     -------
     out : ndarray of ints
         The result of binning the input array.
-        The length of `out` is equal to ``np.amax(x)+1``.
+        The length of `out` is equal to ``max(np.amax(x)+1, minlength)``.
 
     Raises
     ------
@@ -3828,6 +3840,11 @@ add_newdoc('numpy.lib._compiled_base', 'bincount',
     --------
     histogram, digitize, unique
 
+    Notes
+    -----
+    Integer arrays of any size are counted in their own type, without
+    first being converted to ``intp``.
+
     Examples
     --------
     >>> np.bincount(np.arange(5))
@@ -3852,6 +3869,9 @@ add_newdoc('numpy.lib._compiled_base', 'bincount',
     >>> np.bincount(x,  weights=w)
     array([ 0.3,  0.7,  1.1])
 
+    >>> np.bincount(x, minlength=5)
+    array([1, 2, 3, 0, 0])
+
     """)
 
 add_newdoc('numpy.lib._compiled_base', 'add_docstring',
@@ -3866,7 +3886,7 @@ add_newdoc('numpy.lib._compiled_base', 'add_docstring',
 
 add_newdoc('numpy.lib._compiled_base', 'packbits',
     """
-    packbits(myarray, axis=None)
+    packbits(myarray, axis=None, bitorder='big')
 
     Packs the elements of a binary-valued array into bits in a uint8 array.
 
@@ -3875,10 +3895,14 @@ add_newdoc('numpy.lib._compiled_base', 'packbits',
     Parameters
     ----------
     myarray : array_like
-        An integer type array whose elements should be packed to bits.
+        An integer or boolean array whose elements should be packed to bits.
     axis : int, optional
         The dimension over which bit-packing is done.
         ``None`` implies packing the flattened array.
+    bitorder : {'big', 'little'}, optional
+        The order of the bits within each byte. 'big' puts the first
+        element in the most significant bit, 'little' in the least
+        significant one. Default is 'big'.
 
     Returns
     -------
@@ -3910,7 +3934,7 @@ add_newdoc('numpy.lib._compiled_base', 'packbits',
 
 add_newdoc('numpy.lib._compiled_base', 'unpackbits',
     """
-    unpackbits(myarray, axis=None)
+    unpackbits(myarray, axis=None, bitorder='big')
 
     Unpacks elements of a uint8 array into a binary-valued output array.
 
@@ -3925,6 +3949,10 @@ add_newdoc('numpy.lib._compiled_base', 'unpackbits',
        Input array.
     axis : int, optional
        Unpacks along this axis.
+    bitorder : {'big', 'little'}, optional
+       The order in which the bits of each byte are returned, starting
+       from the most significant bit for 'big' and from the least
+       significant bit for 'little'. Default is 'big'.
 
     Returns
     -------
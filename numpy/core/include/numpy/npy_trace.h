@@ -0,0 +1,94 @@
+#ifndef _NPY_TRACE_H_
+#define _NPY_TRACE_H_
+
+/*
+ * Optional tracing of the major core operations.
+ *
+ * When numpy is built with NPY_TRACE set (the NPY_TRACE environment
+ * variable at build time), ufunc calls and reductions, casts, take, sort
+ * and array creation each report one event per call to a C callback.
+ * Otherwise the macros below compile to nothing.
+ *
+ * A sink is installed through the state that numpy.core.multiarray
+ * exports as the _TRACE_STATE capsule:
+ *
+ *     NpyTrace_State *state;
+ *
+ *     state = NpyCapsule_AsVoidPtr(
+ *         PyObject_GetAttrString(multiarray_module, "_TRACE_STATE"));
+ *     state->data = my_data;
+ *     state->sink = my_sink;
+ *
+ * The attribute is missing when numpy was built without tracing.  The
+ * sink is called in the thread that did the work, possibly without the
+ * GIL, and must not call back into numpy.
+ *
+ * In an instrumented function, NPY_TRACE_DEF goes last among the
+ * declarations, and an event is only reported if NPY_TRACE_END is
+ * reached, so calls that fail are not reported.
+ */
+
+/* Which path an operation took */
+#define NPY_TRACE_BUFFERED 0x1      /* data went through a buffer or copy */
+#define NPY_TRACE_CASTING  0x2      /* data was converted between types */
+#define NPY_TRACE_STRIDED  0x4      /* non-contiguous data was looped over */
+
+typedef struct {
+        const char *name;           /* the entry point, e.g. "NpyArray_Sort" */
+        const char *detail;         /* e.g. the ufunc name, or NULL */
+        npy_uint64 start, end;      /* monotonic timestamps in nanoseconds */
+        npy_intp count;             /* number of elements processed */
+        npy_intp bytes_read;
+        npy_intp bytes_written;
+        int flags;                  /* NPY_TRACE_BUFFERED etc. */
+} NpyTrace_Event;
+
+typedef void (NpyTrace_SinkFunc)(const NpyTrace_Event *event, void *data);
+
+typedef struct {
+        NpyTrace_SinkFunc *sink;    /* NULL when nobody listens */
+        void *data;
+        npy_uint64 (*clock)(void);
+} NpyTrace_State;
+
+#if defined(NPY_TRACE) && NPY_TRACE
+
+extern NPY_VISIBILITY_HIDDEN NpyTrace_State *npy_trace_state;
+
+#define NPY_TRACE_DEF NpyTrace_Event _npy_trace; int _npy_tracing
+#define NPY_TRACE_BEGIN(nm) do {                                        \
+        _npy_tracing = (npy_trace_state != NULL &&                      \
+                        npy_trace_state->sink != NULL);                 \
+        _npy_trace.name = (nm);                                         \
+        _npy_trace.detail = NULL;                                       \
+        _npy_trace.count = 0;                                           \
+        _npy_trace.bytes_read = _npy_trace.bytes_written = 0;           \
+        _npy_trace.flags = 0;                                           \
+        _npy_trace.start = _npy_tracing ? npy_trace_state->clock() : 0; \
+    } while (0)
+#define NPY_TRACE_DETAIL(s) (_npy_trace.detail = (s))
+#define NPY_TRACE_ITEMS(n, nread, nwritten) do {                        \
+        _npy_trace.count = (n);                                         \
+        _npy_trace.bytes_read = (nread);                                \
+        _npy_trace.bytes_written = (nwritten);                          \
+    } while (0)
+#define NPY_TRACE_PATH(f) (_npy_trace.flags |= (f))
+#define NPY_TRACE_END do {                                              \
+        if (_npy_tracing && npy_trace_state->sink != NULL) {            \
+            _npy_trace.end = npy_trace_state->clock();                  \
+            npy_trace_state->sink(&_npy_trace, npy_trace_state->data);  \
+        }                                                               \
+    } while (0)
+
+#else
+
+#define NPY_TRACE_DEF
+#define NPY_TRACE_BEGIN(nm) ((void)0)
+#define NPY_TRACE_DETAIL(s) ((void)0)
+#define NPY_TRACE_ITEMS(n, nread, nwritten) ((void)0)
+#define NPY_TRACE_PATH(f) ((void)0)
+#define NPY_TRACE_END ((void)0)
+
+#endif
+
+#endif
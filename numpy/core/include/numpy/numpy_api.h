@@ -265,6 +265,7 @@ void NpyArray_UpdateFlags(NpyArray *ret, int flagmask);
 
 
 #include <numpy/npy_iterators.h>
+#include <numpy/npy_trace.h>
 
 
 /* methods.c */
@@ -334,6 +335,7 @@ NpyArray *NpyArray_FromBinaryFile(FILE *fp, PyArray_Descr *dtype, npy_intp num);
 NpyArray *NpyArray_FromBinaryString(char *data, npy_intp slen, PyArray_Descr *dtype, npy_intp num);
 NpyArray *NpyArray_CheckFromArray(NpyArray *arr, PyArray_Descr *descr, int requires);
 int NpyArray_ToBinaryFile(NpyArray *self, FILE *fp);
+int NpyArray_ToBinaryFileSwap(NpyArray *self, FILE *fp, int swap);
 
 int NpyArray_MoveInto(NpyArray *dest, NpyArray *src);
 
@@ -509,6 +511,11 @@ extern int _flat_copyinto(NpyArray *dst, NpyArray *src, NPY_ORDER order);
 extern void _unaligned_strided_byte_copy(char *dst, npy_intp outstrides, char *src,
                                          npy_intp instrides, npy_intp N, int elsize);
 extern void _strided_byte_swap(void *p, npy_intp stride, npy_intp n, int size);
+extern int _is_transposed_copy(npy_intp *dstrides, npy_intp *sstrides,
+                               npy_intp *dims, int nd);
+extern void _transposed_copy(char *dst, npy_intp *dstrides, char *src,
+                             npy_intp *sstrides, npy_intp *dims, int nd,
+                             int elsize);
 
 //extern NpyArray_Descr * _array_small_type(NpyArray_Descr *chktype, NpyArray_Descr* mintype);
 
@@ -2,12 +2,14 @@ __all__ = ['memmap']
 
 import warnings
 from numeric import uint8, ndarray, dtype
+from multiarray import _madvise
 import sys
 
 from numpy.compat import asbytes
 
 dtypedescr = dtype
 valid_filemodes = ["r", "c", "r+", "w+"]
+valid_access = [None, "normal", "sequential", "random", "willneed"]
 writeable_filemodes = ["r+","w+"]
 
 mode_equivalents = {
@@ -60,6 +62,14 @@ class memmap(ndarray):
         Specify the order of the ndarray memory layout: C (row-major) or
         Fortran (column-major).  This only has an effect if the shape is
         greater than 1-D.  The default order is 'C'.
+    access : {None, 'sequential', 'random', 'willneed', 'normal'}, optional
+        How the array is expected to be read, passed on to the operating
+        system as a hint for the mapped pages.  'sequential' makes the
+        kernel read well ahead of a front-to-back scan and drop pages
+        behind it, 'random' turns read-ahead off, and 'willneed' starts
+        reading the whole array into the page cache in the background.
+        Ignored where the platform has no ``madvise``.  The default,
+        None, gives no hint.
 
     Attributes
     ----------
@@ -69,10 +79,14 @@ class memmap(ndarray):
         Offset position in the file.
     mode : str
         File mode.
+    access : str or None
+        The access-pattern hint the memmap was created with.
 
 
     Methods
     -------
+    advise
+        Give an access-pattern hint for the pages of this array.
     close
         Close the memmap file.
     flush
@@ -176,7 +190,7 @@ class memmap(ndarray):
 
     __array_priority__ = -100.0
     def __new__(subtype, filename, dtype=uint8, mode='r+', offset=0,
-                shape=None, order='C'):
+                shape=None, order='C', access=None):
         # Import here to minimize 'import numpy' overhead
         import mmap
         import os.path
@@ -192,6 +206,9 @@ class memmap(ndarray):
         else:
             fid = open(filename, (mode == 'c' and 'r' or mode)+'b')
 
+        if access not in valid_access:
+            raise ValueError("access must be one of %s" % valid_access)
+
         if (mode == 'w+') and shape is None:
             raise ValueError, "shape must be given"
 
@@ -243,6 +260,9 @@ class memmap(ndarray):
         self._mmap = mm
         self.offset = offset
         self.mode = mode
+        self.access = access
+        if access is not None:
+            self.advise(access)
 
         if isinstance(filename, basestring):
             self.filename = os.path.abspath(filename)
@@ -257,8 +277,35 @@ class memmap(ndarray):
             self.filename = obj.filename
             self.offset = obj.offset
             self.mode = obj.mode
+            self.access = getattr(obj, 'access', None)
         else:
             self._mmap = None
+            self.access = None
+
+    def advise(self, advice):
+        """
+        Give the operating system an access-pattern hint for this array.
+
+        The hint covers the pages spanned by the array, so it can be given
+        for a slice that is about to be read, e.g.
+        ``m[i:i+n].advise('willneed')`` starts reading that block into the
+        page cache while the previous block is being processed.
+
+        Parameters
+        ----------
+        advice : {'sequential', 'random', 'willneed', 'normal'}
+            See the `access` parameter of `memmap`.
+
+        Returns
+        -------
+        out : bool
+            False if the platform has no ``madvise`` and the hint was
+            ignored.
+
+        """
+        if self._mmap is None:
+            return False
+        return _madvise(self, advice)
 
     def flush(self):
         """
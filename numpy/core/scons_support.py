@@ -210,6 +210,11 @@ def define_no_smp():
             nosmp = 0
     return nosmp == 1
 
+def is_npy_trace():
+    """Return True if the core should be built with the tracing hooks of
+    numpy/npy_trace.h (when the NPY_TRACE environment variable is set)."""
+    return 'NPY_TRACE' in os.environ
+
 # Inline check
 def CheckInline(context):
     context.Message("Checking for inline keyword... ")
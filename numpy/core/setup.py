@@ -99,6 +99,11 @@ def is_npy_no_smp():
             nosmp = 0
     return nosmp == 1
 
+def is_npy_trace():
+    """Return True if the core should be built with the tracing hooks of
+    numpy/npy_trace.h (when the NPY_TRACE environment variable is set)."""
+    return 'NPY_TRACE' in os.environ
+
 def win32_checks(deflist):
     from numpy.distutils.misc_util import get_build_architecture
     a = get_build_architecture()
@@ -511,6 +516,11 @@ def configuration(parent_package='',top_path=None):
             else:
                 moredefs.append(('NPY_NO_SMP', 0))
 
+            if is_npy_trace():
+                moredefs.append(('NPY_TRACE', 1))
+            else:
+                moredefs.append(('NPY_TRACE', 0))
+
             mathlibs = check_mathlib(config_cmd)
             moredefs.extend(cocache.check_ieee_macros(config_cmd)[1])
             moredefs.extend(cocache.check_complex(config_cmd, mathlibs)[1])
@@ -738,6 +748,8 @@ def configuration(parent_package='',top_path=None):
             join('src', 'multiarray', 'scalartypes.h'),
             join('src', 'multiarray', 'sequence.h'),
             join('src', 'multiarray', 'shape.h'),
+            join('src', 'multiarray', 'textreading.h'),
+            join('src', 'multiarray', 'textwriting.h'),
             join('src', 'multiarray', 'ucsnarrow.h'),
             join('src', 'multiarray', 'usertypes.h')]
 
@@ -767,6 +779,8 @@ def configuration(parent_package='',top_path=None):
         join('src', 'multiarray', 'usertypes.c'),
         join('src', 'multiarray', 'scalarapi.c'),
         join('src', 'multiarray', 'refcount.c'),
+        join('src', 'multiarray', 'textreading.c'),
+        join('src', 'multiarray', 'textwriting.c'),
         join('src', 'multiarray', 'arraytypes.c.src'),
         join('src', 'multiarray', 'scalartypes.c.src')]
 
@@ -791,6 +805,12 @@ def configuration(parent_package='',top_path=None):
         umath_src.append(generate_umath_templated_sources)
         umath_src.append(join('src', 'umath', 'funcs.inc.src'))
 
+    multiarray_libs = ['npymath', 'numpy']
+    if is_npy_trace() and sys.platform.startswith('linux'):
+        # the trace clock uses clock_gettime, which is in librt before
+        # glibc 2.17
+        multiarray_libs.append('rt')
+
     config.add_extension('multiarray',
                          sources = multiarray_src +
                                 [generate_config_h,
@@ -799,7 +819,7 @@ def configuration(parent_package='',top_path=None):
                                  join(codegen_dir,'generate_numpy_api.py'),
                                  join('*.py')],
                          depends = deps + multiarray_deps + libnumpy_source,
-                         libraries=['npymath','numpy'])
+                         libraries=multiarray_libs)
 
     config.add_extension('umath',
                          sources = [generate_config_h,
@@ -9,6 +9,15 @@
 #include "npy_config.h"
 #include "numpy/numpy_api.h"
 
+#if NPY_TRACE
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#include <sys/time.h>
+#endif
+#endif
+
 
 
 int 
@@ -81,3 +90,36 @@ Npy_IsWriteable(NpyArray *ap)
     }
     return NPY_TRUE;
 }
+
+
+#if NPY_TRACE
+
+/* Monotonic time in nanoseconds, for the trace timestamps */
+static npy_uint64
+_trace_clock(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER count, freq;
+
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (npy_uint64)((double)count.QuadPart * 1e9 / freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (npy_uint64)ts.tv_sec*1000000000 + ts.tv_nsec;
+#else
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (npy_uint64)tv.tv_sec*1000000000 + tv.tv_usec*1000;
+#endif
+}
+
+static NpyTrace_State _trace_state = {NULL, NULL, _trace_clock};
+
+/* Exported by multiarray as _TRACE_STATE, and picked up by umath */
+NpyTrace_State *npy_trace_state = &_trace_state;
+
+#endif
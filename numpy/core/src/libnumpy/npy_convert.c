@@ -13,12 +13,41 @@
 
 
 
+/*
+ * Size in bytes of the staging buffer non-contiguous arrays are gathered
+ * into before being written out.
+ */
+#define BINARY_CHUNK_SIZE (1 << 20)
+
+
+/*
+ * Writes the data of the array to fp in C order.
+ */
 int 
 NpyArray_ToBinaryFile(NpyArray *self, FILE *fp)
 {
-    npy_intp size;
-    npy_intp n;
+    return NpyArray_ToBinaryFileSwap(self, fp, 0);
+}
+
+
+/*
+ * Writes the data of the array to fp in C order, byte-swapping every
+ * element on the way out if swap is non-zero.
+ *
+ * A non-contiguous or swapped array is gathered into a staging buffer one
+ * run along the last axis at a time, swapped there, and written out in
+ * chunks of BINARY_CHUNK_SIZE bytes rather than with one fwrite per
+ * element.
+ */
+int 
+NpyArray_ToBinaryFileSwap(NpyArray *self, FILE *fp, int swap)
+{
+    npy_intp size, elsize, chunk, pos, written, n_written;
+    npy_intp len, stride, n, k;
     NpyArrayIterObject *it;
+    char *buf, *src;
+    int axis;
+    NPY_BEGIN_THREADS_DEF;
         
     /* binary data */
     if (NpyDataType_FLAGCHK(self->descr, NPY_LIST_PICKLE)) {
@@ -28,11 +57,12 @@ NpyArray_ToBinaryFile(NpyArray *self, FILE *fp)
         return -1;
     }
     
-    if (NpyArray_ISCONTIGUOUS(self)) {
-        size = NpyArray_SIZE(self);
+    size = NpyArray_SIZE(self);
+    elsize = self->descr->elsize;
+    if (!swap && NpyArray_ISCONTIGUOUS(self)) {
         NPY_BEGIN_ALLOW_THREADS;
         n = fwrite((const void *)self->data,
-                   (size_t) self->descr->elsize,
+                   (size_t) elsize,
                    (size_t) size, fp);
         NPY_END_ALLOW_THREADS;
         if (n < size) {
@@ -41,28 +71,83 @@ NpyArray_ToBinaryFile(NpyArray *self, FILE *fp)
                           (long) size, (long) n);
             return -1;
         }
+        return 0;
+    }
+    if (size == 0 || elsize == 0) {
+        return 0;
+    }
+
+    chunk = NPY_MAX(BINARY_CHUNK_SIZE / elsize, 1);
+    chunk = NPY_MIN(chunk, size);
+    buf = NpyDataMem_NEW(chunk*elsize);
+    if (buf == NULL) {
+        NpyErr_NoMemory();
+        return -1;
+    }
+    axis = NpyArray_NDIM(self) - 1;
+    it = NpyArray_IterAllButAxis(self, &axis);
+    if (it == NULL) {
+        NpyDataMem_FREE(buf);
+        return -1;
+    }
+    if (NpyArray_NDIM(self) == 0) {
+        len = 1;
+        stride = elsize;
     }
     else {
-        NPY_BEGIN_THREADS_DEF;
-        
-        it = NpyArray_IterNew(self);
+        len = NpyArray_DIM(self, axis);
+        stride = NpyArray_STRIDE(self, axis);
+    }
+
+    pos = 0;
+    written = 0;
+    /* VOID_copyswapn points self->descr at each field while it swaps */
+    if (!swap || self->descr->type_num != NPY_VOID) {
         NPY_BEGIN_THREADS;
-        while (it->index < it->size) {
-            if (fwrite((const void *)it->dataptr,
-                       (size_t) self->descr->elsize,
-                       1, fp) < 1) {
-                NPY_END_THREADS;
-                NpyErr_Format(NpyExc_IOError,
-                              "problem writing element"\
-                              " %"NPY_INTP_FMT" to file",
-                              it->index);
-                _Npy_DECREF(it);
-                return -1;
+    }
+    while (it->index < it->size) {
+        src = it->dataptr;
+        for (n = len; n > 0; n -= k) {
+            k = NPY_MIN(n, chunk - pos);
+            if (stride == elsize) {
+                memcpy(buf + pos*elsize, src, k*elsize);
+            }
+            else {
+                _unaligned_strided_byte_copy(buf + pos*elsize, elsize,
+                                             src, stride, k, elsize);
+            }
+            if (swap) {
+                self->descr->f->copyswapn(buf + pos*elsize, elsize, NULL, -1,
+                                          k, 1, self);
+            }
+            src += k*stride;
+            pos += k;
+            if (pos == chunk) {
+                n_written = fwrite(buf, (size_t) elsize, (size_t) pos, fp);
+                written += n_written;
+                if (n_written < pos) {
+                    goto fail;
+                }
+                pos = 0;
             }
-            NpyArray_ITER_NEXT(it);
         }
-        NPY_END_THREADS;
-        _Npy_DECREF(it);
+        NpyArray_ITER_NEXT(it);
+    }
+    if (pos > 0 &&
+            (npy_intp) fwrite(buf, (size_t) elsize, (size_t) pos, fp) < pos) {
+        goto fail;
     }
+    NPY_END_THREADS;
+    NpyDataMem_FREE(buf);
+    _Npy_DECREF(it);
     return 0;
+
+ fail:
+    NPY_END_THREADS;
+    NpyErr_Format(NpyExc_IOError,
+                  "problem writing element %"NPY_INTP_FMT" to file",
+                  written);
+    NpyDataMem_FREE(buf);
+    _Npy_DECREF(it);
+    return -1;
 }
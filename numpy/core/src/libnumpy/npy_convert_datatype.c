@@ -240,11 +240,16 @@ NpyArray_CastTo(NpyArray *out, NpyArray *mp)
     NpyArray_VectorUnaryFunc *castfunc = NULL;
     npy_intp mpsize = NpyArray_SIZE(mp);
     int iswap, oswap;
+    int ret;
     NPY_BEGIN_THREADS_DEF;
+    NPY_TRACE_DEF;
     
     if (mpsize == 0) {
         return 0;
     }
+    NPY_TRACE_BEGIN("NpyArray_CastTo");
+    NPY_TRACE_ITEMS(mpsize, mpsize*mp->descr->elsize, NpyArray_NBYTES(out));
+    NPY_TRACE_PATH(NPY_TRACE_CASTING);
     if (!NpyArray_ISWRITEABLE(out)) {
         NpyErr_SetString(NpyExc_ValueError, "output array is not writeable");
         return -1;
@@ -274,6 +279,7 @@ NpyArray_CastTo(NpyArray *out, NpyArray *mp)
         if (NpyErr_Occurred()) {
             return -1;
         }
+        NPY_TRACE_END;
         return 0;
     }
     
@@ -291,7 +297,12 @@ NpyArray_CastTo(NpyArray *out, NpyArray *mp)
         oswap = NpyArray_ISBYTESWAPPED(out);
     }
     
-    return _broadcast_cast(out, mp, castfunc, iswap, oswap);
+    ret = _broadcast_cast(out, mp, castfunc, iswap, oswap);
+    if (ret == 0) {
+        NPY_TRACE_PATH(NPY_TRACE_BUFFERED);
+        NPY_TRACE_END;
+    }
+    return ret;
 }
 
 
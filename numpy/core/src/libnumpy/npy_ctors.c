@@ -147,6 +147,120 @@ return
 }
 
 
+/* Edge of the square tiles of a transposed copy, in elements */
+#define NPY_TRANSPOSE_TILE 32
+
+/*
+ * Copies an n0 x n1 block between two layouts that are fastest along
+ * different axes.  Copying in destination order would read the source
+ * with a large stride and touch a new cache line (and often a new page)
+ * for every element; copying tile by tile keeps the lines of both sides
+ * of a tile in cache while it is done.
+ */
+static void
+_tiled_transpose_copy(char *dst, npy_intp dst0, npy_intp dst1,
+                      char *src, npy_intp src0, npy_intp src1,
+                      npy_intp n0, npy_intp n1, int elsize)
+{
+    npy_intp i0, i1, j0, m0, m1;
+
+    for (i0 = 0; i0 < n0; i0 += NPY_TRANSPOSE_TILE) {
+        m0 = n0 - i0 < NPY_TRANSPOSE_TILE ? n0 - i0 : NPY_TRANSPOSE_TILE;
+        for (i1 = 0; i1 < n1; i1 += NPY_TRANSPOSE_TILE) {
+            m1 = n1 - i1 < NPY_TRANSPOSE_TILE ? n1 - i1 : NPY_TRANSPOSE_TILE;
+            for (j0 = i0; j0 < i0 + m0; j0++) {
+                _strided_byte_copy(dst + j0*dst0 + i1*dst1, dst1,
+                                   src + j0*src0 + i1*src1, src1,
+                                   m1, elsize);
+            }
+        }
+    }
+}
+
+
+/* The axis of length > 1 with the smallest absolute stride, or -1 */
+static int
+_fastest_axis(npy_intp *strides, npy_intp *dims, int nd)
+{
+    int i, axis = -1;
+    npy_intp stride, minstride = 0;
+
+    for (i = 0; i < nd; i++) {
+        stride = strides[i] < 0 ? -strides[i] : strides[i];
+        if (dims[i] > 1 && (axis < 0 || stride < minstride)) {
+            axis = i;
+            minstride = stride;
+        }
+    }
+    return axis;
+}
+
+
+/*
+ * Returns 1 if a copy between two layouts of the shape dims is
+ * transposed, that is, src and dst are fastest along different axes
+ * that are both long enough for _transposed_copy to pay off.
+ */
+int
+_is_transposed_copy(npy_intp *dstrides, npy_intp *sstrides,
+                    npy_intp *dims, int nd)
+{
+    int i, sfast, dfast;
+
+    for (i = 0; i < nd; i++) {
+        if (dims[i] == 0) {
+            return 0;
+        }
+    }
+    sfast = _fastest_axis(sstrides, dims, nd);
+    dfast = _fastest_axis(dstrides, dims, nd);
+    return (sfast >= 0 && dfast >= 0 && sfast != dfast &&
+            dims[sfast] >= NPY_TRANSPOSE_TILE &&
+            dims[dfast] >= NPY_TRANSPOSE_TILE);
+}
+
+
+/*
+ * Copies an array for which _is_transposed_copy holds, tiling the two
+ * fastest axes and looping over the others.  Both sides must be
+ * aligned and must not overlap.  Needs no Python, so it can run
+ * without the GIL.
+ */
+void
+_transposed_copy(char *dst, npy_intp *dstrides, char *src,
+                 npy_intp *sstrides, npy_intp *dims, int nd, int elsize)
+{
+    npy_intp coord[NPY_MAXDIMS];
+    int i, sfast, dfast;
+
+    sfast = _fastest_axis(sstrides, dims, nd);
+    dfast = _fastest_axis(dstrides, dims, nd);
+    memset(coord, 0, nd*sizeof(npy_intp));
+    while (1) {
+        /* Write along the destination's fastest axis within a tile */
+        _tiled_transpose_copy(dst, dstrides[sfast], dstrides[dfast],
+                              src, sstrides[sfast], sstrides[dfast],
+                              dims[sfast], dims[dfast], elsize);
+        for (i = nd - 1; i >= 0; i--) {
+            if (i == sfast || i == dfast) {
+                continue;
+            }
+            if (++coord[i] < dims[i]) {
+                dst += dstrides[i];
+                src += sstrides[i];
+                break;
+            }
+            coord[i] = 0;
+            dst -= (dims[i] - 1)*dstrides[i];
+            src -= (dims[i] - 1)*sstrides[i];
+        }
+        if (i < 0) {
+            break;
+        }
+    }
+}
+
+
 
 void 
 _strided_byte_swap(void *p, npy_intp stride, npy_intp n, int size)
@@ -211,6 +325,19 @@ _copy_from_same_shape(NpyArray *dest, NpyArray *src,
     NpyArrayIterObject *dit, *sit;
     NPY_BEGIN_THREADS_DEF;
     
+    if (!swap && myfunc == _strided_byte_copy &&
+        _is_transposed_copy(dest->strides, src->strides,
+                            dest->dimensions, dest->nd)) {
+        /* Refcount note: src and dst have the same size */
+        NpyArray_INCREF(src);
+        NpyArray_XDECREF(dest);
+        NPY_BEGIN_THREADS;
+        _transposed_copy(dest->data, dest->strides, src->data, src->strides,
+                         dest->dimensions, dest->nd, NpyArray_ITEMSIZE(dest));
+        NPY_END_THREADS;
+        return 0;
+    }
+
     dit = NpyArray_IterAllButAxis(dest, &maxaxis);
     sit = NpyArray_IterAllButAxis(src, &maxaxis);
     
@@ -457,6 +584,32 @@ _flat_copyinto(NpyArray *dst, NpyArray *src, NPY_ORDER order)
         NPY_END_THREADS;
         return 0;
     }
+
+    if (NpyArray_SAFEALIGNEDCOPY(src) && NpyArray_ISALIGNED(dst)) {
+        /* Strides of dst seen as an array of the shape of src */
+        npy_intp dstrides[NPY_MAXDIMS];
+        npy_intp stride = NpyArray_ITEMSIZE(dst);
+        int i, k;
+
+        for (i = 0; i < NpyArray_NDIM(src); i++) {
+            k = (order == NpyArray_FORTRANORDER) ? i : NpyArray_NDIM(src)-1-i;
+            dstrides[k] = stride;
+            stride *= NpyArray_DIM(src, k);
+        }
+        if (_is_transposed_copy(dstrides, NpyArray_STRIDES(src),
+                                NpyArray_DIMS(src), NpyArray_NDIM(src))) {
+            /* Refcount note: src and dst have the same size */
+            NpyArray_INCREF(src);
+            NpyArray_XDECREF(dst);
+            NPY_BEGIN_THREADS;
+            _transposed_copy(NpyArray_BYTES(dst), dstrides,
+                             NpyArray_BYTES(src), NpyArray_STRIDES(src),
+                             NpyArray_DIMS(src), NpyArray_NDIM(src),
+                             NpyArray_ITEMSIZE(dst));
+            NPY_END_THREADS;
+            return 0;
+        }
+    }
     
     axis = NpyArray_NDIM(src)-1;
     
@@ -822,6 +975,7 @@ NpyArray_NewFromDescr(NpyTypeObject *subtype,
     size_t sd;
     npy_intp largest;
     npy_intp size;
+    NPY_TRACE_DEF;
     
     if (descr->subarray) {
         NpyArray *ret;
@@ -901,6 +1055,8 @@ NpyArray_NewFromDescr(NpyTypeObject *subtype,
         largest /= dim;
     }
     
+    NPY_TRACE_BEGIN("NpyArray_NewFromDescr");
+    NPY_TRACE_ITEMS(size, 0, 0);
     self = (NpyArray *) subtype->tp_alloc(subtype, 0);
     if (self == NULL) {
         Npy_DECREF(descr);
@@ -976,6 +1132,7 @@ NpyArray_NewFromDescr(NpyTypeObject *subtype,
          */
         if (NpyDataType_FLAGCHK(descr, NPY_NEEDS_INIT)) {
             memset(data, 0, sd);
+            NPY_TRACE_ITEMS(size, 0, sd);
         }
     }
     else {
@@ -986,6 +1143,7 @@ NpyArray_NewFromDescr(NpyTypeObject *subtype,
         self->flags &= ~NPY_OWNDATA;
     }
     self->data = data;
+    NPY_TRACE_END;
     
     /*
      * call the __array_finalize__
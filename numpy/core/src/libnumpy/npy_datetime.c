@@ -43,13 +43,13 @@ typedef struct {
 #define Py_AssertWithArg(x,errortype,errorstr,a1) {if (!(x)) {PyErr_Format(errortype,errorstr,a1);goto onError;}}
 
 /* Table with day offsets for each month (0-based, without and with leap) */
-static int month_offset[2][13] = {
+static const int month_offset[2][13] = {
     { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334, 365 },
     { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335, 366 }
 };
 
 /* Table of number of days in a month (0-based, without and with leap) */
-static int days_in_month[2][12] = {
+static const int days_in_month[2][12] = {
     { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 },
     { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 }
 };
@@ -174,7 +174,7 @@ days_to_ymdstruct(npy_datetime dlong)
     npy_longlong yearoffset;
     int leap, dayoffset;
     int month = 1, day = 1;
-    int *monthoffset;
+    const int *monthoffset;
     
     dlong += 1;
     
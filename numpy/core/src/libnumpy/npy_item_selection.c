@@ -16,7 +16,9 @@ NpyArray_TakeFrom(NpyArray *self0, NpyArray *indices0, int axis,
     char *src, *dest;
     int copyret = 0;
     int err;
+    NPY_TRACE_DEF;
 
+    NPY_TRACE_BEGIN("NpyArray_TakeFrom");
     indices = NULL;
     self = NpyArray_CheckAxis(self0, &axis, NPY_CARRAY);
     if (self == NULL) {
@@ -162,6 +164,13 @@ NpyArray_TakeFrom(NpyArray *self0, NpyArray *indices0, int axis,
         }
     }
 
+    NPY_TRACE_ITEMS(n*m*nelem, n*m*chunk, n*m*chunk);
+    if (copyret || self != self0) {
+        NPY_TRACE_PATH(NPY_TRACE_BUFFERED);
+    }
+    if (indices0->descr->type_num != NPY_INTP) {
+        NPY_TRACE_PATH(NPY_TRACE_CASTING);
+    }
     NpyArray_INCREF(ret);
     Npy_XDECREF(indices);
     Npy_XDECREF(self);
@@ -172,6 +181,7 @@ NpyArray_TakeFrom(NpyArray *self0, NpyArray *indices0, int axis,
         Npy_DECREF(ret);
         ret = obj;
     }
+    NPY_TRACE_END;
     return ret;
 
  fail:
@@ -842,9 +852,12 @@ _new_argsort(NpyArray *op, int axis, NPY_SORTKIND which)
 }
 
 
-/* Be sure to save this global_compare when necessary */
-/* XXX: This may be an issue in an MT case. */
-static NpyArray* global_obj;
+/*
+ * The array being sorted, for the qsort comparisons.  Thread-local, and
+ * saved and restored around each sort so that a compare function may
+ * itself sort.
+ */
+static NPY_TLS NpyArray* global_obj;
 
 static int
 qsortCompare (const void *a, const void *b)
@@ -909,6 +922,7 @@ NpyArray_Sort(NpyArray *op, int axis, NPY_SORTKIND which)
     NpyArray *ap = NULL, *store_arr = NULL;
     char *ip;
     int i, n, m, elsize, orign;
+    NPY_TRACE_DEF;
 
     n = op->nd;
     if ((n == 0) || (NpyArray_SIZE(op) == 1)) {
@@ -927,9 +941,23 @@ NpyArray_Sort(NpyArray *op, int axis, NPY_SORTKIND which)
         return -1;
     }
 
+    NPY_TRACE_BEGIN("NpyArray_Sort");
+    NPY_TRACE_ITEMS(NpyArray_SIZE(op), NpyArray_NBYTES(op),
+                    NpyArray_NBYTES(op));
+    if (op->strides[axis] != op->descr->elsize) {
+        NPY_TRACE_PATH(NPY_TRACE_STRIDED | NPY_TRACE_BUFFERED);
+    }
+    else if (!NpyArray_ISALIGNED(op) || !NpyArray_ISNOTSWAPPED(op)) {
+        NPY_TRACE_PATH(NPY_TRACE_BUFFERED);
+    }
+
     /* Determine if we should use type-specific algorithm or not */
     if (op->descr->f->sort[which] != NULL) {
-        return _new_sort(op, axis, which);
+        if (_new_sort(op, axis, which) < 0) {
+            return -1;
+        }
+        NPY_TRACE_END;
+        return 0;
     }
     if ((which != NPY_QUICKSORT)
         || op->descr->f->compare == NULL) {
@@ -966,6 +994,7 @@ NpyArray_Sort(NpyArray *op, int axis, NPY_SORTKIND which)
  finish:
     Npy_DECREF(ap);  /* Should update op if needed */
     SWAPBACK2(op);
+    NPY_TRACE_END;
     return 0;
 
  fail:
@@ -975,8 +1004,8 @@ NpyArray_Sort(NpyArray *op, int axis, NPY_SORTKIND which)
 }
 
 
-/* XXX: This could be a problem for MT. */
-static char *global_data;
+/* The data of the row being argsorted; see global_obj */
+static NPY_TLS char *global_data;
 
 static int
 argsort_static_compare(const void *ip1, const void *ip2)
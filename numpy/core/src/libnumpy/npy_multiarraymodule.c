@@ -199,7 +199,7 @@ NpyArray_Free(NpyArray *ap, void *ptr)
 static int 
 _signbit_set(NpyArray *arr)
 {
-    static char bitmask = (char) 0x80;
+    const char bitmask = (char) 0x80;
     char *ptr;  /* points to the byte to test */
     char byteorder;
     int elsize;
@@ -700,7 +700,7 @@ _fix_unknown_dimension(NpyArray_Dims *newshape, npy_intp s_original)
     npy_intp *dimensions;
     npy_intp i_unknown, s_known;
     int i, n;
-    static char msg[] = "total size of new array must be unchanged";
+    static const char msg[] = "total size of new array must be unchanged";
 
     dimensions = newshape->ptr;
     n = newshape->len;
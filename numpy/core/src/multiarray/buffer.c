@@ -116,6 +116,10 @@ _append_char(_tmp_string_t *s, char c)
     char *p;
     if (s->s == NULL) {
         s->s = (char*)malloc(16);
+        if (s->s == NULL) {
+            PyErr_SetString(PyExc_MemoryError, "memory allocation failed");
+            return -1;
+        }
         s->pos = 0;
         s->allocated = 16;
     }
@@ -305,6 +309,7 @@ _buffer_format_string(PyArray_Descr *descr, _tmp_string_t *str,
                              "cannot expose native-only dtype '%c' in "
                              "non-native byte order '%c' via buffer interface",
                              descr->type, descr->byteorder);
+                return -1;
             }
         }
 
@@ -376,6 +381,55 @@ _buffer_format_string(PyArray_Descr *descr, _tmp_string_t *str,
 }
 
 
+/*
+ * The format string of a simple type depends only on its type number, its
+ * byte order and on whether the array is natively aligned for it, so it
+ * is built once and kept for the life of the module.  Strings, unicode,
+ * void and structured types carry sizes or names and are built each time.
+ */
+static char *_buffer_format_cache[NPY_NTYPES][4][2];
+
+/*
+ * Find the memoized format string of the array's data type.  Sets *format
+ * to NULL if the type cannot be memoized.  Returns -1 on error.
+ */
+static int
+_buffer_format_cached(PyArrayObject *arr, const char **format)
+{
+    PyArray_Descr *descr = PyArray_DESCR(arr);
+    _tmp_string_t fmt = {0,0,0};
+    int order, aligned;
+    char **slot;
+
+    *format = NULL;
+    if (descr->subarray != NULL || PyDataType_HASFIELDS(descr) ||
+            descr->type_num < 0 || descr->type_num >= NPY_NTYPES ||
+            descr->type_num == NPY_STRING || descr->type_num == NPY_UNICODE ||
+            descr->type_num == NPY_VOID) {
+        return 0;
+    }
+    switch (descr->byteorder) {
+    case '=': order = 0; break;
+    case '<': order = 1; break;
+    case '>': order = 2; break;
+    default:  order = 3; break;
+    }
+    aligned = (descr->byteorder == '=' &&
+               _is_natively_aligned_at(descr, arr, 0));
+    slot = &_buffer_format_cache[descr->type_num][order][aligned];
+    if (*slot == NULL) {
+        if (_buffer_format_string(descr, &fmt, arr, NULL, NULL) != 0 ||
+                _append_char(&fmt, '\0') != 0) {
+            free(fmt.s);
+            return -1;
+        }
+        *slot = fmt.s;
+    }
+    *format = *slot;
+    return 0;
+}
+
+
 /*
  * Global information about all active buffers
  *
@@ -389,37 +443,78 @@ typedef struct {
     int ndim;
     Py_ssize_t *strides;
     Py_ssize_t *shape;
+    long hash;
 } _buffer_info_t;
 
 /*
- * { id(array): [list of pointers to _buffer_info_t, the last one is latest] }
+ * { id(array): [list of pointers to _buffer_info_t] }
  *
  * Because shape, strides, and format can be different for different buffers,
  * we may need to keep track of multiple buffer infos for each array.
  *
- * However, when none of them has changed, the same buffer info may be reused.
+ * Any earlier info that matches the array's current layout is reused; the
+ * hash of the layout is compared first, so that a lookup does not need to
+ * allocate anything.  The list of the array exported last is remembered,
+ * to skip the dictionary for repeated exports of the same array.
  *
  * Thread-safety is provided by GIL.
  */
 static PyObject *_buffer_info_cache = NULL;
+static PyObject *_buffer_info_last_arr = NULL;
+static PyObject *_buffer_info_last_list = NULL;
+
+/* Hash of the format string, shape and strides of an array */
+static long
+_buffer_info_hash(const char *format, PyArrayObject *arr)
+{
+    unsigned long h = 5381;
+    int k;
+
+    while (*format != '\0') {
+        h = h*33 + (unsigned char)*format++;
+    }
+    h = h*33 + PyArray_NDIM(arr);
+    for (k = 0; k < PyArray_NDIM(arr); ++k) {
+        h = h*1000003 ^ (unsigned long)PyArray_DIMS(arr)[k];
+        h = h*1000003 ^ (unsigned long)PyArray_STRIDES(arr)[k];
+    }
+    return (long)h;
+}
+
+/* Return non-zero if the info describes the array's current layout */
+static int
+_buffer_info_matches(_buffer_info_t *info, long hash, const char *format,
+                     PyArrayObject *arr)
+{
+    int k;
 
-/* Fill in the info structure */
+    if (info->hash != hash || info->ndim != PyArray_NDIM(arr)) {
+        return 0;
+    }
+    for (k = 0; k < info->ndim; ++k) {
+        if (info->shape[k] != PyArray_DIMS(arr)[k] ||
+                info->strides[k] != PyArray_STRIDES(arr)[k]) {
+            return 0;
+        }
+    }
+    return strcmp(info->format, format) == 0;
+}
+
+/* Fill in the info structure, taking ownership of format */
 static _buffer_info_t*
-_buffer_info_new(PyArrayObject *arr)
+_buffer_info_new(PyArrayObject *arr, char *format, long hash)
 {
     _buffer_info_t *info;
-    _tmp_string_t fmt = {0,0,0};
     int k;
 
     info = (_buffer_info_t*)malloc(sizeof(_buffer_info_t));
-
-    /* Fill in format */
-    if (_buffer_format_string(PyArray_DESCR(arr), &fmt, arr, NULL, NULL) != 0) {
-        free(info);
+    if (info == NULL) {
+        free(format);
+        PyErr_NoMemory();
         return NULL;
     }
-    _append_char(&fmt, '\0');
-    info->format = fmt.s;
+    info->format = format;
+    info->hash = hash;
 
     /* Fill in shape and strides */
     info->ndim = PyArray_NDIM(arr);
@@ -431,6 +526,12 @@ _buffer_info_new(PyArrayObject *arr)
     else {
         info->shape = (Py_ssize_t*)malloc(sizeof(Py_ssize_t)
                                           * PyArray_NDIM(arr) * 2 + 1);
+        if (info->shape == NULL) {
+            free(format);
+            free(info);
+            PyErr_NoMemory();
+            return NULL;
+        }
         info->strides = info->shape + PyArray_NDIM(arr);
         for (k = 0; k < PyArray_NDIM(arr); ++k) {
             info->shape[k] = PyArray_DIMS(arr)[k];
@@ -441,29 +542,6 @@ _buffer_info_new(PyArrayObject *arr)
     return info;
 }
 
-/* Compare two info structures */
-static Py_ssize_t
-_buffer_info_cmp(_buffer_info_t *a, _buffer_info_t *b)
-{
-    Py_ssize_t c;
-    int k;
-
-    c = strcmp(a->format, b->format);
-    if (c != 0) return c;
-
-    c = a->ndim - b->ndim;
-    if (c != 0) return c;
-
-    for (k = 0; k < a->ndim; ++k) {
-        c = a->shape[k] - b->shape[k];
-        if (c != 0) return c;
-        c = a->strides[k] - b->strides[k];
-        if (c != 0) return c;
-    }
-
-    return 0;
-}
-
 static void
 _buffer_info_free(_buffer_info_t *info)
 {
@@ -481,7 +559,12 @@ static _buffer_info_t*
 _buffer_get_info(PyObject *arr)
 {
     PyObject *key, *item_list, *item;
-    _buffer_info_t *info = NULL, *old_info = NULL;
+    _buffer_info_t *info;
+    _tmp_string_t fmt = {0,0,0};
+    const char *format;
+    char *owned;
+    long hash;
+    Py_ssize_t k;
 
     if (_buffer_info_cache == NULL) {
         _buffer_info_cache = PyDict_New();
@@ -490,42 +573,82 @@ _buffer_get_info(PyObject *arr)
         }
     }
 
-    /* Compute information */
-    info = _buffer_info_new((PyArrayObject*)arr);
-    if (info == NULL) {
+    /* Compute the format string, memoized for simple types */
+    if (_buffer_format_cached((PyArrayObject*)arr, &format) != 0) {
         return NULL;
     }
+    if (format == NULL) {
+        if (_buffer_format_string(PyArray_DESCR(arr), &fmt,
+                                  (PyArrayObject*)arr, NULL, NULL) != 0 ||
+                _append_char(&fmt, '\0') != 0) {
+            free(fmt.s);
+            return NULL;
+        }
+        format = fmt.s;
+    }
+    hash = _buffer_info_hash(format, (PyArrayObject*)arr);
 
-    /* Check if it is identical with an old one; reuse old one, if yes */
-    key = PyLong_FromVoidPtr((void*)arr);
-    item_list = PyDict_GetItem(_buffer_info_cache, key);
-
-    if (item_list != NULL) {
-        Py_INCREF(item_list);
-        if (PyList_GET_SIZE(item_list) > 0) {
-            item = PyList_GetItem(item_list, PyList_GET_SIZE(item_list) - 1);
-            old_info = (_buffer_info_t*)PyLong_AsVoidPtr(item);
-
-            if (_buffer_info_cmp(info, old_info) == 0) {
-                _buffer_info_free(info);
-                info = old_info;
+    /* Find the infos of this array */
+    if (arr == _buffer_info_last_arr) {
+        item_list = _buffer_info_last_list;
+    }
+    else {
+        key = PyLong_FromVoidPtr((void*)arr);
+        if (key == NULL) {
+            free(fmt.s);
+            return NULL;
+        }
+        item_list = PyDict_GetItem(_buffer_info_cache, key);
+        if (item_list == NULL) {
+            item_list = PyList_New(0);
+            if (item_list == NULL ||
+                    PyDict_SetItem(_buffer_info_cache, key, item_list) != 0) {
+                Py_XDECREF(item_list);
+                Py_DECREF(key);
+                free(fmt.s);
+                return NULL;
             }
+            /* the dictionary holds the list from now on */
+            Py_DECREF(item_list);
+        }
+        Py_DECREF(key);
+        _buffer_info_last_arr = arr;
+        _buffer_info_last_list = item_list;
+    }
+
+    /* Reuse an identical old one, if any */
+    for (k = PyList_GET_SIZE(item_list) - 1; k >= 0; --k) {
+        item = PyList_GET_ITEM(item_list, k);
+        info = (_buffer_info_t*)PyLong_AsVoidPtr(item);
+        if (_buffer_info_matches(info, hash, format, (PyArrayObject*)arr)) {
+            free(fmt.s);
+            return info;
         }
     }
+
+    /* Needs insertion */
+    if (fmt.s != NULL) {
+        owned = fmt.s;
+    }
     else {
-        item_list = PyList_New(0);
-        PyDict_SetItem(_buffer_info_cache, key, item_list);
+        owned = (char*)malloc(strlen(format) + 1);
+        if (owned == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        strcpy(owned, format);
     }
-
-    if (info != old_info) {
-        /* Needs insertion */
-        item = PyLong_FromVoidPtr((void*)info);
-        PyList_Append(item_list, item);
-        Py_DECREF(item);
+    info = _buffer_info_new((PyArrayObject*)arr, owned, hash);
+    if (info == NULL) {
+        return NULL;
     }
-
-    Py_DECREF(item_list);
-    Py_DECREF(key);
+    item = PyLong_FromVoidPtr((void*)info);
+    if (item == NULL || PyList_Append(item_list, item) != 0) {
+        Py_XDECREF(item);
+        _buffer_info_free(info);
+        return NULL;
+    }
+    Py_DECREF(item);
     return info;
 }
 
@@ -541,6 +664,11 @@ _buffer_clear_info(PyObject *arr)
         return;
     }
 
+    if (arr == _buffer_info_last_arr) {
+        _buffer_info_last_arr = NULL;
+        _buffer_info_last_list = NULL;
+    }
+
     key = PyLong_FromVoidPtr((void*)arr);
     item_list = PyDict_GetItem(_buffer_info_cache, key);
     if (item_list != NULL) {
@@ -697,6 +825,101 @@ NPY_NO_EXPORT PyBufferProcs array_as_buffer = {
  */
 #if PY_VERSION_HEX >= 0x02060000
 
+/*
+ * Parse the formats of a single item, such as 'd', '<i', '=H', 'Zd' or
+ * '10s', without going through Python.  These are what nearly all buffers
+ * export.  Follows numpy.core._internal._dtype_from_pep3118, and returns
+ * NULL without an error set for anything else, which is left to it.
+ */
+static PyArray_Descr*
+_descriptor_from_pep3118_simple(const char *s)
+{
+    PyArray_Descr *descr, *swapped;
+    char byteorder = '@';
+    int native, type_num = -1;
+    long count = -1;
+
+    if (*s == '@' || *s == '=' || *s == '<' || *s == '>' || *s == '^' ||
+            *s == '!') {
+        byteorder = (*s == '!') ? '>' : *s;
+        ++s;
+    }
+    native = (byteorder == '@' || byteorder == '^');
+
+    while (*s >= '0' && *s <= '9') {
+        if (count < 0) {
+            count = 0;
+        }
+        count = 10*count + (*s - '0');
+        if (count > NPY_MAX_INT/4) {
+            return NULL;
+        }
+        ++s;
+    }
+
+    if (s[0] == 'Z' && s[1] != '\0' && s[2] == '\0') {
+        switch (s[1]) {
+        case 'f': type_num = NPY_CFLOAT; break;
+        case 'd': type_num = NPY_CDOUBLE; break;
+        case 'g': if (native) type_num = NPY_CLONGDOUBLE; break;
+        }
+    }
+    else if (s[0] != '\0' && s[1] == '\0') {
+        switch (s[0]) {
+        case '?': type_num = NPY_BOOL; break;
+        case 'b': type_num = NPY_BYTE; break;
+        case 'B': type_num = NPY_UBYTE; break;
+        case 'h': type_num = native ? NPY_SHORT : NPY_INT16; break;
+        case 'H': type_num = native ? NPY_USHORT : NPY_UINT16; break;
+        case 'i': type_num = native ? NPY_INT : NPY_INT32; break;
+        case 'I': type_num = native ? NPY_UINT : NPY_UINT32; break;
+        case 'l': type_num = native ? NPY_LONG : NPY_INT32; break;
+        case 'L': type_num = native ? NPY_ULONG : NPY_UINT32; break;
+        case 'q': type_num = native ? NPY_LONGLONG : NPY_INT64; break;
+        case 'Q': type_num = native ? NPY_ULONGLONG : NPY_UINT64; break;
+        case 'f': type_num = NPY_FLOAT; break;
+        case 'd': type_num = NPY_DOUBLE; break;
+        case 'g': if (native) type_num = NPY_LONGDOUBLE; break;
+        case 'O': type_num = NPY_OBJECT; break;
+        case 's': type_num = NPY_STRING; break;
+        case 'w': type_num = NPY_UNICODE; break;
+        }
+    }
+    if (type_num < 0) {
+        return NULL;
+    }
+
+    if (type_num == NPY_STRING || type_num == NPY_UNICODE) {
+        if (count == 0) {
+            return NULL;
+        }
+        descr = PyArray_DescrNewFromType(type_num);
+        if (descr == NULL) {
+            return NULL;
+        }
+        descr->elsize = (count < 0 ? 1 : count) *
+                        (type_num == NPY_UNICODE ? 4 : 1);
+    }
+    else {
+        /* Repeat counts make sub-arrays */
+        if (count >= 0 && count != 1) {
+            return NULL;
+        }
+        descr = PyArray_DescrFromType(type_num);
+        if (descr == NULL) {
+            return NULL;
+        }
+    }
+
+    if ((byteorder == '<' || byteorder == '>') &&
+            !PyArray_ISNBO(byteorder) && descr->byteorder != '|') {
+        swapped = PyArray_DescrNewByteorder(descr, byteorder);
+        Py_DECREF(descr);
+        descr = swapped;
+    }
+    return descr;
+}
+
 NPY_NO_EXPORT PyArray_Descr*
 _descriptor_from_pep3118_format(char *s)
 {
@@ -712,41 +935,61 @@ _descriptor_from_pep3118_format(char *s)
 
     /* Strip whitespace, except from field names */
     buf = (char*)malloc(strlen(s) + 1);
+    if (buf == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
     p = buf;
     while (*s != '\0') {
         if (*s == ':') {
             in_name = !in_name;
-            *p = *s;
+            *p++ = *s;
         }
         else if (in_name || !NumPyOS_ascii_isspace(*s)) {
-            *p = *s;
+            *p++ = *s;
         }
-        ++p;
         ++s;
     }
     *p = '\0';
 
+    /* Common single-item formats */
+    descr = (PyObject*)_descriptor_from_pep3118_simple(buf);
+    if (descr != NULL || PyErr_Occurred()) {
+        free(buf);
+        return (PyArray_Descr*)descr;
+    }
+
     /* Convert */
     _numpy_internal = PyImport_ImportModule("numpy.core._internal");
     if (_numpy_internal == NULL) {
+        free(buf);
         return NULL;
     }
     str = PyUString_FromStringAndSize(buf, strlen(buf));
-    free(buf);
+    if (str == NULL) {
+        Py_DECREF(_numpy_internal);
+        free(buf);
+        return NULL;
+    }
     descr = PyObject_CallMethod(
         _numpy_internal, "_dtype_from_pep3118", "O", str);
     Py_DECREF(str);
+    Py_DECREF(_numpy_internal);
     if (descr == NULL) {
         PyErr_Format(PyExc_ValueError,
                      "'%s' is not a valid PEP 3118 buffer format string", buf);
+        free(buf);
         return NULL;
     }
     if (!PyArray_DescrCheck(descr)) {
         PyErr_Format(PyExc_RuntimeError,
                      "internal error: numpy.core._internal._dtype_from_pep3118 "
                      "did not return a valid dtype, got %s", buf);
+        Py_DECREF(descr);
+        free(buf);
         return NULL;
     }
+    free(buf);
     return (PyArray_Descr*)descr;
 }
 
@@ -16,6 +16,7 @@
 #include "mapping.h"
 
 #include "convert.h"
+#include "textwriting.h"
 
 /*NUMPY_API
  * To List
@@ -155,15 +156,18 @@ NPY_NO_EXPORT int
 PyArray_ToFile(PyArrayObject *self, FILE *fp, char *sep, char *format)
 {
     size_t n3;
+    int ret;
 
     n3 = (sep ? strlen((const char *)sep) : 0);
     if (n3 == 0) {
-        NpyArray_ToBinaryFile(self, fp);
+        return NpyArray_ToBinaryFile(self, fp);
     }
-    else {
-        PyArray_ToTextFile(self, fp, sep, format);
+    ret = write_text_file(self, fp, sep, format ? format : "");
+    if (ret == 0) {
+        /* types and formats the text writer leaves to Python */
+        ret = PyArray_ToTextFile(self, fp, sep, format);
     }
-    return 0;
+    return ret < 0 ? -1 : 0;
 }
 
 /*NUMPY_API*/
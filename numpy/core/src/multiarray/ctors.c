@@ -2,6 +2,8 @@
 #include <Python.h>
 #include "structmember.h"
 
+#include <float.h>
+
 #define _MULTIARRAYMODULE
 #define NPY_NO_PREFIX
 #include "numpy/arrayobject.h"
@@ -18,6 +20,8 @@
 
 #include "ctors.h"
 
+#include "numpyos.h"
+
 #include "buffer.h"
 
 #include "numpymemoryview.h"
@@ -52,6 +56,375 @@ fromfile_next_element(FILE **fp, void *dptr, PyArray_Descr *dtype,
     return dtype->f->scanfunc(*fp, dptr, NULL, dtype);
 }
 
+/*
+ * Reading text from a seekable file a block at a time.
+ *
+ * fscanf and getc lock the stream and go through stdio for every
+ * character, which makes fromfile with a separator very slow on large
+ * files.  Instead, the file is read with fread into a large buffer and
+ * the separator and element matching below run on that, following the
+ * same rules as fromfile_skip_separator, fscanf and NumPyOS_ascii_ftolf
+ * so that the results do not change.  Whatever was read but not used is
+ * given back to the file with fseek once reading is done.
+ */
+#define TEXT_BLOCK_SIZE (1 << 18)
+/* Longest float accepted, FLOAT_FORMATBUFLEN in numpyos.c */
+#define TEXT_BLOCK_FLOATLEN 120
+
+typedef struct {
+    FILE *fp;
+    char *buf;
+    char *pos;
+    char *end;
+    int eof;
+} text_block;
+
+static int
+text_block_fill(text_block *tb)
+{
+    size_t n;
+
+    if (tb->eof) {
+        return EOF;
+    }
+    n = fread(tb->buf, 1, TEXT_BLOCK_SIZE, tb->fp);
+    if (n == 0) {
+        tb->eof = 1;
+        return EOF;
+    }
+    tb->pos = tb->buf;
+    tb->end = tb->buf + n;
+    return (unsigned char)*tb->pos++;
+}
+
+#define TB_GETC(tb) ((tb)->pos < (tb)->end ? \
+                     (unsigned char)*(tb)->pos++ : text_block_fill(tb))
+/* Only ever used right after the TB_GETC that returned c */
+#define TB_UNGETC(c, tb) do { if ((c) != EOF) (tb)->pos--; } while (0)
+
+/* As fscanf with "%lld" or "%llu": returns 1, 0 if no digits, or EOF */
+static int
+text_block_scan_integer(text_block *tb, npy_longlong *value, int is_unsigned)
+{
+    npy_ulonglong result = 0, limit;
+    int c, neg = 0, overflow = 0;
+
+    c = TB_GETC(tb);
+    while (c != EOF && isspace(c)) {
+        c = TB_GETC(tb);
+    }
+    if (c == EOF) {
+        return EOF;
+    }
+    if (c == '+' || c == '-') {
+        neg = (c == '-');
+        c = TB_GETC(tb);
+    }
+    if (c == EOF || !isdigit(c)) {
+        TB_UNGETC(c, tb);
+        return 0;
+    }
+    if (is_unsigned) {
+        limit = NPY_MAX_ULONGLONG;
+    }
+    else {
+        limit = neg ? (npy_ulonglong)NPY_MAX_LONGLONG + 1 : NPY_MAX_LONGLONG;
+    }
+    do {
+        if (result > (limit - (c - '0')) / 10) {
+            overflow = 1;
+        }
+        else {
+            result = result*10 + (c - '0');
+        }
+        c = TB_GETC(tb);
+    } while (c != EOF && isdigit(c));
+    TB_UNGETC(c, tb);
+
+    /* saturate like strtoll and strtoull */
+    if (overflow) {
+        result = limit;
+    }
+    else if (neg) {
+        result = -result;
+    }
+    *value = (npy_longlong)result;
+    return 1;
+}
+
+/*
+ * Converts the common short case exactly without strtod: at most 15
+ * significant digits and a decimal exponent within 22 of zero, where the
+ * digits and the power of ten are both exact doubles and a single
+ * multiplication or division rounds correctly.  Returns 0 if s needs the
+ * full conversion.
+ */
+static int
+text_block_fast_double(const char *s, double *value)
+{
+    static const double pow10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    npy_uint64 m = 0;
+    int neg = 0, ndigits = 0, seen = 0, point = 0, exp10 = 0, e = 0;
+    double v;
+
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0
+    /* extended precision intermediates would round twice */
+    return 0;
+#endif
+    if (*s == '+' || *s == '-') {
+        neg = (*s++ == '-');
+    }
+    for (;; s++) {
+        if (*s == '.' && !point) {
+            point = 1;
+            continue;
+        }
+        if (*s < '0' || *s > '9') {
+            break;
+        }
+        seen = 1;
+        if (m == 0 && *s == '0') {
+            exp10 -= point;
+            continue;
+        }
+        if (++ndigits > 15) {
+            return 0;
+        }
+        m = m*10 + (*s - '0');
+        exp10 -= point;
+    }
+    if (!seen) {
+        return 0;
+    }
+    if (*s == 'e' || *s == 'E') {
+        int eneg = 0;
+
+        s++;
+        if (*s == '+' || *s == '-') {
+            eneg = (*s++ == '-');
+        }
+        if (*s < '0' || *s > '9') {
+            return 0;
+        }
+        for (; *s >= '0' && *s <= '9'; s++) {
+            if (e < 1000) {
+                e = e*10 + (*s - '0');
+            }
+        }
+        exp10 += eneg ? -e : e;
+    }
+    if (*s != '\0') {
+        return 0;
+    }
+    if (m == 0) {
+        v = 0.0;
+    }
+    else if (exp10 < -22 || exp10 > 22) {
+        return 0;
+    }
+    else if (exp10 < 0) {
+        v = (double)m / pow10[-exp10];
+    }
+    else {
+        v = (double)m * pow10[exp10];
+    }
+    *value = neg ? -v : v;
+    return 1;
+}
+
+/*
+ * As NumPyOS_ascii_ftolf: collects the longest prefix that looks like a
+ * float, up to TEXT_BLOCK_FLOATLEN characters, and converts that.
+ */
+static int
+text_block_scan_double(text_block *tb, double *value)
+{
+    char buffer[TEXT_BLOCK_FLOATLEN + 1];
+    char *endp = buffer, *q;
+    const char *p;
+    int c, ok;
+
+#define NEXT_CHAR()                                                         \
+        do {                                                                \
+            if (c == EOF || endp >= buffer + TEXT_BLOCK_FLOATLEN)           \
+                goto buffer_filled;                                         \
+            *endp++ = (char)c;                                              \
+            c = TB_GETC(tb);                                                \
+        } while (0)
+
+#define MATCH_ALPHA_STRING_NOCASE(string)                                   \
+        do {                                                                \
+            for (p=(string); *p!='\0' && (c==*p || c+('a'-'A')==*p); ++p)   \
+                NEXT_CHAR();                                                \
+            if (*p != '\0') goto buffer_filled;                             \
+        } while (0)
+
+#define MATCH_DIGITS()                                                      \
+        while (c >= '0' && c <= '9') { NEXT_CHAR(); ok = 1; }
+
+    c = TB_GETC(tb);
+    if (c == EOF) {
+        return EOF;
+    }
+    while (c != EOF && NumPyOS_ascii_isspace(c)) {
+        c = TB_GETC(tb);
+    }
+    if (c == '+' || c == '-') {
+        NEXT_CHAR();
+    }
+    if (c == 'n' || c == 'N') {
+        NEXT_CHAR();
+        MATCH_ALPHA_STRING_NOCASE("an");
+        if (c == '(') {
+            NEXT_CHAR();
+            while ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+                   (c >= 'A' && c <= 'Z') || c == '_') {
+                NEXT_CHAR();
+            }
+            if (c == ')') {
+                NEXT_CHAR();
+            }
+        }
+        goto buffer_filled;
+    }
+    else if (c == 'i' || c == 'I') {
+        NEXT_CHAR();
+        MATCH_ALPHA_STRING_NOCASE("nfinity");
+        goto buffer_filled;
+    }
+    ok = 0;
+    MATCH_DIGITS();
+    if (c == '.') {
+        NEXT_CHAR();
+        ok = 0;
+        MATCH_DIGITS();
+        if (!ok) {
+            goto buffer_filled;
+        }
+    }
+    if (c == 'e' || c == 'E') {
+        NEXT_CHAR();
+        if (c == '+' || c == '-') {
+            NEXT_CHAR();
+        }
+        MATCH_DIGITS();
+    }
+
+buffer_filled:
+    TB_UNGETC(c, tb);
+    *endp = '\0';
+    if (text_block_fast_double(buffer, value)) {
+        return 1;
+    }
+    *value = NumPyOS_ascii_strtod(buffer, &q);
+    return (buffer == q) ? 0 : 1;
+
+#undef NEXT_CHAR
+#undef MATCH_ALPHA_STRING_NOCASE
+#undef MATCH_DIGITS
+}
+
+/* Whether text_block_next_element can read the type */
+static int
+text_block_supports(PyArray_Descr *dtype)
+{
+    return PyTypeNum_ISBOOL(dtype->type_num) ||
+           PyTypeNum_ISINTEGER(dtype->type_num) ||
+           PyTypeNum_ISFLOAT(dtype->type_num);
+}
+
+static int
+text_block_next_element(text_block **ptb, void *dptr, PyArray_Descr *dtype,
+                        void *NPY_UNUSED(stream_data))
+{
+    npy_longlong v = 0;
+    double d = 0;
+    int ret;
+
+    if (PyTypeNum_ISFLOAT(dtype->type_num)) {
+        ret = text_block_scan_double(*ptb, &d);
+        switch (dtype->type_num) {
+            case NPY_FLOAT:
+                *(npy_float *)dptr = (npy_float)d;
+                break;
+            case NPY_DOUBLE:
+                *(npy_double *)dptr = d;
+                break;
+            default:
+                *(npy_longdouble *)dptr = (npy_longdouble)d;
+        }
+        return ret;
+    }
+    ret = text_block_scan_integer(*ptb, &v,
+                                  PyTypeNum_ISUNSIGNED(dtype->type_num));
+    if (dtype->type_num == NPY_BOOL) {
+        /* BOOL_scan reads an int */
+        *(npy_bool *)dptr = ((int)v != 0);
+        return ret;
+    }
+    switch (dtype->type_num) {
+#define CASE(num, type) case num: *(type *)dptr = (type)v; break
+        CASE(NPY_BYTE, npy_byte);
+        CASE(NPY_UBYTE, npy_ubyte);
+        CASE(NPY_SHORT, npy_short);
+        CASE(NPY_USHORT, npy_ushort);
+        CASE(NPY_INT, npy_int);
+        CASE(NPY_UINT, npy_uint);
+        CASE(NPY_LONG, npy_long);
+        CASE(NPY_ULONG, npy_ulong);
+        CASE(NPY_LONGLONG, npy_longlong);
+        CASE(NPY_ULONGLONG, npy_ulonglong);
+#undef CASE
+    }
+    return ret;
+}
+
+/* The rules of fromfile_skip_separator, on the block */
+static int
+text_block_skip_separator(text_block **ptb, const char *sep,
+                          void *NPY_UNUSED(stream_data))
+{
+    text_block *tb = *ptb;
+    const char *sep_start = sep;
+
+    while (1) {
+        int c = TB_GETC(tb);
+
+        if (c == EOF) {
+            return -1;
+        }
+        else if (*sep == '\0') {
+            TB_UNGETC(c, tb);
+            /* matched separator, or a whitespace wildcard that didn't */
+            return (sep != sep_start) ? 0 : -2;
+        }
+        else if (*sep == ' ') {
+            /* whitespace wildcard */
+            if (!isspace(c)) {
+                sep++;
+                sep_start++;
+                TB_UNGETC(c, tb);
+            }
+            else if (sep == sep_start) {
+                sep_start--;
+            }
+        }
+        else if (*sep != c) {
+            TB_UNGETC(c, tb);
+            return -2;
+        }
+        else {
+            sep++;
+        }
+    }
+}
+
+#undef TB_GETC
+#undef TB_UNGETC
+#undef TEXT_BLOCK_FLOATLEN
+
 /*
  * Remove multiple whitespace from the separator, and add a space to the
  * beginning and end. This simplifies the separator-skipping code below.
@@ -1960,9 +2333,7 @@ array_from_text(PyArray_Descr *dtype, intp num, char *sep, size_t *nread,
     intp i;
     char *dptr, *clean_sep, *tmp;
     int err = 0;
-    intp thisbuf = 0;
     intp size;
-    intp bytes, totalbytes;
 
     size = (num >= 0) ? num : FROM_BUFFER_SIZE;
     r = (PyArrayObject *)
@@ -1976,25 +2347,27 @@ array_from_text(PyArray_Descr *dtype, intp num, char *sep, size_t *nread,
     }
     clean_sep = swab_separator(sep);
     NPY_BEGIN_ALLOW_THREADS;
-    totalbytes = bytes = size * dtype->elsize;
     dptr = r->data;
     for (i= 0; num < 0 || i < num; i++) {
         if (next(&stream, dptr, dtype, stream_data) < 0) {
             break;
         }
         *nread += 1;
-        thisbuf += 1;
         dptr += dtype->elsize;
-        if (num < 0 && thisbuf == size) {
-            totalbytes += bytes;
-            tmp = PyDataMem_RENEW(r->data, totalbytes);
+        if (num < 0 && (intp) *nread == size) {
+            /* grow geometrically, so reallocation is linear overall */
+            if (size > NPY_MAX_INTP / 2 / dtype->elsize) {
+                err = 1;
+                break;
+            }
+            size *= 2;
+            tmp = PyDataMem_RENEW(r->data, size * dtype->elsize);
             if (tmp == NULL) {
                 err = 1;
                 break;
             }
             r->data = tmp;
-            dptr = tmp + (totalbytes - bytes);
-            thisbuf = 0;
+            dptr = tmp + *nread * dtype->elsize;
         }
         if (skip_sep(&stream, clean_sep, stream_data) < 0) {
             break;
@@ -2059,9 +2432,32 @@ PyArray_FromTextFile(FILE *fp, PyArray_Descr *dtype, intp num, char *sep)
         Py_DECREF(dtype);
         return NULL;
     }
-    ret = array_from_text(dtype, num, sep, &nread, fp,
-                          (next_element) fromfile_next_element,
-                          (skip_separator) fromfile_skip_separator, NULL);
+    if (text_block_supports(dtype) && ftell(fp) != -1) {
+        text_block tb;
+
+        tb.fp = fp;
+        tb.buf = tb.pos = tb.end = malloc(TEXT_BLOCK_SIZE);
+        tb.eof = 0;
+        if (tb.buf == NULL) {
+            Py_DECREF(dtype);
+            return PyErr_NoMemory();
+        }
+        ret = array_from_text(dtype, num, sep, &nread, &tb,
+                              (next_element) text_block_next_element,
+                              (skip_separator) text_block_skip_separator,
+                              NULL);
+        /* leave the file just after the text that was used */
+        if (tb.end != tb.pos) {
+            fseek(fp, -(long)(tb.end - tb.pos), SEEK_CUR);
+        }
+        free(tb.buf);
+    }
+    else {
+        ret = array_from_text(dtype, num, sep, &nread, fp,
+                              (next_element) fromfile_next_element,
+                              (skip_separator) fromfile_skip_separator,
+                              NULL);
+    }
     if (ret == NULL) {
         Py_DECREF(dtype);
         return NULL;
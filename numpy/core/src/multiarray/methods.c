@@ -412,17 +412,29 @@ array_tostring(PyArrayObject *self, PyObject *args, PyObject *kwds)
 static PyObject *
 array_tofile(PyArrayObject *self, PyObject *args, PyObject *kwds)
 {
-    int ret;
+    int ret, swap;
     PyObject *file;
     FILE *fd;
     char *sep = "";
     char *format = "";
-    static char *kwlist[] = {"file", "sep", "format", NULL};
+    char endian = PyArray_IGNORE;
+    static char *kwlist[] = {"file", "sep", "format", "byteorder", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ss", kwlist,
-                                     &file, &sep, &format)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|ssO&", kwlist,
+                                     &file, &sep, &format,
+                                     PyArray_ByteorderConverter, &endian)) {
         return NULL;
     }
+    if (endian == PyArray_SWAP) {
+        swap = 1;
+    }
+    else if (endian == PyArray_IGNORE
+             || self->descr->byteorder == PyArray_IGNORE) {
+        swap = 0;
+    }
+    else {
+        swap = !PyArray_EquivByteorders(self->descr->byteorder, endian);
+    }
 
     if (PyBytes_Check(file) || PyUnicode_Check(file)) {
         file = npy_PyFile_OpenFile(file, "wb");
@@ -444,7 +456,12 @@ array_tofile(PyArrayObject *self, PyObject *args, PyObject *kwds)
         Py_DECREF(file);
         return NULL;
     }
-    ret = PyArray_ToFile(self, fd, sep, format);
+    if (swap && sep[0] == '\0') {
+        ret = NpyArray_ToBinaryFileSwap(self, fd, 1);
+    }
+    else {
+        ret = PyArray_ToFile(self, fd, sep, format);
+    }
 #if defined(NPY_PY3K)
     fclose(fd);
 #endif
@@ -43,6 +43,8 @@ NPY_NO_EXPORT int NPY_NUMUSERTYPES = 0;
 #include "number.h"
 #include "scalartypes.h"
 #include "numpymemoryview.h"
+#include "textreading.h"
+#include "textwriting.h"
 
 /*NUMPY_API
  * Get Priority from object
@@ -629,7 +631,7 @@ PyArray_CopyAndTranspose(PyObject *op)
 {
     PyObject *ret, *arr;
     int nd;
-    intp dims[2];
+    intp dims[2], ostrides[2];
     intp i,j;
     int elsize, str2;
     char *iptr;
@@ -668,6 +670,20 @@ PyArray_CopyAndTranspose(PyObject *op)
         return NULL;
     }
 
+    /* ret[j,i] = arr[i,j], so these are the strides of ret seen by arr */
+    ostrides[0] = elsize;
+    ostrides[1] = elsize*dims[1];
+    if (_is_transposed_copy(ostrides, PyArray_STRIDES(arr),
+                            PyArray_DIMS(arr), 2)) {
+        NPY_BEGIN_ALLOW_THREADS;
+        _transposed_copy(PyArray_DATA(ret), ostrides,
+                         PyArray_DATA(arr), PyArray_STRIDES(arr),
+                         PyArray_DIMS(arr), 2, elsize);
+        NPY_END_ALLOW_THREADS;
+        Py_DECREF(arr);
+        return ret;
+    }
+
     /* do 2-d loop */
     NPY_BEGIN_ALLOW_THREADS;
     optr = PyArray_DATA(ret);
@@ -1974,6 +1990,84 @@ as_buffer(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
 
 #undef _test_code
 
+#if defined(HAVE_UNISTD_H)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+/*
+ * Give the kernel an access-pattern hint for the pages spanned by an
+ * array.  memmap uses this so that scans over a mapped file are read
+ * ahead instead of stalling on every page fault.  Returns False when the
+ * platform has no madvise; the hint is advisory either way.
+ */
+static PyObject *
+array__madvise(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
+{
+    PyArrayObject *arr;
+    char *advice;
+    int i, flag = -1;
+    static char *kwlist[] = {"arr", "advice", NULL};
+    static char *names[] = {"normal", "sequential", "random", "willneed",
+                            NULL};
+#if defined(MADV_WILLNEED)
+    static int flags[] = {MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM,
+                          MADV_WILLNEED};
+    intp lo, hi, page;
+    char *start, *end;
+    int ret;
+#endif
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O!s", kwlist,
+                &PyArray_Type, &arr, &advice)) {
+        return NULL;
+    }
+    for (i = 0; names[i] != NULL; i++) {
+        if (strcmp(advice, names[i]) == 0) {
+            flag = i;
+            break;
+        }
+    }
+    if (flag < 0) {
+        PyErr_Format(PyExc_ValueError,
+                "advice must be one of 'normal', 'sequential', 'random' "
+                "or 'willneed', not '%s'", advice);
+        return NULL;
+    }
+#if defined(MADV_WILLNEED)
+    if (PyArray_SIZE(arr) == 0) {
+        Py_RETURN_TRUE;
+    }
+    /* byte bounds of the array, which may have negative strides */
+    lo = 0;
+    hi = PyArray_ITEMSIZE(arr);
+    for (i = 0; i < PyArray_NDIM(arr); i++) {
+        intp extent = PyArray_STRIDES(arr)[i]*(PyArray_DIMS(arr)[i] - 1);
+
+        if (extent < 0) {
+            lo += extent;
+        }
+        else {
+            hi += extent;
+        }
+    }
+    /* madvise wants a page-aligned start */
+    page = (intp)sysconf(_SC_PAGESIZE);
+    start = PyArray_BYTES(arr) + lo;
+    end = PyArray_BYTES(arr) + hi;
+    start -= (npy_uintp)start % (npy_uintp)page;
+    NPY_BEGIN_ALLOW_THREADS;
+    ret = madvise((void *)start, (size_t)(end - start), flags[flag]);
+    NPY_END_ALLOW_THREADS;
+    if (ret != 0) {
+        return PyErr_SetFromErrno(PyExc_OSError);
+    }
+    Py_RETURN_TRUE;
+#else
+    Py_RETURN_FALSE;
+#endif
+}
+
 static PyObject *
 format_longfloat(PyObject *NPY_UNUSED(dummy), PyObject *args, PyObject *kwds)
 {
@@ -2467,6 +2561,15 @@ static struct PyMethodDef array_module_methods[] = {
     {"_vec_string",
         (PyCFunction)_vec_string,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_readtext",
+        (PyCFunction)array__readtext,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_writetext",
+        (PyCFunction)array__writetext,
+        METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_madvise",
+        (PyCFunction)array__madvise,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"test_interrupt",
         (PyCFunction)test_interrupt,
         METH_VARARGS, NULL},
@@ -2759,6 +2862,14 @@ PyMODINIT_FUNC initmultiarray(void) {
     if (PyErr_Occurred()) {
         goto err;
     }
+#if NPY_TRACE
+    c_api = NpyCapsule_FromVoidPtr((void *)npy_trace_state, NULL);
+    PyDict_SetItemString(d, "_TRACE_STATE", c_api);
+    Py_DECREF(c_api);
+    if (PyErr_Occurred()) {
+        goto err;
+    }
+#endif
 
     /* Initialize types in numpymemoryview.c */
     if (_numpymemoryview_init(&s) < 0) {
@@ -34,6 +34,8 @@
 #include "refcount.c"
 #include "conversion_utils.c"
 #include "buffer.c"
+#include "textreading.c"
+#include "textwriting.c"
 
 
 #ifndef Py_UNICODE_WIDE
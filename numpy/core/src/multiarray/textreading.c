@@ -0,0 +1,1062 @@
+/*
+ * Tokenizer and converters for loadtxt and genfromtxt.
+ *
+ * The text is read from the file in large chunks and split into lines,
+ * the lines into fields, and each field of a used column is converted
+ * straight into a typed column array that grows geometrically as rows
+ * come in.  Only fixed size numeric types and byte strings are handled
+ * here; the Python readers keep their own code for everything else.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+
+#define _MULTIARRAYMODULE
+#define NPY_NO_PREFIX
+#include "numpy/arrayobject.h"
+#include "numpy/numpy_api.h"
+
+#include "numpy/npy_math.h"
+
+#include "npy_config.h"
+
+#include "npy_3kcompat.h"
+
+#include "common.h"
+#include "conversion_utils.h"
+#include "numpyos.h"
+#include "textreading.h"
+
+/* Bytes asked from the file object per read call */
+#define TEXT_CHUNK (1 << 20)
+
+/* Conversion results of the field converters */
+#define CONV_OK 0
+#define CONV_INVALID -1
+#define CONV_OVERFLOW -2
+
+typedef struct {
+    PyArrayObject *values;
+    PyArrayObject *mask;        /* NULL unless missing values are flagged */
+    PyArray_Descr *descr;
+    /* value stored when the field cannot be converted, or NULL to raise */
+    PyArrayObject *fill;
+    /* byte strings flagging a missing value, or NULL */
+    PyObject *missing;
+} text_column;
+
+typedef struct {
+    const char *delimiter;      /* NULL splits at runs of whitespace */
+    Py_ssize_t ndelimiter;
+    const char *comments;       /* NULL when there are no comments */
+    Py_ssize_t ncomments;
+    char strip[256];            /* characters stripped from the line ends */
+    npy_intp *usecols;          /* NULL uses the leading columns */
+    int exact;                  /* rows must have exactly ncols fields */
+    int boolwords;              /* booleans are True/False, not integers */
+    long lineno;                /* line number of the first line, for errors */
+    PyObject *invalid;          /* list collecting bad rows, or NULL */
+
+    int ncols;
+    text_column *cols;
+    npy_intp nrows, capacity;
+
+    /* fields of the current line */
+    const char **fstart;
+    Py_ssize_t *flen;
+    Py_ssize_t nfields, fcapacity;
+
+    /* NUL terminated copy of a field for NumPyOS_ascii_strtod */
+    char *scratch;
+    Py_ssize_t nscratch;
+} text_parser;
+
+static NPY_INLINE int
+is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' ||
+        c == '\v' || c == '\f';
+}
+
+/* Strip whitespace as bytes.strip() does */
+static void
+strip_field(const char **s, Py_ssize_t *n)
+{
+    const char *p = *s, *end = *s + *n;
+
+    while (p < end && is_space(*p)) {
+        p++;
+    }
+    while (end > p && is_space(end[-1])) {
+        end--;
+    }
+    *s = p;
+    *n = end - p;
+}
+
+/*
+ * Powers of ten that are exact in double precision; a decimal with at most
+ * 2**53 as mantissa scaled by one of them is rounded once, and so exactly.
+ */
+static const double exact_pow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Convert a field to double the way float() does.  Plain decimals short
+ * enough to be converted exactly are done inline, anything else (long
+ * mantissas, large exponents, inf and nan) by NumPyOS_ascii_strtod.
+ */
+static int
+parse_double(text_parser *tp, const char *s, Py_ssize_t n, double *out)
+{
+    const char *p, *end;
+    npy_uint64 mant = 0;
+    int ndigits = 0, exp10 = 0, any = 0, neg = 0, slow = 0;
+    char *endptr;
+
+    strip_field(&s, &n);
+    p = s;
+    end = s + n;
+    if (p < end && (*p == '+' || *p == '-')) {
+        neg = (*p == '-');
+        p++;
+    }
+    for (; p < end && *p >= '0' && *p <= '9'; p++, any = 1) {
+        if (ndigits < 19) {
+            mant = 10*mant + (*p - '0');
+            ndigits += (mant != 0);
+        }
+        else {
+            slow = 1;
+        }
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++, any = 1) {
+            if (ndigits < 19) {
+                mant = 10*mant + (*p - '0');
+                ndigits += (mant != 0);
+                exp10--;
+            }
+            else {
+                slow = 1;
+            }
+        }
+    }
+    if (any && p < end && (*p == 'e' || *p == 'E')) {
+        int eneg = 0, e = 0, edigits = 0;
+
+        p++;
+        if (p < end && (*p == '+' || *p == '-')) {
+            eneg = (*p == '-');
+            p++;
+        }
+        for (; p < end && *p >= '0' && *p <= '9'; p++, edigits++) {
+            if (e < 10000) {
+                e = 10*e + (*p - '0');
+            }
+        }
+        if (edigits == 0) {
+            slow = 1;
+        }
+        exp10 += eneg ? -e : e;
+    }
+    if (any && p == end && !slow && mant <= ((npy_uint64)1 << 53) &&
+            exp10 >= -22 && exp10 <= 22) {
+        double v = (double)mant;
+
+        v = exp10 < 0 ? v/exact_pow10[-exp10] : v*exact_pow10[exp10];
+        *out = neg ? -v : v;
+        return CONV_OK;
+    }
+
+    if (n == 0) {
+        return CONV_INVALID;
+    }
+    if (n >= tp->nscratch) {
+        char *tmp = PyMem_Realloc(tp->scratch, n + 1);
+        if (tmp == NULL) {
+            PyErr_NoMemory();
+            return CONV_OVERFLOW;
+        }
+        tp->scratch = tmp;
+        tp->nscratch = n + 1;
+    }
+    memcpy(tp->scratch, s, n);
+    tp->scratch[n] = '\0';
+    *out = NumPyOS_ascii_strtod(tp->scratch, &endptr);
+    if (endptr != tp->scratch + n) {
+        return CONV_INVALID;
+    }
+    return CONV_OK;
+}
+
+/*
+ * Convert a field to a sign and magnitude the way int(float(x)) does:
+ * plain integers exactly, anything else through parse_double.
+ */
+static int
+parse_integer(text_parser *tp, const char *s, Py_ssize_t n,
+              int *neg, npy_uint64 *mag)
+{
+    const char *p, *end;
+    const char *s0 = s;
+    Py_ssize_t n0 = n;
+    npy_uint64 v = 0;
+    double d;
+    int ret;
+
+    strip_field(&s, &n);
+    p = s;
+    end = s + n;
+    *neg = 0;
+    if (p < end && (*p == '+' || *p == '-')) {
+        *neg = (*p == '-');
+        p++;
+    }
+    if (p < end) {
+        for (; p < end && *p >= '0' && *p <= '9'; p++) {
+            if (v > (NPY_MAX_UINT64 - (*p - '0'))/10) {
+                break;
+            }
+            v = 10*v + (*p - '0');
+        }
+        if (p == end) {
+            *mag = v;
+            return CONV_OK;
+        }
+    }
+
+    ret = parse_double(tp, s0, n0, &d);
+    if (ret != CONV_OK) {
+        return ret;
+    }
+    if (npy_isnan(d)) {
+        return CONV_INVALID;
+    }
+    *neg = d < 0;
+    d = *neg ? -d : d;
+    if (!(d < 18446744073709551616.0)) {
+        return CONV_OVERFLOW;
+    }
+    *mag = (npy_uint64)d;
+    return CONV_OK;
+}
+
+/* two's complement: the range of a signed type is [-max - 1, max] */
+#define STORE_SIGNED(type, max)                                         \
+    if (neg && mag != 0) {                                              \
+        if (mag - 1 > (npy_uint64)(max)) {                              \
+            return CONV_OVERFLOW;                                       \
+        }                                                               \
+        *(type *)out = (type)(-(npy_int64)(mag - 1) - 1);               \
+    }                                                                   \
+    else if (mag > (npy_uint64)(max)) {                                 \
+        return CONV_OVERFLOW;                                           \
+    }                                                                   \
+    else {                                                              \
+        *(type *)out = (type)mag;                                       \
+    }                                                                   \
+    break
+
+#define STORE_UNSIGNED(type, max)                                       \
+    if ((neg && mag != 0) || mag > (npy_uint64)(max)) {                 \
+        return CONV_OVERFLOW;                                           \
+    }                                                                   \
+    *(type *)out = (type)mag;                                           \
+    break
+
+static int
+convert_field(text_parser *tp, text_column *col, const char *s,
+              Py_ssize_t n, char *out)
+{
+    double d = 0;
+    int neg, ret;
+    npy_uint64 mag;
+
+    switch (col->descr->type_num) {
+        case NPY_BOOL:
+            if (tp->boolwords) {
+                /* str2bool: no stripping, case insensitive */
+                if (n == 4 && PyOS_strnicmp(s, "true", 4) == 0) {
+                    *(npy_bool *)out = 1;
+                }
+                else if (n == 5 && PyOS_strnicmp(s, "false", 5) == 0) {
+                    *(npy_bool *)out = 0;
+                }
+                else {
+                    return CONV_INVALID;
+                }
+                return CONV_OK;
+            }
+            else {
+                /* bool(int(x)) */
+                const char *end;
+                int any = 0, nonzero = 0;
+
+                strip_field(&s, &n);
+                end = s + n;
+                if (s < end && (*s == '+' || *s == '-')) {
+                    s++;
+                }
+                for (; s < end && *s >= '0' && *s <= '9'; s++, any = 1) {
+                    nonzero |= (*s != '0');
+                }
+                if (!any || s != end) {
+                    return CONV_INVALID;
+                }
+                *(npy_bool *)out = nonzero;
+                return CONV_OK;
+            }
+        case NPY_FLOAT:
+            ret = parse_double(tp, s, n, &d);
+            *(float *)out = (float)d;
+            return ret;
+        case NPY_DOUBLE:
+            return parse_double(tp, s, n, (double *)out);
+        case NPY_LONGDOUBLE:
+            ret = parse_double(tp, s, n, &d);
+            *(npy_longdouble *)out = (npy_longdouble)d;
+            return ret;
+        case NPY_STRING:
+            if (n > col->descr->elsize) {
+                n = col->descr->elsize;
+            }
+            memcpy(out, s, n);
+            memset(out + n, 0, col->descr->elsize - n);
+            return CONV_OK;
+    }
+
+    ret = parse_integer(tp, s, n, &neg, &mag);
+    if (ret != CONV_OK) {
+        return ret;
+    }
+    switch (col->descr->type_num) {
+        case NPY_BYTE:
+            STORE_SIGNED(npy_byte, NPY_MAX_BYTE);
+        case NPY_UBYTE:
+            STORE_UNSIGNED(npy_ubyte, NPY_MAX_UBYTE);
+        case NPY_SHORT:
+            STORE_SIGNED(npy_short, NPY_MAX_SHORT);
+        case NPY_USHORT:
+            STORE_UNSIGNED(npy_ushort, NPY_MAX_USHORT);
+        case NPY_INT:
+            STORE_SIGNED(npy_int, NPY_MAX_INT);
+        case NPY_UINT:
+            STORE_UNSIGNED(npy_uint, NPY_MAX_UINT);
+        case NPY_LONG:
+            STORE_SIGNED(npy_long, NPY_MAX_LONG);
+        case NPY_ULONG:
+            STORE_UNSIGNED(npy_ulong, NPY_MAX_ULONG);
+        case NPY_LONGLONG:
+            STORE_SIGNED(npy_longlong, NPY_MAX_LONGLONG);
+        case NPY_ULONGLONG:
+            STORE_UNSIGNED(npy_ulonglong, NPY_MAX_ULONGLONG);
+    }
+    return CONV_OK;
+}
+
+#undef STORE_SIGNED
+#undef STORE_UNSIGNED
+
+/* Whether the stripped field is one of the missing value strings */
+static int
+is_missing(text_column *col, const char *s, Py_ssize_t n)
+{
+    Py_ssize_t i, nmissing = PySequence_Fast_GET_SIZE(col->missing);
+    PyObject **items = PySequence_Fast_ITEMS(col->missing);
+
+    strip_field(&s, &n);
+    for (i = 0; i < nmissing; i++) {
+        if (PyBytes_GET_SIZE(items[i]) == n &&
+                memcmp(PyBytes_AS_STRING(items[i]), s, n) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int
+grow_columns(text_parser *tp)
+{
+    npy_intp capacity = tp->capacity < 1024 ? 1024 : 2*tp->capacity;
+    int i;
+
+    for (i = 0; i < tp->ncols; i++) {
+        text_column *col = &tp->cols[i];
+        char *tmp;
+
+        tmp = PyDataMem_RENEW(col->values->data,
+                              capacity*col->descr->elsize);
+        if (tmp == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        col->values->data = tmp;
+        if (col->mask != NULL) {
+            tmp = PyDataMem_RENEW(col->mask->data, capacity);
+            if (tmp == NULL) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            col->mask->data = tmp;
+        }
+    }
+    tp->capacity = capacity;
+    return 0;
+}
+
+static int
+push_field(text_parser *tp, const char *s, Py_ssize_t n)
+{
+    if (tp->nfields == tp->fcapacity) {
+        Py_ssize_t fcapacity = tp->fcapacity ? 2*tp->fcapacity : 64;
+        const char **fstart;
+        Py_ssize_t *flen;
+
+        fstart = PyMem_Realloc((void *)tp->fstart,
+                               fcapacity*sizeof(*tp->fstart));
+        if (fstart == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        tp->fstart = fstart;
+        flen = PyMem_Realloc(tp->flen, fcapacity*sizeof(*tp->flen));
+        if (flen == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        tp->flen = flen;
+        tp->fcapacity = fcapacity;
+    }
+    tp->fstart[tp->nfields] = s;
+    tp->flen[tp->nfields] = n;
+    tp->nfields++;
+    return 0;
+}
+
+static int
+bad_row(text_parser *tp, long index)
+{
+    PyObject *item;
+    int ret;
+
+    if (tp->invalid == NULL) {
+        PyErr_Format(PyExc_ValueError,
+                "wrong number of columns at line %ld", tp->lineno + index + 1);
+        return -1;
+    }
+    item = Py_BuildValue("(ln)", index, tp->nfields);
+    if (item == NULL) {
+        return -1;
+    }
+    ret = PyList_Append(tp->invalid, item);
+    Py_DECREF(item);
+    return ret;
+}
+
+static int
+bad_value(text_parser *tp, text_column *col, int ret, const char *s,
+          Py_ssize_t n, long index)
+{
+    char value[64];
+
+    if (PyErr_Occurred()) {
+        return -1;
+    }
+    if (n > (Py_ssize_t)sizeof(value) - 1) {
+        n = sizeof(value) - 1;
+    }
+    memcpy(value, s, n);
+    value[n] = '\0';
+    PyErr_Format(ret == CONV_OVERFLOW ? PyExc_OverflowError :
+                                        PyExc_ValueError,
+            "cannot convert '%s' to %s at line %ld", value,
+            col->descr->typeobj->tp_name, tp->lineno + index + 1);
+    return -1;
+}
+
+/* Split one line, without its newline, and store its row if it has one */
+static int
+parse_line(text_parser *tp, const char *line, Py_ssize_t n, long index)
+{
+    const char *p, *end;
+    int i;
+
+    /* Chop off comments, strip, and split at the delimiter */
+    if (tp->comments != NULL) {
+        const char *c = line, *cend = line + n - tp->ncomments;
+
+        for (; c <= cend; c++) {
+            c = memchr(c, tp->comments[0], cend - c + 1);
+            if (c == NULL) {
+                break;
+            }
+            if (memcmp(c, tp->comments, tp->ncomments) == 0) {
+                n = c - line;
+                break;
+            }
+        }
+    }
+    while (n > 0 && tp->strip[(unsigned char)line[0]]) {
+        line++;
+        n--;
+    }
+    while (n > 0 && tp->strip[(unsigned char)line[n - 1]]) {
+        n--;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    p = line;
+    end = line + n;
+    tp->nfields = 0;
+    if (tp->delimiter == NULL) {
+        while (1) {
+            const char *start;
+
+            while (p < end && is_space(*p)) {
+                p++;
+            }
+            if (p == end) {
+                break;
+            }
+            for (start = p; p < end && !is_space(*p); p++) {
+                ;
+            }
+            if (push_field(tp, start, p - start) < 0) {
+                return -1;
+            }
+        }
+        if (tp->nfields == 0) {
+            return 0;
+        }
+    }
+    else {
+        const char *last = end - tp->ndelimiter;
+
+        while (1) {
+            const char *next = NULL;
+
+            if (p <= last) {
+                for (next = memchr(p, tp->delimiter[0], last - p + 1);
+                     next != NULL;
+                     next = next < last ?
+                         memchr(next + 1, tp->delimiter[0], last - next) :
+                         NULL) {
+                    if (memcmp(next, tp->delimiter, tp->ndelimiter) == 0) {
+                        break;
+                    }
+                }
+            }
+            if (next == NULL) {
+                if (push_field(tp, p, end - p) < 0) {
+                    return -1;
+                }
+                break;
+            }
+            if (push_field(tp, p, next - p) < 0) {
+                return -1;
+            }
+            p = next + tp->ndelimiter;
+        }
+    }
+
+    if (tp->usecols == NULL && (tp->nfields < tp->ncols ||
+                                (tp->exact && tp->nfields != tp->ncols))) {
+        return bad_row(tp, index);
+    }
+    if (tp->usecols != NULL) {
+        for (i = 0; i < tp->ncols; i++) {
+            npy_intp c = tp->usecols[i];
+
+            if (c < 0) {
+                c += tp->nfields;
+            }
+            if (c < 0 || c >= tp->nfields) {
+                return bad_row(tp, index);
+            }
+        }
+    }
+
+    if (tp->nrows == tp->capacity && grow_columns(tp) < 0) {
+        return -1;
+    }
+    for (i = 0; i < tp->ncols; i++) {
+        text_column *col = &tp->cols[i];
+        npy_intp c = i;
+        char *out;
+        int ret;
+
+        if (tp->usecols != NULL) {
+            c = tp->usecols[i] < 0 ? tp->usecols[i] + tp->nfields
+                                   : tp->usecols[i];
+        }
+        out = col->values->data + tp->nrows*col->descr->elsize;
+        ret = convert_field(tp, col, tp->fstart[c], tp->flen[c], out);
+        if (ret == CONV_INVALID && col->fill != NULL) {
+            memcpy(out, col->fill->data, col->descr->elsize);
+        }
+        else if (ret != CONV_OK) {
+            return bad_value(tp, col, ret, tp->fstart[c], tp->flen[c], index);
+        }
+        if (col->mask != NULL) {
+            col->mask->data[tp->nrows] =
+                (char)is_missing(col, tp->fstart[c], tp->flen[c]);
+        }
+    }
+    tp->nrows++;
+    return 0;
+}
+
+/*
+ * Parse the complete lines of buf, returning the number of bytes used, or
+ * all of it when final is set.
+ */
+static Py_ssize_t
+parse_lines(text_parser *tp, const char *buf, Py_ssize_t n, int final,
+            long *index)
+{
+    Py_ssize_t start = 0;
+
+    while (start < n) {
+        const char *nl = memchr(buf + start, '\n', n - start);
+        Py_ssize_t stop;
+
+        if (nl == NULL) {
+            if (!final) {
+                break;
+            }
+            stop = n;
+        }
+        else {
+            stop = nl - buf;
+        }
+        if (parse_line(tp, buf + start, stop - start, *index) < 0) {
+            return -1;
+        }
+        (*index)++;
+        start = stop + 1;
+    }
+    return start < n ? start : n;
+}
+
+/* The next chunk of the file as a new bytes object, empty at the end */
+static PyObject *
+read_chunk(PyObject *fh)
+{
+    PyObject *chunk = PyObject_CallMethod(fh, "read", "n",
+                                          (Py_ssize_t)TEXT_CHUNK);
+
+    if (chunk != NULL && PyUnicode_Check(chunk)) {
+        PyObject *tmp = PyUnicode_AsLatin1String(chunk);
+        Py_DECREF(chunk);
+        chunk = tmp;
+    }
+    if (chunk != NULL && !PyBytes_Check(chunk)) {
+        PyErr_SetString(PyExc_TypeError,
+                "read() of the file must return a string");
+        Py_DECREF(chunk);
+        chunk = NULL;
+    }
+    return chunk;
+}
+
+static int
+parse_file(text_parser *tp, PyObject *prefix, PyObject *fh)
+{
+    char *pending = NULL;
+    Py_ssize_t npending = 0, pcapacity = 0, used;
+    long index = 0;
+    int ret = -1;
+
+    if (prefix != NULL) {
+        char *s;
+        Py_ssize_t n;
+
+        if (PyBytes_AsStringAndSize(prefix, &s, &n) < 0) {
+            return -1;
+        }
+        if (n > 0 && s[n - 1] == '\n') {
+            n--;
+        }
+        if (parse_line(tp, s, n, index++) < 0) {
+            return -1;
+        }
+    }
+
+    while (fh != NULL) {
+        PyObject *chunk = read_chunk(fh);
+        const char *s;
+        Py_ssize_t n;
+
+        if (chunk == NULL) {
+            goto finish;
+        }
+        s = PyBytes_AS_STRING(chunk);
+        n = PyBytes_GET_SIZE(chunk);
+        if (n == 0) {
+            Py_DECREF(chunk);
+            break;
+        }
+        if (npending == 0) {
+            /* parse in place, keeping only the partial last line */
+            used = parse_lines(tp, s, n, 0, &index);
+        }
+        else {
+            if (npending + n > pcapacity) {
+                char *tmp;
+
+                pcapacity = 2*(npending + n);
+                tmp = PyMem_Realloc(pending, pcapacity);
+                if (tmp == NULL) {
+                    PyErr_NoMemory();
+                    Py_DECREF(chunk);
+                    goto finish;
+                }
+                pending = tmp;
+            }
+            memcpy(pending + npending, s, n);
+            npending += n;
+            s = pending;
+            n = npending;
+            used = parse_lines(tp, s, n, 0, &index);
+        }
+        if (used < 0) {
+            Py_DECREF(chunk);
+            goto finish;
+        }
+        if (used < n) {
+            if (n - used > pcapacity) {
+                char *tmp;
+
+                pcapacity = 2*(n - used);
+                tmp = PyMem_Realloc(pending, pcapacity);
+                if (tmp == NULL) {
+                    PyErr_NoMemory();
+                    Py_DECREF(chunk);
+                    goto finish;
+                }
+                /* s may point into the old pending buffer */
+                if (s == pending) {
+                    s = tmp;
+                }
+                pending = tmp;
+            }
+            memmove(pending, s + used, n - used);
+        }
+        npending = n - used;
+        Py_DECREF(chunk);
+    }
+    if (npending > 0 && parse_lines(tp, pending, npending, 1, &index) < 0) {
+        goto finish;
+    }
+    ret = 0;
+
+finish:
+    PyMem_Free(pending);
+    return ret;
+}
+
+static void
+free_parser(text_parser *tp)
+{
+    int i;
+
+    if (tp->cols != NULL) {
+        for (i = 0; i < tp->ncols; i++) {
+            Py_XDECREF(tp->cols[i].values);
+            Py_XDECREF(tp->cols[i].mask);
+            Py_XDECREF(tp->cols[i].descr);
+            Py_XDECREF(tp->cols[i].fill);
+            Py_XDECREF(tp->cols[i].missing);
+        }
+        PyMem_Free(tp->cols);
+    }
+    PyMem_Free(tp->usecols);
+    PyMem_Free((void *)tp->fstart);
+    PyMem_Free(tp->flen);
+    PyMem_Free(tp->scratch);
+}
+
+/* Optional bytes argument as pointer and length, NULL for None or empty */
+static int
+bytes_arg(PyObject *obj, const char **s, Py_ssize_t *n)
+{
+    char *tmp;
+
+    *s = NULL;
+    *n = 0;
+    if (obj == NULL || obj == Py_None) {
+        return 0;
+    }
+    if (PyBytes_AsStringAndSize(obj, &tmp, n) < 0) {
+        return -1;
+    }
+    if (*n > 0) {
+        *s = tmp;
+    }
+    return 0;
+}
+
+static int
+setup_column(text_column *col, PyObject *dtype, PyObject *fill,
+             PyObject *missing)
+{
+    npy_intp zero = 0;
+    int type_num;
+
+    if (!PyArray_DescrConverter(dtype, &col->descr)) {
+        return -1;
+    }
+    type_num = col->descr->type_num;
+    if (!(PyTypeNum_ISBOOL(type_num) || PyTypeNum_ISINTEGER(type_num) ||
+          PyTypeNum_ISFLOAT(type_num) ||
+          (type_num == NPY_STRING && col->descr->elsize > 0)) ||
+            !PyArray_ISNBO(col->descr->byteorder)) {
+        PyErr_SetString(PyExc_TypeError,
+                "_readtext only reads native numeric and string types");
+        return -1;
+    }
+
+    Py_INCREF(col->descr);
+    col->values = (PyArrayObject *)PyArray_NewFromDescr(&PyArray_Type,
+            col->descr, 1, &zero, NULL, NULL, 0, NULL);
+    if (col->values == NULL) {
+        return -1;
+    }
+    if (fill != NULL && fill != Py_None) {
+        Py_INCREF(col->descr);
+        col->fill = (PyArrayObject *)PyArray_FromAny(fill, col->descr, 0, 0,
+                NPY_CARRAY | NPY_FORCECAST, NULL);
+        if (col->fill == NULL) {
+            return -1;
+        }
+        if (PyArray_SIZE(col->fill) != 1) {
+            PyErr_SetString(PyExc_ValueError,
+                    "fill values must be scalars");
+            return -1;
+        }
+    }
+    if (missing != NULL) {
+        Py_ssize_t i;
+
+        col->missing = PySequence_Fast(missing,
+                "missing values must be sequences of strings");
+        if (col->missing == NULL) {
+            return -1;
+        }
+        for (i = 0; i < PySequence_Fast_GET_SIZE(col->missing); i++) {
+            if (!PyBytes_Check(PySequence_Fast_GET_ITEM(col->missing, i))) {
+                PyErr_SetString(PyExc_TypeError,
+                        "missing values must be sequences of strings");
+                return -1;
+            }
+        }
+        col->mask = (PyArrayObject *)PyArray_SimpleNew(1, &zero, NPY_BOOL);
+        if (col->mask == NULL) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/* Trim the columns to the rows read and return them as a list */
+static PyObject *
+finish_columns(text_parser *tp, int masks)
+{
+    PyObject *ret = PyList_New(tp->ncols);
+    npy_intp size = tp->nrows > 0 ? tp->nrows : 1;
+    int i;
+
+    if (ret == NULL) {
+        return NULL;
+    }
+    for (i = 0; i < tp->ncols; i++) {
+        PyArrayObject *arr = masks ? tp->cols[i].mask : tp->cols[i].values;
+        char *tmp;
+
+        tmp = PyDataMem_RENEW(arr->data, size*arr->descr->elsize);
+        if (tmp == NULL) {
+            PyErr_NoMemory();
+            Py_DECREF(ret);
+            return NULL;
+        }
+        arr->data = tmp;
+        arr->dimensions[0] = tp->nrows;
+        Py_INCREF(arr);
+        PyList_SET_ITEM(ret, i, (PyObject *)arr);
+    }
+    return ret;
+}
+
+/*
+ * _readtext(fh, prefix, dtypes, delimiter=None, comments=None, strip=None,
+ *           usecols=None, exact=False, missing=None, filling=None,
+ *           invalid=None, boolwords=False, lineno=0)
+ *
+ * Read the lines of `prefix`, taken as a single line, and then those of
+ * the file `fh` (anything with a read method, or None) into one column
+ * per entry of `dtypes`.  Lines are cut at `comments`, stripped of the
+ * characters in `strip` and split at `delimiter`, or at whitespace when it
+ * is None; empty lines are skipped.  `usecols` picks the columns from the
+ * fields, negative ones counting from the end of each row, otherwise the
+ * leading fields are used, all of them if `exact` is set.
+ *
+ * Numbers are converted like float() and int(float()) do, booleans like
+ * bool(int()), or like str2bool if `boolwords` is set.  A field that
+ * cannot be converted takes the column's entry of `filling` if it is not
+ * None and raises ValueError otherwise.  If `missing` is given, a boolean
+ * column per column flags the fields in its entry of missing strings.
+ * Rows with too few fields are appended as (index, nfields) to the list
+ * `invalid` if given and raise ValueError otherwise; `lineno` is added to
+ * line numbers in error messages.
+ *
+ * Returns a list of the columns and a list of the masks, or None.
+ */
+NPY_NO_EXPORT PyObject *
+array__readtext(PyObject *NPY_UNUSED(ignored), PyObject *args,
+                PyObject *kwds)
+{
+    static char *kwlist[] = {"fh", "prefix", "dtypes", "delimiter",
+                             "comments", "strip", "usecols", "exact",
+                             "missing", "filling", "invalid", "boolwords",
+                             "lineno", NULL};
+    PyObject *fh, *prefix, *dtypes, *delimiter = NULL, *comments = NULL;
+    PyObject *strip = NULL, *usecols = NULL, *missing = NULL;
+    PyObject *filling = NULL, *invalid = NULL;
+    PyObject *seq = NULL, *values = NULL, *masks = NULL;
+    text_parser tp;
+    const char *s;
+    Py_ssize_t n, i;
+
+    memset(&tp, 0, sizeof(tp));
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOO|OOOOiOOOil", kwlist,
+                &fh, &prefix, &dtypes, &delimiter, &comments, &strip,
+                &usecols, &tp.exact, &missing, &filling, &invalid,
+                &tp.boolwords, &tp.lineno)) {
+        return NULL;
+    }
+    if (bytes_arg(delimiter, &tp.delimiter, &tp.ndelimiter) < 0 ||
+            bytes_arg(comments, &tp.comments, &tp.ncomments) < 0 ||
+            bytes_arg(strip, &s, &n) < 0) {
+        return NULL;
+    }
+    if (strip == NULL || strip == Py_None) {
+        s = " \t\n\r\v\f";
+        n = 6;
+    }
+    for (i = 0; i < n; i++) {
+        tp.strip[(unsigned char)s[i]] = 1;
+    }
+    if (invalid != NULL && invalid != Py_None) {
+        if (!PyList_Check(invalid)) {
+            PyErr_SetString(PyExc_TypeError, "invalid must be a list");
+            return NULL;
+        }
+        tp.invalid = invalid;
+    }
+    if (fh == Py_None) {
+        fh = NULL;
+    }
+    if (prefix == Py_None) {
+        prefix = NULL;
+    }
+
+    seq = PySequence_Fast(dtypes, "dtypes must be a sequence");
+    if (seq == NULL) {
+        return NULL;
+    }
+    tp.ncols = (int)PySequence_Fast_GET_SIZE(seq);
+    if (tp.ncols == 0) {
+        PyErr_SetString(PyExc_ValueError, "no columns to read");
+        goto fail;
+    }
+    tp.cols = PyMem_Malloc(tp.ncols*sizeof(text_column));
+    if (tp.cols == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+    memset(tp.cols, 0, tp.ncols*sizeof(text_column));
+    for (i = 0; i < tp.ncols; i++) {
+        PyObject *fill = NULL, *miss = NULL;
+        int ret;
+
+        if (filling != NULL && filling != Py_None) {
+            fill = PySequence_GetItem(filling, i);
+            if (fill == NULL) {
+                goto fail;
+            }
+        }
+        if (missing != NULL && missing != Py_None) {
+            miss = PySequence_GetItem(missing, i);
+            if (miss == NULL) {
+                Py_XDECREF(fill);
+                goto fail;
+            }
+        }
+        ret = setup_column(&tp.cols[i], PySequence_Fast_GET_ITEM(seq, i),
+                           fill, miss);
+        Py_XDECREF(fill);
+        Py_XDECREF(miss);
+        if (ret < 0) {
+            goto fail;
+        }
+    }
+
+    if (usecols != NULL && usecols != Py_None) {
+        if (PySequence_Size(usecols) != tp.ncols) {
+            if (!PyErr_Occurred()) {
+                PyErr_SetString(PyExc_ValueError,
+                        "usecols and dtypes must have the same length");
+            }
+            goto fail;
+        }
+        tp.usecols = PyMem_Malloc(tp.ncols*sizeof(npy_intp));
+        if (tp.usecols == NULL) {
+            PyErr_NoMemory();
+            goto fail;
+        }
+        for (i = 0; i < tp.ncols; i++) {
+            PyObject *item = PySequence_GetItem(usecols, i);
+
+            if (item == NULL) {
+                goto fail;
+            }
+            tp.usecols[i] = PyArray_PyIntAsIntp(item);
+            Py_DECREF(item);
+            if (error_converting(tp.usecols[i])) {
+                goto fail;
+            }
+        }
+    }
+
+    if (parse_file(&tp, prefix, fh) < 0) {
+        goto fail;
+    }
+    values = finish_columns(&tp, 0);
+    if (values == NULL) {
+        goto fail;
+    }
+    if (missing != NULL && missing != Py_None) {
+        masks = finish_columns(&tp, 1);
+        if (masks == NULL) {
+            goto fail;
+        }
+    }
+    else {
+        Py_INCREF(Py_None);
+        masks = Py_None;
+    }
+    free_parser(&tp);
+    Py_DECREF(seq);
+    return Py_BuildValue("(NN)", values, masks);
+
+fail:
+    Py_XDECREF(values);
+    free_parser(&tp);
+    Py_DECREF(seq);
+    return NULL;
+}
@@ -0,0 +1,8 @@
+#ifndef _NPY_TEXTREADING_H_
+#define _NPY_TEXTREADING_H_
+
+NPY_NO_EXPORT PyObject *
+array__readtext(PyObject *NPY_UNUSED(ignored), PyObject *args,
+                PyObject *kwds);
+
+#endif
@@ -0,0 +1,1165 @@
+/*
+ * Number formatting and buffered text output for savetxt and tofile.
+ *
+ * Array elements are formatted straight from memory into a large output
+ * buffer that is handed to the file whenever it fills up.  The printf
+ * conversions of Python's % operator are reproduced for the numeric
+ * types, and floats can be written with the shortest digits that read
+ * back to the same value: Grisu3 finds those for nearly all values, and
+ * the few it cannot decide go through an exact search on printf output.
+ */
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+#include "structmember.h"
+
+#define _MULTIARRAYMODULE
+#define NPY_NO_PREFIX
+#include "numpy/arrayobject.h"
+#include "numpy/numpy_api.h"
+
+#include "numpy/npy_math.h"
+
+#include "npy_config.h"
+
+#include "npy_3kcompat.h"
+
+#include "common.h"
+#include "numpyos.h"
+#include "textwriting.h"
+
+/* Size of the output buffer handed to the file in one write */
+#define TEXT_BUFSIZE (1 << 16)
+
+/* Longest field body; widths and precisions are limited to fit */
+#define FIELD_MAX 1024
+#define WIDTH_MAX 1000
+#define PREC_MAX 500
+
+
+/*
+ * Shortest digits with Grisu3.
+ *
+ * See Florian Loitsch, "Printing floating-point numbers quickly and
+ * accurately with integers", PLDI 2010.  A value and the boundaries
+ * half way to its neighbours are scaled by a cached power of ten into a
+ * range where the digits can be generated with 64-bit integers; the
+ * digits are correct and shortest unless the imprecision of the scaling
+ * leaves the last digit undecided, which happens for about 0.5% of
+ * doubles.
+ */
+
+typedef struct {
+    npy_uint64 f;
+    int e;
+} diy_fp;
+
+/* 10**k as f*2**e, k = -348, -340, ..., 340, f rounded to 64 bits */
+static const struct {
+    npy_uint64 f;
+    short e;
+    short k;
+} cached_powers[] = {
+    {NPY_ULONGLONG_SUFFIX(0xfa8fd5a0081c0288), -1220, -348},
+    {NPY_ULONGLONG_SUFFIX(0xbaaee17fa23ebf76), -1193, -340},
+    {NPY_ULONGLONG_SUFFIX(0x8b16fb203055ac76), -1166, -332},
+    {NPY_ULONGLONG_SUFFIX(0xcf42894a5dce35ea), -1140, -324},
+    {NPY_ULONGLONG_SUFFIX(0x9a6bb0aa55653b2d), -1113, -316},
+    {NPY_ULONGLONG_SUFFIX(0xe61acf033d1a45df), -1087, -308},
+    {NPY_ULONGLONG_SUFFIX(0xab70fe17c79ac6ca), -1060, -300},
+    {NPY_ULONGLONG_SUFFIX(0xff77b1fcbebcdc4f), -1034, -292},
+    {NPY_ULONGLONG_SUFFIX(0xbe5691ef416bd60c), -1007, -284},
+    {NPY_ULONGLONG_SUFFIX(0x8dd01fad907ffc3c), -980, -276},
+    {NPY_ULONGLONG_SUFFIX(0xd3515c2831559a83), -954, -268},
+    {NPY_ULONGLONG_SUFFIX(0x9d71ac8fada6c9b5), -927, -260},
+    {NPY_ULONGLONG_SUFFIX(0xea9c227723ee8bcb), -901, -252},
+    {NPY_ULONGLONG_SUFFIX(0xaecc49914078536d), -874, -244},
+    {NPY_ULONGLONG_SUFFIX(0x823c12795db6ce57), -847, -236},
+    {NPY_ULONGLONG_SUFFIX(0xc21094364dfb5637), -821, -228},
+    {NPY_ULONGLONG_SUFFIX(0x9096ea6f3848984f), -794, -220},
+    {NPY_ULONGLONG_SUFFIX(0xd77485cb25823ac7), -768, -212},
+    {NPY_ULONGLONG_SUFFIX(0xa086cfcd97bf97f4), -741, -204},
+    {NPY_ULONGLONG_SUFFIX(0xef340a98172aace5), -715, -196},
+    {NPY_ULONGLONG_SUFFIX(0xb23867fb2a35b28e), -688, -188},
+    {NPY_ULONGLONG_SUFFIX(0x84c8d4dfd2c63f3b), -661, -180},
+    {NPY_ULONGLONG_SUFFIX(0xc5dd44271ad3cdba), -635, -172},
+    {NPY_ULONGLONG_SUFFIX(0x936b9fcebb25c996), -608, -164},
+    {NPY_ULONGLONG_SUFFIX(0xdbac6c247d62a584), -582, -156},
+    {NPY_ULONGLONG_SUFFIX(0xa3ab66580d5fdaf6), -555, -148},
+    {NPY_ULONGLONG_SUFFIX(0xf3e2f893dec3f126), -529, -140},
+    {NPY_ULONGLONG_SUFFIX(0xb5b5ada8aaff80b8), -502, -132},
+    {NPY_ULONGLONG_SUFFIX(0x87625f056c7c4a8b), -475, -124},
+    {NPY_ULONGLONG_SUFFIX(0xc9bcff6034c13053), -449, -116},
+    {NPY_ULONGLONG_SUFFIX(0x964e858c91ba2655), -422, -108},
+    {NPY_ULONGLONG_SUFFIX(0xdff9772470297ebd), -396, -100},
+    {NPY_ULONGLONG_SUFFIX(0xa6dfbd9fb8e5b88f), -369, -92},
+    {NPY_ULONGLONG_SUFFIX(0xf8a95fcf88747d94), -343, -84},
+    {NPY_ULONGLONG_SUFFIX(0xb94470938fa89bcf), -316, -76},
+    {NPY_ULONGLONG_SUFFIX(0x8a08f0f8bf0f156b), -289, -68},
+    {NPY_ULONGLONG_SUFFIX(0xcdb02555653131b6), -263, -60},
+    {NPY_ULONGLONG_SUFFIX(0x993fe2c6d07b7fac), -236, -52},
+    {NPY_ULONGLONG_SUFFIX(0xe45c10c42a2b3b06), -210, -44},
+    {NPY_ULONGLONG_SUFFIX(0xaa242499697392d3), -183, -36},
+    {NPY_ULONGLONG_SUFFIX(0xfd87b5f28300ca0e), -157, -28},
+    {NPY_ULONGLONG_SUFFIX(0xbce5086492111aeb), -130, -20},
+    {NPY_ULONGLONG_SUFFIX(0x8cbccc096f5088cc), -103, -12},
+    {NPY_ULONGLONG_SUFFIX(0xd1b71758e219652c), -77, -4},
+    {NPY_ULONGLONG_SUFFIX(0x9c40000000000000), -50, 4},
+    {NPY_ULONGLONG_SUFFIX(0xe8d4a51000000000), -24, 12},
+    {NPY_ULONGLONG_SUFFIX(0xad78ebc5ac620000), 3, 20},
+    {NPY_ULONGLONG_SUFFIX(0x813f3978f8940984), 30, 28},
+    {NPY_ULONGLONG_SUFFIX(0xc097ce7bc90715b3), 56, 36},
+    {NPY_ULONGLONG_SUFFIX(0x8f7e32ce7bea5c70), 83, 44},
+    {NPY_ULONGLONG_SUFFIX(0xd5d238a4abe98068), 109, 52},
+    {NPY_ULONGLONG_SUFFIX(0x9f4f2726179a2245), 136, 60},
+    {NPY_ULONGLONG_SUFFIX(0xed63a231d4c4fb27), 162, 68},
+    {NPY_ULONGLONG_SUFFIX(0xb0de65388cc8ada8), 189, 76},
+    {NPY_ULONGLONG_SUFFIX(0x83c7088e1aab65db), 216, 84},
+    {NPY_ULONGLONG_SUFFIX(0xc45d1df942711d9a), 242, 92},
+    {NPY_ULONGLONG_SUFFIX(0x924d692ca61be758), 269, 100},
+    {NPY_ULONGLONG_SUFFIX(0xda01ee641a708dea), 295, 108},
+    {NPY_ULONGLONG_SUFFIX(0xa26da3999aef774a), 322, 116},
+    {NPY_ULONGLONG_SUFFIX(0xf209787bb47d6b85), 348, 124},
+    {NPY_ULONGLONG_SUFFIX(0xb454e4a179dd1877), 375, 132},
+    {NPY_ULONGLONG_SUFFIX(0x865b86925b9bc5c2), 402, 140},
+    {NPY_ULONGLONG_SUFFIX(0xc83553c5c8965d3d), 428, 148},
+    {NPY_ULONGLONG_SUFFIX(0x952ab45cfa97a0b3), 455, 156},
+    {NPY_ULONGLONG_SUFFIX(0xde469fbd99a05fe3), 481, 164},
+    {NPY_ULONGLONG_SUFFIX(0xa59bc234db398c25), 508, 172},
+    {NPY_ULONGLONG_SUFFIX(0xf6c69a72a3989f5c), 534, 180},
+    {NPY_ULONGLONG_SUFFIX(0xb7dcbf5354e9bece), 561, 188},
+    {NPY_ULONGLONG_SUFFIX(0x88fcf317f22241e2), 588, 196},
+    {NPY_ULONGLONG_SUFFIX(0xcc20ce9bd35c78a5), 614, 204},
+    {NPY_ULONGLONG_SUFFIX(0x98165af37b2153df), 641, 212},
+    {NPY_ULONGLONG_SUFFIX(0xe2a0b5dc971f303a), 667, 220},
+    {NPY_ULONGLONG_SUFFIX(0xa8d9d1535ce3b396), 694, 228},
+    {NPY_ULONGLONG_SUFFIX(0xfb9b7cd9a4a7443c), 720, 236},
+    {NPY_ULONGLONG_SUFFIX(0xbb764c4ca7a44410), 747, 244},
+    {NPY_ULONGLONG_SUFFIX(0x8bab8eefb6409c1a), 774, 252},
+    {NPY_ULONGLONG_SUFFIX(0xd01fef10a657842c), 800, 260},
+    {NPY_ULONGLONG_SUFFIX(0x9b10a4e5e9913129), 827, 268},
+    {NPY_ULONGLONG_SUFFIX(0xe7109bfba19c0c9d), 853, 276},
+    {NPY_ULONGLONG_SUFFIX(0xac2820d9623bf429), 880, 284},
+    {NPY_ULONGLONG_SUFFIX(0x80444b5e7aa7cf85), 907, 292},
+    {NPY_ULONGLONG_SUFFIX(0xbf21e44003acdd2d), 933, 300},
+    {NPY_ULONGLONG_SUFFIX(0x8e679c2f5e44ff8f), 960, 308},
+    {NPY_ULONGLONG_SUFFIX(0xd433179d9c8cb841), 986, 316},
+    {NPY_ULONGLONG_SUFFIX(0x9e19db92b4e31ba9), 1013, 324},
+    {NPY_ULONGLONG_SUFFIX(0xeb96bf6ebadf77d9), 1039, 332},
+    {NPY_ULONGLONG_SUFFIX(0xaf87023b9bf0ee6b), 1066, 340},
+};
+
+#define CACHED_POWERS_OFFSET 348
+#define CACHED_POWERS_STEP 8
+
+/* Smallest binary exponent of the scaled values, the largest being -32 */
+#define GRISU_MIN_EXP -60
+
+static diy_fp
+diy_fp_mul(diy_fp x, diy_fp y)
+{
+    const npy_uint64 low = 0xffffffffu;
+    npy_uint64 a = x.f >> 32, b = x.f & low;
+    npy_uint64 c = y.f >> 32, d = y.f & low;
+    npy_uint64 ac = a*c, bc = b*c, ad = a*d, bd = b*d;
+    /* the upper 64 bits of the product, rounded */
+    npy_uint64 mid = (bd >> 32) + (ad & low) + (bc & low) + (1u << 31);
+    diy_fp r;
+
+    r.f = ac + (ad >> 32) + (bc >> 32) + (mid >> 32);
+    r.e = x.e + y.e + 64;
+    return r;
+}
+
+static diy_fp
+diy_fp_normalize(diy_fp x)
+{
+    while (!(x.f & (NPY_ULONGLONG_SUFFIX(0xffc) << 52))) {
+        x.f <<= 10;
+        x.e -= 10;
+    }
+    while (!(x.f & (NPY_ULONGLONG_SUFFIX(1) << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+    return x;
+}
+
+/*
+ * Move the last digit of the shortest candidate towards w while that
+ * stays inside the safe interval, then check that the result is the
+ * closest representation beyond doubt.  All quantities are in units of
+ * the current digit position scaled as in digit_gen.
+ */
+static int
+round_weed(char *digits, int n, npy_uint64 distance_too_high_w,
+           npy_uint64 unsafe_interval, npy_uint64 rest, npy_uint64 ten_kappa,
+           npy_uint64 unit)
+{
+    npy_uint64 small_distance = distance_too_high_w - unit;
+    npy_uint64 big_distance = distance_too_high_w + unit;
+
+    while (rest < small_distance && unsafe_interval - rest >= ten_kappa &&
+           (rest + ten_kappa < small_distance ||
+            small_distance - rest >= rest + ten_kappa - small_distance)) {
+        digits[n - 1]--;
+        rest += ten_kappa;
+    }
+    if (rest < big_distance && unsafe_interval - rest >= ten_kappa &&
+            (rest + ten_kappa < big_distance ||
+             big_distance - rest > rest + ten_kappa - big_distance)) {
+        return 0;
+    }
+    return 2*unit <= rest && rest <= unsafe_interval - 4*unit;
+}
+
+/*
+ * Generate the shortest digits of w inside (low, high), which all share
+ * the exponent of w.  The digits times 10**kappa approximate w.
+ */
+static int
+digit_gen(diy_fp low, diy_fp w, diy_fp high, char *digits, int *n,
+          int *kappa)
+{
+    npy_uint64 unit = 1;
+    npy_uint64 too_low = low.f - unit, too_high = high.f + unit;
+    npy_uint64 unsafe_interval = too_high - too_low;
+    int shift = -w.e;
+    npy_uint64 one = NPY_ULONGLONG_SUFFIX(1) << shift;
+    npy_uint32 integrals = (npy_uint32)(too_high >> shift);
+    npy_uint64 fractionals = too_high & (one - 1);
+    npy_uint32 divisor = 1000000000;
+
+    *kappa = 10;
+    while (divisor > integrals) {
+        divisor /= 10;
+        (*kappa)--;
+    }
+    *n = 0;
+    while (*kappa > 0) {
+        npy_uint64 rest;
+
+        digits[(*n)++] = (char)('0' + integrals/divisor);
+        integrals %= divisor;
+        (*kappa)--;
+        rest = ((npy_uint64)integrals << shift) + fractionals;
+        if (rest < unsafe_interval) {
+            return round_weed(digits, *n, too_high - w.f, unsafe_interval,
+                              rest, (npy_uint64)divisor << shift, unit);
+        }
+        divisor /= 10;
+    }
+    for (;;) {
+        fractionals *= 10;
+        unit *= 10;
+        unsafe_interval *= 10;
+        digits[(*n)++] = (char)('0' + (fractionals >> shift));
+        fractionals &= one - 1;
+        (*kappa)--;
+        if (fractionals < unsafe_interval) {
+            return round_weed(digits, *n, (too_high - w.f)*unit,
+                              unsafe_interval, fractionals, one, unit);
+        }
+    }
+}
+
+/*
+ * Shortest digits of f*2**e, where hidden is the implicit leading bit of
+ * the type and denormal the exponent of its subnormals.  On success the
+ * value is 0.digits times 10**decpt.
+ */
+static int
+grisu3(npy_uint64 f, int e, npy_uint64 hidden, int denormal, char *digits,
+       int *n, int *decpt)
+{
+    diy_fp w, plus, minus, c;
+    int k, index, kappa;
+
+    w.f = f;
+    w.e = e;
+    plus.f = (f << 1) + 1;
+    plus.e = e - 1;
+    plus = diy_fp_normalize(plus);
+    /* the lower neighbour is closer when f is a power of two */
+    if (f == hidden && e > denormal) {
+        minus.f = (f << 2) - 1;
+        minus.e = e - 2;
+    }
+    else {
+        minus.f = (f << 1) - 1;
+        minus.e = e - 1;
+    }
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+    w = diy_fp_normalize(w);
+
+    /* a cached 10**-k bringing the exponents into the target range */
+    k = (int)npy_ceil((GRISU_MIN_EXP - (w.e + 64) + 63)*0.30102999566398114);
+    index = (CACHED_POWERS_OFFSET + k - 1)/CACHED_POWERS_STEP + 1;
+    c.f = cached_powers[index].f;
+    c.e = cached_powers[index].e;
+
+    if (!digit_gen(diy_fp_mul(minus, c), diy_fp_mul(w, c),
+                   diy_fp_mul(plus, c), digits, n, &kappa)) {
+        return 0;
+    }
+    *decpt = *n + kappa - cached_powers[index].k;
+    return 1;
+}
+
+/* Format val with prec digits after the point, and check it reads back */
+static int
+exact_roundtrip(double val, int single, int prec, char *buf, size_t n)
+{
+    char format[8];
+    double back;
+
+    PyOS_snprintf(format, sizeof(format), "%%.%de", prec);
+    NumPyOS_ascii_formatd(buf, n, format, val, 0);
+    back = NumPyOS_ascii_strtod(buf, NULL);
+    return single ? (float)back == (float)val : back == val;
+}
+
+/*
+ * Shortest digits by bisecting on the printf precision, for the values
+ * grisu3 leaves undecided.  More digits never stop reading back, and 17
+ * (9 for float32) always do.
+ */
+static void
+shortest_exact(double val, int single, char *digits, int *n, int *decpt)
+{
+    char buf[40], *p;
+    int lo = 0, hi = single ? 8 : 16;
+
+    while (lo < hi) {
+        int mid = (lo + hi)/2;
+
+        if (exact_roundtrip(val, single, mid, buf, sizeof(buf))) {
+            hi = mid;
+        }
+        else {
+            lo = mid + 1;
+        }
+    }
+    exact_roundtrip(val, single, lo, buf, sizeof(buf));
+    *n = 0;
+    for (p = buf; *p != 'e'; p++) {
+        if (*p >= '0' && *p <= '9') {
+            digits[(*n)++] = *p;
+        }
+    }
+    while (*n > 1 && digits[*n - 1] == '0') {
+        (*n)--;
+    }
+    *decpt = atoi(p + 1) + 1;
+}
+
+/*
+ * Write the shortest representation of a finite positive val as repr()
+ * of a Python float does, returning its length.  single selects the
+ * boundaries of float32 instead of double.
+ */
+static int
+format_shortest(char *out, double val, int single)
+{
+    char digits[20];
+    int n, decpt, i, ok;
+    char *p = out;
+
+    if (val == 0) {
+        strcpy(out, "0.0");
+        return 3;
+    }
+    if (single) {
+        union { float f; npy_uint32 u; } b;
+        npy_uint64 f;
+        int e;
+
+        b.f = (float)val;
+        f = b.u & 0x7fffff;
+        e = (b.u >> 23) & 0xff;
+        if (e != 0) {
+            f |= 0x800000;
+            e -= 150;
+        }
+        else {
+            e = -149;
+        }
+        ok = grisu3(f, e, 0x800000, -149, digits, &n, &decpt);
+    }
+    else {
+        union { double d; npy_uint64 u; } b;
+        npy_uint64 f, hidden = NPY_ULONGLONG_SUFFIX(1) << 52;
+        int e;
+
+        b.d = val;
+        f = b.u & (hidden - 1);
+        e = (int)((b.u >> 52) & 0x7ff);
+        if (e != 0) {
+            f |= hidden;
+            e -= 1075;
+        }
+        else {
+            e = -1074;
+        }
+        ok = grisu3(f, e, hidden, -1074, digits, &n, &decpt);
+    }
+    if (!ok) {
+        shortest_exact(val, single, digits, &n, &decpt);
+    }
+
+    if (decpt <= -4 || decpt > 16) {
+        /* d.ddde+XX */
+        int exp = decpt - 1;
+
+        *p++ = digits[0];
+        if (n > 1) {
+            *p++ = '.';
+            memcpy(p, digits + 1, n - 1);
+            p += n - 1;
+        }
+        *p++ = 'e';
+        *p++ = exp < 0 ? '-' : '+';
+        exp = exp < 0 ? -exp : exp;
+        if (exp >= 100) {
+            *p++ = (char)('0' + exp/100);
+        }
+        *p++ = (char)('0' + exp/10 % 10);
+        *p++ = (char)('0' + exp % 10);
+    }
+    else if (decpt <= 0) {
+        /* 0.000ddd */
+        *p++ = '0';
+        *p++ = '.';
+        for (i = decpt; i < 0; i++) {
+            *p++ = '0';
+        }
+        memcpy(p, digits, n);
+        p += n;
+    }
+    else if (decpt >= n) {
+        /* ddd000.0 */
+        memcpy(p, digits, n);
+        p += n;
+        for (i = n; i < decpt; i++) {
+            *p++ = '0';
+        }
+        *p++ = '.';
+        *p++ = '0';
+    }
+    else {
+        memcpy(p, digits, decpt);
+        p += decpt;
+        *p++ = '.';
+        memcpy(p, digits + decpt, n - decpt);
+        p += n - decpt;
+    }
+    return (int)(p - out);
+}
+
+
+/* Integers */
+
+static const char digit_pairs[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233"
+    "34353637383940414243444546474849505152535455565758596061626364656667"
+    "68697071727374757677787980818283848586878889909192939495969798990";
+
+/* Write the digits of v in base ending at end, returning their start */
+static char *
+format_unsigned(char *end, npy_uint64 v, int base, int upper)
+{
+    const char *xdigits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+
+    if (base == 10) {
+        while (v >= 100) {
+            int r = (int)(v % 100);
+
+            v /= 100;
+            end -= 2;
+            end[0] = digit_pairs[2*r];
+            end[1] = digit_pairs[2*r + 1];
+        }
+        if (v >= 10) {
+            end -= 2;
+            end[0] = digit_pairs[2*v];
+            end[1] = digit_pairs[2*v + 1];
+        }
+        else {
+            *--end = (char)('0' + v);
+        }
+        return end;
+    }
+    do {
+        *--end = xdigits[v % base];
+        v /= base;
+    } while (v != 0);
+    return end;
+}
+
+
+/* Conversion specifications */
+
+#define SPEC_LEFT 1
+#define SPEC_PLUS 2
+#define SPEC_SPACE 4
+#define SPEC_ZERO 8
+
+typedef struct {
+    /* literal text written before the value, with %% unescaped */
+    const char *text;
+    Py_ssize_t ntext;
+    int flags;
+    int width;
+    int prec;                   /* -1 when not given */
+    char conv;                  /* 0 for the text after the last value */
+    char cformat[16];           /* printf format of the e, f, g family */
+} text_spec;
+
+/*
+ * Split a % format into one spec per value and a final spec holding the
+ * trailing text, storing the unescaped text in buf (at least n bytes).
+ * Returns the number of values, or -1 for anything the writer does not
+ * reproduce: mapping keys, '*', the '#' flag, %c and very large widths
+ * or precisions.
+ */
+static int
+parse_format(const char *fmt, Py_ssize_t n, char *buf, text_spec *specs,
+             int maxspecs)
+{
+    const char *end = fmt + n;
+    int nspecs = 0;
+    text_spec *sp = specs;
+
+    sp->text = buf;
+    sp->ntext = 0;
+    while (fmt < end) {
+        if (*fmt != '%') {
+            buf[sp->ntext++] = *fmt++;
+            continue;
+        }
+        if (++fmt == end) {
+            return -1;
+        }
+        if (*fmt == '%') {
+            buf[sp->ntext++] = *fmt++;
+            continue;
+        }
+        if (nspecs == maxspecs) {
+            return -1;
+        }
+        sp->flags = 0;
+        sp->width = 0;
+        sp->prec = -1;
+        for (; fmt < end; fmt++) {
+            if (*fmt == '-') {
+                sp->flags |= SPEC_LEFT;
+            }
+            else if (*fmt == '+') {
+                sp->flags |= SPEC_PLUS;
+            }
+            else if (*fmt == ' ') {
+                sp->flags |= SPEC_SPACE;
+            }
+            else if (*fmt == '0') {
+                sp->flags |= SPEC_ZERO;
+            }
+            else {
+                break;
+            }
+        }
+        for (; fmt < end && *fmt >= '0' && *fmt <= '9'; fmt++) {
+            sp->width = 10*sp->width + (*fmt - '0');
+            if (sp->width > WIDTH_MAX) {
+                return -1;
+            }
+        }
+        if (fmt < end && *fmt == '.') {
+            sp->prec = 0;
+            for (fmt++; fmt < end && *fmt >= '0' && *fmt <= '9'; fmt++) {
+                sp->prec = 10*sp->prec + (*fmt - '0');
+                if (sp->prec > PREC_MAX) {
+                    return -1;
+                }
+            }
+        }
+        /* length modifiers are accepted and ignored, as Python does */
+        while (fmt < end && (*fmt == 'h' || *fmt == 'l' || *fmt == 'L')) {
+            fmt++;
+        }
+        if (fmt == end || strchr("diuxXoeEfFgGrs", *fmt) == NULL) {
+            return -1;
+        }
+        sp->conv = *fmt++;
+        if (strchr("eEfFgG", sp->conv) != NULL) {
+            PyOS_snprintf(sp->cformat, sizeof(sp->cformat), "%%.%d%c",
+                          sp->prec < 0 ? 6 : sp->prec, sp->conv);
+        }
+        buf += sp->ntext;
+        nspecs++;
+        sp++;
+        sp->text = buf;
+        sp->ntext = 0;
+    }
+    sp->conv = 0;
+    return nspecs;
+}
+
+
+/* Element values */
+
+#define KIND_BOOL 0
+#define KIND_INT 1
+#define KIND_UINT 2
+#define KIND_FLOAT 3
+#define KIND_DOUBLE 4
+#define KIND_STRING 5
+
+typedef struct {
+    PyArrayObject *arr;
+    char *data;
+    npy_intp stride;
+    int kind;
+    int type_num;
+    int aligned;                /* elements can be read in place */
+} text_source;
+
+typedef struct {
+    int kind;
+    npy_int64 i;                /* KIND_BOOL and KIND_INT */
+    npy_uint64 u;               /* KIND_UINT */
+    double d;                   /* KIND_FLOAT and KIND_DOUBLE */
+    const char *s;              /* KIND_STRING */
+    Py_ssize_t n;
+} text_value;
+
+/*
+ * Set up a column of arr starting at data, returning 0 if its type is
+ * not handled here.
+ */
+static int
+setup_source(text_source *col, PyArrayObject *arr, char *data,
+             npy_intp stride)
+{
+    int type_num = arr->descr->type_num;
+
+    if (PyTypeNum_ISBOOL(type_num)) {
+        col->kind = KIND_BOOL;
+    }
+    else if (PyTypeNum_ISSIGNED(type_num)) {
+        col->kind = KIND_INT;
+    }
+    else if (PyTypeNum_ISUNSIGNED(type_num)) {
+        col->kind = KIND_UINT;
+    }
+    else if (type_num == NPY_FLOAT) {
+        col->kind = KIND_FLOAT;
+    }
+    else if (type_num == NPY_DOUBLE) {
+        col->kind = KIND_DOUBLE;
+    }
+#if !defined(NPY_PY3K)
+    /* on Python 3 %s of a bytes scalar gives its repr */
+    else if (type_num == NPY_STRING) {
+        col->kind = KIND_STRING;
+    }
+#endif
+    else {
+        return 0;
+    }
+    col->arr = arr;
+    col->data = data;
+    col->stride = stride;
+    col->type_num = type_num;
+    col->aligned = PyArray_ISNOTSWAPPED(arr) && PyArray_ISALIGNED(arr);
+    return 1;
+}
+
+/* Whether a conversion applies to the values of a column */
+static int
+spec_accepts(const text_spec *sp, int kind)
+{
+    switch (sp->conv) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o':
+            return kind == KIND_BOOL || kind == KIND_INT || kind == KIND_UINT;
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G':
+            return kind != KIND_STRING;
+        case 'r':
+            return kind != KIND_STRING;
+        case 's':
+            return kind != KIND_FLOAT && kind != KIND_DOUBLE;
+    }
+    return 0;
+}
+
+#define READ_INT(type, field) \
+    v->field = *(type *)p; \
+    break
+
+static void
+read_value(const text_source *col, char *p, text_value *v)
+{
+    union {
+        npy_longlong i;
+        double d;
+        char c[16];
+    } tmp;
+
+    v->kind = col->kind;
+    if (col->kind == KIND_STRING) {
+        /* trailing NULs are dropped, as in the string scalar */
+        v->s = p;
+        v->n = col->arr->descr->elsize;
+        while (v->n > 0 && p[v->n - 1] == '\0') {
+            v->n--;
+        }
+        return;
+    }
+    if (!col->aligned) {
+        col->arr->descr->f->copyswap(&tmp, p,
+                                     !PyArray_ISNOTSWAPPED(col->arr),
+                                     col->arr);
+        p = tmp.c;
+    }
+    switch (col->type_num) {
+        case NPY_BOOL:
+            v->i = *(npy_bool *)p != 0;
+            break;
+        case NPY_BYTE:
+            READ_INT(npy_byte, i);
+        case NPY_SHORT:
+            READ_INT(npy_short, i);
+        case NPY_INT:
+            READ_INT(npy_int, i);
+        case NPY_LONG:
+            READ_INT(npy_long, i);
+        case NPY_LONGLONG:
+            READ_INT(npy_longlong, i);
+        case NPY_UBYTE:
+            READ_INT(npy_ubyte, u);
+        case NPY_USHORT:
+            READ_INT(npy_ushort, u);
+        case NPY_UINT:
+            READ_INT(npy_uint, u);
+        case NPY_ULONG:
+            READ_INT(npy_ulong, u);
+        case NPY_ULONGLONG:
+            READ_INT(npy_ulonglong, u);
+        case NPY_FLOAT:
+            READ_INT(npy_float, d);
+        case NPY_DOUBLE:
+            READ_INT(npy_double, d);
+    }
+}
+
+#undef READ_INT
+
+
+/* Buffered output */
+
+typedef struct {
+    char *buf;
+    Py_ssize_t len;
+    PyObject *write;            /* write method of a file object, or NULL */
+    FILE *fp;                   /* stream used when write is NULL */
+} text_writer;
+
+/*
+ * Hand the buffer to the file.  Writing to a stream needs no GIL, and a
+ * failed fwrite is left to the caller to report.
+ */
+static int
+writer_flush(text_writer *w)
+{
+    Py_ssize_t n = w->len;
+
+    w->len = 0;
+    if (n == 0) {
+        return 0;
+    }
+    if (w->write == NULL) {
+        return fwrite(w->buf, 1, n, w->fp) < (size_t)n ? -1 : 0;
+    }
+    else {
+        PyObject *bytes, *ret;
+
+        bytes = PyBytes_FromStringAndSize(w->buf, n);
+        if (bytes == NULL) {
+            return -1;
+        }
+        ret = PyObject_CallFunctionObjArgs(w->write, bytes, NULL);
+        Py_DECREF(bytes);
+        if (ret == NULL) {
+            return -1;
+        }
+        Py_DECREF(ret);
+        return 0;
+    }
+}
+
+/* Make room for n more bytes, n being at most TEXT_BUFSIZE */
+#define WRITER_RESERVE(w, n) \
+    (((w)->len + (n) > TEXT_BUFSIZE) ? writer_flush(w) : 0)
+
+static int
+writer_put(text_writer *w, const char *s, Py_ssize_t n)
+{
+    while (n > 0) {
+        Py_ssize_t m = TEXT_BUFSIZE - w->len;
+
+        if (m == 0) {
+            if (writer_flush(w) < 0) {
+                return -1;
+            }
+            m = TEXT_BUFSIZE;
+        }
+        if (m > n) {
+            m = n;
+        }
+        memcpy(w->buf + w->len, s, m);
+        w->len += m;
+        s += m;
+        n -= m;
+    }
+    return 0;
+}
+
+/*
+ * Format a value with a spec into the writer, padding it to the width.
+ * Signs and zero padding follow Python's % operator: zeros go between
+ * the sign and the digits, also for nan and inf, and %r and %s take
+ * neither.
+ */
+static int
+write_value(text_writer *w, const text_spec *sp, const text_value *v)
+{
+    char tmp[FIELD_MAX];
+    char *body, *end = tmp + sizeof(tmp);
+    Py_ssize_t n, pad;
+    int neg = 0, numeric = 1, zeros;
+    char sign;
+
+    switch (sp->conv) {
+        case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': {
+            npy_uint64 mag;
+
+            if (v->kind == KIND_UINT) {
+                mag = v->u;
+            }
+            else {
+                neg = v->i < 0;
+                mag = neg ? -(npy_uint64)v->i : (npy_uint64)v->i;
+            }
+            body = format_unsigned(end, mag,
+                                   sp->conv == 'o' ? 8 :
+                                   (sp->conv == 'x' || sp->conv == 'X') ?
+                                   16 : 10, sp->conv == 'X');
+            while (end - body < sp->prec) {
+                *--body = '0';
+            }
+            n = end - body;
+            break;
+        }
+        case 'e': case 'E': case 'f': case 'F': case 'g': case 'G': {
+            double d = v->kind == KIND_INT ? (double)v->i :
+                       v->kind == KIND_UINT ? (double)v->u :
+                       v->kind == KIND_BOOL ? (double)v->i : v->d;
+            int upper = sp->conv < 'a';
+
+            body = tmp;
+            if (npy_isnan(d)) {
+                strcpy(tmp, upper ? "NAN" : "nan");
+            }
+            else {
+                neg = npy_signbit(d) != 0;
+                d = neg ? -d : d;
+                if (npy_isinf(d)) {
+                    strcpy(tmp, upper ? "INF" : "inf");
+                }
+                else {
+                    NumPyOS_ascii_formatd(tmp, sizeof(tmp), sp->cformat,
+                                          d, 0);
+                }
+            }
+            n = strlen(tmp);
+            break;
+        }
+        default:
+            /* %r and %s */
+            numeric = 0;
+            body = tmp;
+            if (v->kind == KIND_BOOL) {
+                strcpy(tmp, v->i ? "True" : "False");
+                n = strlen(tmp);
+            }
+            else if (v->kind == KIND_STRING) {
+                body = (char *)v->s;
+                n = v->n;
+            }
+            else if (v->kind == KIND_FLOAT || v->kind == KIND_DOUBLE) {
+                if (npy_isnan(v->d)) {
+                    strcpy(tmp, "nan");
+                    n = 3;
+                }
+                else if (npy_isinf(v->d)) {
+                    strcpy(tmp, v->d < 0 ? "-inf" : "inf");
+                    n = strlen(tmp);
+                }
+                else {
+                    n = 0;
+                    if (npy_signbit(v->d)) {
+                        tmp[n++] = '-';
+                    }
+                    n += format_shortest(tmp + n, v->d < 0 ? -v->d : v->d,
+                                         v->kind == KIND_FLOAT);
+                }
+            }
+            else {
+                body = format_unsigned(end, v->kind == KIND_UINT ? v->u :
+                                       v->i < 0 ? -(npy_uint64)v->i :
+                                       (npy_uint64)v->i, 10, 0);
+                if (v->kind == KIND_INT && v->i < 0) {
+                    *--body = '-';
+                }
+                n = end - body;
+            }
+            if (sp->prec >= 0 && n > sp->prec) {
+                n = sp->prec;
+            }
+            break;
+    }
+
+    sign = neg ? '-' : !numeric ? 0 :
+           (sp->flags & SPEC_PLUS) ? '+' :
+           (sp->flags & SPEC_SPACE) ? ' ' : 0;
+    pad = sp->width - n - (sign != 0);
+    if (WRITER_RESERVE(w, FIELD_MAX + WIDTH_MAX + 1) < 0) {
+        return -1;
+    }
+    zeros = numeric && (sp->flags & SPEC_ZERO);
+    if (pad > 0 && !(sp->flags & SPEC_LEFT) && !zeros) {
+        memset(w->buf + w->len, ' ', pad);
+        w->len += pad;
+    }
+    if (sign != 0) {
+        w->buf[w->len++] = sign;
+    }
+    if (pad > 0 && !(sp->flags & SPEC_LEFT) && zeros) {
+        memset(w->buf + w->len, '0', pad);
+        w->len += pad;
+    }
+    if (n > FIELD_MAX) {
+        /* long strings */
+        if (writer_put(w, body, n) < 0) {
+            return -1;
+        }
+    }
+    else {
+        memcpy(w->buf + w->len, body, n);
+        w->len += n;
+    }
+    if (pad > 0 && (sp->flags & SPEC_LEFT)) {
+        if (WRITER_RESERVE(w, pad) < 0) {
+            return -1;
+        }
+        memset(w->buf + w->len, ' ', pad);
+        w->len += pad;
+    }
+    return 0;
+}
+
+
+/*
+ * Write the elements of self in C order to fp, separated by sep and
+ * formatted with format, or with their shortest representation when it
+ * is empty.  Returns 0 when self's type or the format are not handled
+ * here and nothing was written, 1 when done and -1 on error.
+ */
+NPY_NO_EXPORT int
+write_text_file(PyArrayObject *self, FILE *fp, const char *sep,
+                const char *format)
+{
+    text_writer w;
+    text_source col;
+    text_spec specs[2];
+    text_value v;
+    NpyArrayIterObject *it = NULL;
+    Py_ssize_t nsep = strlen(sep), nformat = strlen(format);
+    char *text = NULL;
+    int ret = 1;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!setup_source(&col, self, NULL, 0)) {
+        return 0;
+    }
+    memset(&w, 0, sizeof(w));
+    w.fp = fp;
+    if (nformat == 0) {
+        /* the default is str() of the element, but without losing digits */
+        memset(specs, 0, sizeof(specs));
+        specs[0].text = specs[1].text = "";
+        specs[0].prec = -1;
+        specs[0].conv = col.kind == KIND_STRING ? 's' : 'r';
+    }
+    else {
+        text = PyMem_Malloc(nformat);
+        if (text == NULL) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        if (parse_format(format, nformat, text, specs, 1) != 1 ||
+                !spec_accepts(&specs[0], col.kind)) {
+            PyMem_Free(text);
+            return 0;
+        }
+    }
+    w.buf = PyMem_Malloc(TEXT_BUFSIZE);
+    if (w.buf == NULL) {
+        PyErr_NoMemory();
+        ret = -1;
+        goto finish;
+    }
+    it = NpyArray_IterNew(self);
+    if (it == NULL) {
+        ret = -1;
+        goto finish;
+    }
+
+    NPY_BEGIN_THREADS;
+    while (it->index < it->size) {
+        read_value(&col, it->dataptr, &v);
+        if (writer_put(&w, specs[0].text, specs[0].ntext) < 0 ||
+                write_value(&w, &specs[0], &v) < 0 ||
+                writer_put(&w, specs[1].text, specs[1].ntext) < 0 ||
+                (it->index != it->size - 1 &&
+                 writer_put(&w, sep, nsep) < 0)) {
+            ret = -1;
+            break;
+        }
+        NpyArray_ITER_NEXT(it);
+    }
+    if (ret == 1 && writer_flush(&w) < 0) {
+        ret = -1;
+    }
+    NPY_END_THREADS;
+    if (ret < 0) {
+        PyErr_SetString(PyExc_IOError, "problem writing to file");
+    }
+
+ finish:
+    if (it != NULL) {
+        _Npy_DECREF(it);
+    }
+    PyMem_Free(w.buf);
+    PyMem_Free(text);
+    return ret;
+}
+
+/*
+ * _writetext(fh, columns, format)
+ *
+ * Write the rows of the equally long 1-d arrays in `columns` to the file
+ * object `fh`, each row formatted as `format` % row, `format` being a
+ * byte string with one conversion per column.  The text is passed to
+ * fh.write in large blocks.
+ *
+ * The numeric types, and byte strings on Python 2, are formatted like
+ * the % operator does, except that %r writes floats with the shortest
+ * digits that read back to the same value.  Returns False without
+ * writing anything when a conversion or a column type is not handled.
+ */
+NPY_NO_EXPORT PyObject *
+array__writetext(PyObject *NPY_UNUSED(ignored), PyObject *args,
+                 PyObject *kwds)
+{
+    static char *kwlist[] = {"fh", "columns", "format", NULL};
+    PyObject *fh, *columns, *seq = NULL, *ret = NULL;
+    char *format, *text = NULL;
+    Py_ssize_t nformat, ncols, i;
+    text_writer w;
+    text_source *cols = NULL;
+    text_spec *specs = NULL;
+    npy_intp nrows = 0, r;
+
+    memset(&w, 0, sizeof(w));
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOs#", kwlist,
+                &fh, &columns, &format, &nformat)) {
+        return NULL;
+    }
+    seq = PySequence_Fast(columns, "columns must be a sequence");
+    if (seq == NULL) {
+        return NULL;
+    }
+    ncols = PySequence_Fast_GET_SIZE(seq);
+    cols = PyMem_Malloc((ncols + 1)*sizeof(text_source));
+    specs = PyMem_Malloc((ncols + 1)*sizeof(text_spec));
+    text = PyMem_Malloc(nformat + 1);
+    if (cols == NULL || specs == NULL || text == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+    if (ncols == 0 ||
+            parse_format(format, nformat, text, specs, (int)ncols) != ncols) {
+        goto not_handled;
+    }
+    for (i = 0; i < ncols; i++) {
+        PyArrayObject *arr;
+
+        arr = (PyArrayObject *)PySequence_Fast_GET_ITEM(seq, i);
+        if (!PyArray_Check(arr) || arr->nd != 1) {
+            goto not_handled;
+        }
+        if (i > 0 && arr->dimensions[0] != nrows) {
+            PyErr_SetString(PyExc_ValueError,
+                    "columns must have the same length");
+            goto finish;
+        }
+        nrows = arr->dimensions[0];
+        if (!setup_source(&cols[i], arr, arr->data, arr->strides[0]) ||
+                !spec_accepts(&specs[i], cols[i].kind)) {
+            goto not_handled;
+        }
+    }
+
+    w.write = PyObject_GetAttrString(fh, "write");
+    w.buf = PyMem_Malloc(TEXT_BUFSIZE);
+    if (w.write == NULL) {
+        goto finish;
+    }
+    if (w.buf == NULL) {
+        PyErr_NoMemory();
+        goto finish;
+    }
+    for (r = 0; r < nrows; r++) {
+        for (i = 0; i < ncols; i++) {
+            text_value v;
+
+            read_value(&cols[i], cols[i].data + r*cols[i].stride, &v);
+            if (writer_put(&w, specs[i].text, specs[i].ntext) < 0 ||
+                    write_value(&w, &specs[i], &v) < 0) {
+                goto finish;
+            }
+        }
+        if (writer_put(&w, specs[ncols].text, specs[ncols].ntext) < 0) {
+            goto finish;
+        }
+    }
+    if (writer_flush(&w) < 0) {
+        goto finish;
+    }
+    ret = Py_True;
+    Py_INCREF(ret);
+    goto finish;
+
+ not_handled:
+    ret = Py_False;
+    Py_INCREF(ret);
+
+ finish:
+    Py_XDECREF(w.write);
+    PyMem_Free(w.buf);
+    PyMem_Free(text);
+    PyMem_Free(specs);
+    PyMem_Free(cols);
+    Py_DECREF(seq);
+    return ret;
+}
@@ -0,0 +1,12 @@
+#ifndef _NPY_TEXTWRITING_H_
+#define _NPY_TEXTWRITING_H_
+
+NPY_NO_EXPORT int
+write_text_file(PyArrayObject *self, FILE *fp, const char *sep,
+                const char *format);
+
+NPY_NO_EXPORT PyObject *
+array__writetext(PyObject *NPY_UNUSED(ignored), PyObject *args,
+                 PyObject *kwds);
+
+#endif
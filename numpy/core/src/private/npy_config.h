@@ -14,6 +14,23 @@
 #undef HAVE_ATAN2
 #endif
 
+/*
+ * Storage class for the little per-call state the core keeps outside its
+ * arguments (e.g. the array a qsort comparison reads), so that calls from
+ * different threads do not share it.  Compilers without thread-local
+ * storage fall back to plain statics, which are only safe under the GIL.
+ *
+ * MSVC gets the fallback too: __declspec(thread) data in a DLL loaded with
+ * LoadLibrary, as extension modules are, is not allocated before Vista.
+ */
+#if defined(_MSC_VER)
+    #define NPY_TLS
+#elif defined(__GNUC__) || defined(__SUNPRO_C) || defined(__INTEL_COMPILER)
+    #define NPY_TLS __thread
+#else
+    #define NPY_TLS
+#endif
+
 /* 
  * On Mac OS X, because there is only one configuration stage for all the archs
  * in universal builds, any macro which depends on the arch needs to be
@@ -44,6 +44,11 @@
 
 #define USE_USE_DEFAULTS 1
 
+#if NPY_TRACE
+/* Set to multiarray's _TRACE_STATE when the module is initialized */
+NpyTrace_State *npy_trace_state = NULL;
+#endif
+
 /* ---------------------------------------------------------------- */
 
 static int
@@ -2033,7 +2038,10 @@ PyUFunc_GenericFunction(PyUFuncObject *self, PyObject *args, PyObject *kwds,
     PyUFuncLoopObject *loop;
     int i;
     NPY_BEGIN_THREADS_DEF;
+    NPY_TRACE_DEF;
 
+    NPY_TRACE_BEGIN("PyUFunc_GenericFunction");
+    NPY_TRACE_DETAIL(self->name);
     if (!(loop = construct_loop(self, args, kwds, mps))) {
         return -1;
     }
@@ -2342,7 +2350,33 @@ PyUFunc_GenericFunction(PyUFuncObject *self, PyObject *args, PyObject *kwds,
     }
 
     NPY_LOOP_END_THREADS;
+#if NPY_TRACE
+    if (_npy_tracing) {
+        intp nread = 0, nwritten = 0;
+
+        for (i = 0; i < self->nargs; i++) {
+            if (i < self->nin) {
+                nread += PyArray_NBYTES(mps[i]);
+            }
+            else {
+                nwritten += PyArray_NBYTES(mps[i]);
+            }
+            if (loop->meth == BUFFER_UFUNCLOOP && loop->cast[i]) {
+                NPY_TRACE_PATH(NPY_TRACE_CASTING);
+            }
+        }
+        NPY_TRACE_ITEMS(self->nout > 0 ? PyArray_SIZE(mps[self->nin]) : 0,
+                        nread, nwritten);
+        if (loop->meth == BUFFER_UFUNCLOOP) {
+            NPY_TRACE_PATH(NPY_TRACE_BUFFERED);
+        }
+        else if (loop->meth != ONE_UFUNCLOOP) {
+            NPY_TRACE_PATH(NPY_TRACE_STRIDED);
+        }
+    }
+#endif
     ufuncloop_dealloc(loop);
+    NPY_TRACE_END;
     return 0;
 
 fail:
@@ -2713,7 +2747,10 @@ PyUFunc_Reduce(PyUFuncObject *self, PyArrayObject *arr, PyArrayObject *out,
     intp i, n;
     char *dptr;
     NPY_BEGIN_THREADS_DEF;
+    NPY_TRACE_DEF;
 
+    NPY_TRACE_BEGIN("PyUFunc_Reduce");
+    NPY_TRACE_DETAIL(self->name);
     /* Construct loop object */
     loop = construct_reduce(self, &arr, out, axis, otype, UFUNC_REDUCE, 0,
             "reduce");
@@ -2851,7 +2888,19 @@ PyUFunc_Reduce(PyUFuncObject *self, PyArrayObject *arr, PyArrayObject *out,
         ret = loop->ret;
     }
     Py_INCREF(ret);
+    NPY_TRACE_ITEMS(PyArray_SIZE(arr), PyArray_NBYTES(arr),
+                    PyArray_NBYTES(loop->ret));
+    if (loop->meth == BUFFER_UFUNCLOOP) {
+        NPY_TRACE_PATH(NPY_TRACE_BUFFERED);
+    }
+    else if (!PyArray_ISCONTIGUOUS(arr)) {
+        NPY_TRACE_PATH(NPY_TRACE_STRIDED);
+    }
+    if (loop->cast) {
+        NPY_TRACE_PATH(NPY_TRACE_CASTING);
+    }
     ufuncreduce_dealloc(loop);
+    NPY_TRACE_END;
     return (PyObject *)ret;
 
 fail:
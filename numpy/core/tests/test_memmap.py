@@ -90,5 +90,23 @@ class TestMemmap(TestCase):
         finally:
             memmap._close = _close
 
+    def test_access(self):
+        fp = memmap(self.tmpfp, dtype=self.dtype, mode='w+',
+                    shape=self.shape)
+        fp[:] = self.data[:]
+        fp.flush()
+        for access in [None, 'normal', 'sequential', 'random', 'willneed']:
+            fp = memmap(self.tmpfp, dtype=self.dtype, mode='r',
+                        shape=self.shape, access=access)
+            self.assertEquals(fp.access, access)
+            assert_array_equal(fp, self.data)
+            self.assertEquals(fp[1:].access, access)
+        # hints on views, including negative strides and empty slices
+        for view in [fp[1:, ::2], fp[::-1, ::-2], fp[:0], fp[2:, 3]]:
+            assert_(view.advise('willneed') in [True, False])
+        assert_raises(ValueError, memmap, self.tmpfp, dtype=self.dtype,
+                      mode='r', access='backwards')
+        assert_raises(ValueError, fp.advise, 'backwards')
+
 if __name__ == "__main__":
     run_module_suite()
@@ -5,6 +5,7 @@ import numpy as np
 from numpy.testing import *
 from numpy.core import *
 from numpy.core.multiarray_tests import test_neighborhood_iterator, test_neighborhood_iterator_oob
+from numpy.core.multiarray_tests import test_trace_events
 
 from numpy.compat import asbytes, getexception, strchar
 
@@ -422,6 +423,45 @@ class TestMethods(TestCase):
         assert_equal(r, np.array([('a', 1), ('c', 3), ('b', 255), ('d', 258)],
                                  dtype=mydtype))
 
+    def test_sort_threads(self):
+        # the generic sorts keep the array being sorted per thread; the
+        # comparisons below give up the GIL in the middle of each sort
+        import threading
+        import time
+        class Slow(object):
+            def __init__(self, v):
+                self.v = v
+            def __lt__(self, other):
+                time.sleep(0)
+                return self.v < other.v
+            def __cmp__(self, other):
+                time.sleep(0)
+                return cmp(self.v, other.v)
+        errors = []
+        def work(k):
+            try:
+                for i in range(5):
+                    a = np.array([Slow(v) for v in range(50)[::-1]])
+                    r = np.array([(v % 7, v) for v in range(50)[::-1]],
+                                 dtype=[('a', 'i%d' % (k % 2 * 4 + 4)),
+                                        ('b', 'f8')])
+                    ia = a.argsort()
+                    a.sort()
+                    r.sort()
+                    assert_equal([x.v for x in a], range(50))
+                    assert_equal(ia, range(50)[::-1])
+                    assert_equal(r['b'], sorted(r['b'], key=lambda b:
+                                                (int(b) % 7, b)))
+            except Exception, e:
+                errors.append(e)
+        threads = [threading.Thread(target=work, args=(k,))
+                   for k in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        assert_equal(errors, [])
+
     def test_argsort(self):
         # all c scalar argsorts use the same code with different types
         # so it suffices to run a quick check with one type. The number
@@ -919,6 +959,56 @@ class TestIO(object):
         y = np.fromfile(self.filename, dtype=self.dtype)
         assert_array_equal(y, self.x.flat)
 
+    def test_roundtrip_text_file(self):
+        # without a format, floats are written with round-trip precision
+        x = self.x.real.ravel()
+        x.tofile(self.filename, sep=',')
+        y = np.fromfile(self.filename, sep=',')
+        assert_array_equal(x, y)
+
+        x = np.array([0.1, -2.5e-300, 1e22, 3], np.float32)
+        x.tofile(self.filename, sep=' ')
+        f = open(self.filename, 'rb')
+        assert_equal(f.read(), asbytes('0.1 -0.0 1e+22 3.0'))
+        f.close()
+
+        x = np.array([[1, -2], [300, 4]], np.int16)
+        x.tofile(self.filename, sep='\n', format='%03d')
+        y = np.fromfile(self.filename, dtype=np.int16, sep='\n')
+        assert_array_equal(x.ravel(), y)
+
+    def test_roundtrip_strided(self):
+        # views are gathered into a buffer before writing
+        a = np.arange(200*3000, dtype=np.int32).reshape(200, 3000)
+        aligned = np.zeros(4, np.dtype([('a', 'i1'), ('b', '>f8')], align=True))
+        for x in [a.T, a[::3, 1::7], a[:, ::-1].astype('>i2'), aligned[::2]]:
+            x.tofile(self.filename)
+            y = np.fromfile(self.filename, dtype=x.dtype)
+            assert_array_equal(y, x.ravel())
+            f = open(self.filename, 'rb')
+            assert_equal(f.read(), x.tostring())
+            f.close()
+
+    def test_tofile_byteorder(self):
+        a = np.arange(40*30, dtype='<f8').reshape(40, 30)
+        for x in [a, a.T, a[::2, 3::5]]:
+            for order in ['>', 'big', 's']:
+                x.tofile(self.filename, byteorder=order)
+                y = np.fromfile(self.filename, dtype='>f8')
+                assert_array_equal(y, x.ravel())
+            x.tofile(self.filename, byteorder='<')
+            y = np.fromfile(self.filename, dtype='<f8')
+            assert_array_equal(y, x.ravel())
+
+        # records have no byte order of their own; 'S' swaps each field
+        rec = np.zeros(6, [('a', '<i4'), ('b', '<f8')])
+        rec['a'] = np.arange(6)
+        rec['b'] = 0.5
+        rec[::2].tofile(self.filename, byteorder='S')
+        y = np.fromfile(self.filename, dtype=[('a', '>i4'), ('b', '>f8')])
+        assert_array_equal(y['a'], rec['a'][::2])
+        assert_array_equal(y['b'], rec['b'][::2])
+
     def test_roundtrip_binary_str(self):
         s = self.x.tostring()
         y = np.fromstring(s, dtype=self.dtype)
@@ -990,6 +1080,29 @@ class TestIO(object):
         self._check_from('1 , 2 , 3 , 4', [1.,2.,3.,4.], sep=',')
         self._check_from('1,2,3,4', [1.,2.,3.,4.], dtype=float, sep=',')
 
+    def test_large_text(self):
+        # spans several read blocks and output reallocations
+        x = np.arange(-150000, 150000)
+        self._check_from(','.join(map(str, x)), x, dtype=int, sep=',')
+        y = x / 7.
+        self._check_from(' \n '.join(map(repr, y)), y, sep=' ')
+        z = np.round(y, 3)
+        self._check_from(';'.join(['%.3f' % v for v in z]), z, sep=';')
+
+    def test_file_position(self):
+        # reading stops right after the last separator that was used
+        f = open(self.filename, 'wb')
+        f.write(asbytes('1, 2 ,3,4 5,6'))
+        f.close()
+        f = open(self.filename, 'rb')
+        assert_array_equal(np.fromfile(f, sep=',', count=2), [1, 2])
+        assert_equal(f.read(), asbytes('3,4 5,6'))
+        f.seek(0)
+        assert_array_equal(np.fromfile(f, dtype=np.int8, sep=','),
+                           [1, 2, 3, 4])
+        assert_equal(f.read(), asbytes('5,6'))
+        f.close()
+
     def test_malformed(self):
         self._check_from('1.234 1,234', [1.234, 1.], sep=' ')
 
@@ -1139,6 +1252,38 @@ class TestView(TestCase):
         assert_array_equal(y, z)
         assert_array_equal(y, [67305985, 134678021])
 
+class TestTransposedCopy(TestCase):
+    # Copies between layouts that are fastest along different axes are
+    # done in tiles; compare with an element-by-element reference.
+    def _reference(self, a):
+        return np.array(a.tolist(), dtype=a.dtype)
+
+    def test_2d(self):
+        for dt in ['i1', 'i2', 'f4', 'f8', 'c16', 'S3', 'O']:
+            for shape in [(31, 33), (64, 100), (129, 65)]:
+                a = np.arange(np.prod(shape)).reshape(shape).astype(dt)
+                for t in [a.T, a[::-1].T, a[:, ::2].T]:
+                    c = np.ascontiguousarray(t)
+                    assert_array_equal(c, self._reference(t))
+                    assert_array_equal(t.flatten(), c.ravel())
+                    assert_array_equal(t.flatten('F'),
+                                       np.asfortranarray(t).T.ravel())
+
+    def test_nd(self):
+        a = np.arange(3*40*50*2, dtype=float).reshape(3, 40, 50, 2)
+        for axes in [(0, 2, 1, 3), (3, 2, 1, 0), (1, 3, 2, 0)]:
+            t = a.transpose(axes)
+            assert_array_equal(t.copy(), self._reference(t))
+            assert_array_equal(t.flatten(), self._reference(t).ravel())
+        b = np.empty((50, 40), order='F')
+        b[...] = a[1, :, :, 0].T
+        assert_array_equal(b, a[1, :, :, 0].T)
+
+    def test_fastCopyAndTranspose(self):
+        a = np.arange(70*45, dtype=np.int32).reshape(70, 45)
+        assert_array_equal(np.fastCopyAndTranspose(a), a.T)
+        assert_array_equal(np.fastCopyAndTranspose(a[:20]), a[:20].T)
+
 class TestStats(TestCase):
     def test_subclass(self):
         class TestArray(np.ndarray):
@@ -1476,6 +1621,25 @@ class TestStackedNeighborhoodIter(TestCase):
                 [-1, 2], NEIGH_MODE['circular'])
         assert_array_equal(l, r)
 
+class TestTrace(TestCase):
+    @dec.skipif(not hasattr(np.core.multiarray, '_TRACE_STATE'),
+                "numpy was built without NPY_TRACE")
+    def test_sort_and_ufunc(self):
+        a = np.arange(100, 0, -1).astype(np.float64)
+        b = np.ones(100)
+        out = np.empty(100)
+        def run():
+            a.sort()
+            np.add(a, b, out)
+            a[::2].sort()
+        events = [e for e in test_trace_events(run)
+                  if e[0] in ['NpyArray_Sort', 'PyUFunc_GenericFunction']]
+        assert_equal(events,
+                     [('NpyArray_Sort', None, 100, 800, 800, 0),
+                      ('PyUFunc_GenericFunction', 'add', 100, 1600, 800, 0),
+                      ('NpyArray_Sort', None, 50, 400, 400, 5)])
+        assert_equal(test_trace_events(lambda: None), [])
+
 class TestWarnings(object):
     def test_complex_warning(self):
         import warnings
@@ -1728,5 +1892,33 @@ if sys.version_info >= (2, 6):
                 x = np.array([(1,),(2,)], dtype={'f0': (int, j)})
                 self._check_roundtrip(x)
 
+        def test_roundtrip_simple_types(self):
+            # single-item formats are parsed without going through Python
+            for t in '?bBhHiIlLqQfdgFDGO':
+                self._check_roundtrip(np.ones(3, dtype=t))
+            for t in ['S1', 'S10', 'U1', 'U3', '>U3', '<U3', '>f8', '<f8',
+                      '>c8', '<i2', '>u4', '=i8']:
+                self._check_roundtrip(np.ones(3, dtype=t))
+
+        def test_export_layout_changes(self):
+            # each export describes the array as it is at the time
+            x = np.arange(12, dtype='i')
+            y1 = memoryview(x)
+            x.shape = (3, 4)
+            y2 = memoryview(x)
+            x.shape = (12,)
+            y3 = memoryview(x)
+            x.dtype = 'f'
+            y4 = memoryview(x)
+            assert_equal(y1.shape, (12,))
+            assert_equal(y2.shape, (3, 4))
+            assert_equal(y3.shape, (12,))
+            assert_equal(y1.format, 'i')
+            assert_equal(y4.format, 'f')
+            # unaligned data is exported in standard sizes
+            z = np.zeros(9, dtype=np.uint8)[1:].view('i')
+            assert_equal(memoryview(z).format, '=i')
+            assert_equal(memoryview(np.zeros(2, dtype='i')).format, 'i')
+
 if __name__ == "__main__":
     run_module_suite()
@@ -8,7 +8,14 @@ Algorithmically based on Fortran-77 FFTPACK by Paul N. Swarztrauber (Version 4,
 
 #include <math.h>
 #include <stdio.h>
+#include <stddef.h>
+/* only FFT_BLOCK is taken from the header, whose Treal is always double */
+#define FFTPACK_NO_PROTOTYPES
+#include "fftpack.h"
+/* fftpack_float.c defines FFTPACK_SINGLE to build the float routines */
+#ifndef FFTPACK_SINGLE
 #define DOUBLE
+#endif
 
 #ifdef DOUBLE
 #define Treal double
@@ -801,9 +808,10 @@ static void radb5(int ido, int l1, const Treal cc[], Treal ch[],
 static void radfg(int ido, int ip, int l1, int idl1,
       Treal cc[], Treal ch[], const Treal wa[])
   {
-    static const Treal twopi = 6.28318530717959;
+    static const double twopi = 6.28318530717959;
     int idij, ipph, i, j, k, l, j2, ic, jc, lc, ik, is, nbd;
-    Treal dc2, ai1, ai2, ar1, ar2, ds2, dcp, arg, dsp, ar1h, ar2h;
+    /* the twiddle recurrence is kept in double for the float build */
+    double dc2, ai1, ai2, ar1, ar2, ds2, dcp, arg, dsp, ar1h, ar2h;
     arg = twopi / ip;
     dcp = cos(arg);
     dsp = sin(arg);
@@ -971,11 +979,11 @@ static void radfg(int ido, int ip, int l1, int idl1,
 static void radbg(int ido, int ip, int l1, int idl1,
       Treal cc[], Treal ch[], const Treal wa[])
   {
-    static const Treal twopi = 6.28318530717959;
+    static const double twopi = 6.28318530717959;
     int idij, ipph, i, j, k, l, j2, ic, jc, lc, ik, is;
-    Treal dc2, ai1, ai2, ar1, ar2, ds2;
+    double dc2, ai1, ai2, ar1, ar2, ds2;
     int nbd;
-    Treal dcp, arg, dsp, ar1h, ar2h;
+    double dcp, arg, dsp, ar1h, ar2h;
     arg = twopi / ip;
     dcp = cos(arg);
     dsp = sin(arg);
@@ -1204,10 +1212,27 @@ static void cfftf1(int n, Treal c[], Treal ch[], const Treal wa[], const int ifa
   } /* cfftf1 */
 
 
+/* The first element of every work array records the Bluestein length m
+   chosen by cffti/rffti (0 if n is done with the fftpack passes), so that
+   the transforms need not factor n again.  The plan proper follows it. */
+#define PLAN_HEAD 1
+#define PLAN_M(wsave) (*(int *)(wsave))
+
+static int bluestein_size(int n);
+static void bluestein(int n, int m, Treal c[], Treal wsave[], int isign);
+static void bluesteini(int n, int m, Treal wsave[]);
+
+
 void cfftf(int n, Treal c[], Treal wsave[])
   {
-    int iw1, iw2;
+    int iw1, iw2, m;
     if (n == 1) return;
+    m = PLAN_M(wsave);
+    wsave += PLAN_HEAD;
+    if (m) {
+      bluestein(n, m, c, wsave, -1);
+      return;
+    }
     iw1 = 2*n;
     iw2 = iw1 + 2*n;
     cfftf1(n, c, wsave, wsave+iw1, (int*)(wsave+iw2), -1);
@@ -1216,14 +1241,94 @@ void cfftf(int n, Treal c[], Treal wsave[])
 
 void cfftb(int n, Treal c[], Treal wsave[])
   {
-    int iw1, iw2;
+    int iw1, iw2, m;
     if (n == 1) return;
+    m = PLAN_M(wsave);
+    wsave += PLAN_HEAD;
+    if (m) {
+      bluestein(n, m, c, wsave, +1);
+      return;
+    }
     iw1 = 2*n;
     iw2 = iw1 + 2*n;
     cfftf1(n, c, wsave, wsave+iw1, (int*)(wsave+iw2), +1);
   } /* cfftb */
 
 
+/* ----------------------------------------------------------------------
+cfft_axis. Complex FFT of all rows along one axis of an n-d array.
+---------------------------------------------------------------------- */
+
+/*
+ * FFT_BLOCK (see fftpack.h) rows are gathered into the scratch buffer at
+ * once when transforming along an axis which is not the last one.  The
+ * gather reads FFT_BLOCK adjacent complex values per element of the row,
+ * i.e. whole cache lines, instead of striding through memory one element
+ * at a time.
+ *
+ * Transform all rows of a C-contiguous complex array viewed as
+ * (outer, npts, inner) along the middle axis.  buf must hold
+ * 2*npts*FFT_BLOCK values and wsave must not be shared with other threads,
+ * as its head is used as scratch space.
+ */
+void cfft_axis(Treal data[], ptrdiff_t outer, int npts, ptrdiff_t inner,
+               Treal wsave[], Treal buf[], int isign)
+  {
+    ptrdiff_t o, i0, i, nb;
+    int j;
+    Treal *plane, *src, *row;
+
+    if (inner == 1) {
+        for (o = 0; o < outer; o++) {
+            if (isign < 0) {
+                cfftf(npts, data, wsave);
+            }
+            else {
+                cfftb(npts, data, wsave);
+            }
+            data += 2*npts;
+        }
+        return;
+    }
+
+    for (o = 0; o < outer; o++) {
+        plane = data + 2*o*npts*inner;
+        for (i0 = 0; i0 < inner; i0 += FFT_BLOCK) {
+            nb = inner - i0;
+            if (nb > FFT_BLOCK) {
+                nb = FFT_BLOCK;
+            }
+            /* gather a tile of nb columns into nb contiguous rows */
+            for (j = 0; j < npts; j++) {
+                src = plane + 2*(j*inner + i0);
+                for (i = 0; i < nb; i++) {
+                    row = buf + 2*(i*npts + j);
+                    row[0] = src[2*i];
+                    row[1] = src[2*i + 1];
+                }
+            }
+            for (i = 0; i < nb; i++) {
+                if (isign < 0) {
+                    cfftf(npts, buf + 2*i*npts, wsave);
+                }
+                else {
+                    cfftb(npts, buf + 2*i*npts, wsave);
+                }
+            }
+            /* and scatter the transformed rows back */
+            for (j = 0; j < npts; j++) {
+                src = plane + 2*(j*inner + i0);
+                for (i = 0; i < nb; i++) {
+                    row = buf + 2*(i*npts + j);
+                    src[2*i] = row[0];
+                    src[2*i + 1] = row[1];
+                }
+            }
+        }
+    }
+  } /* cfft_axis */
+
+
 static void factorize(int n, int ifac[MAXFAC+2], const int ntryh[NSPECIAL])
   /* Factorize n in factors in ntryh and rest. On exit,
 ifac[0] contains n and ifac[1] contains number of factors,
@@ -1258,8 +1363,9 @@ startloop:
 
 static void cffti1(int n, Treal wa[], int ifac[MAXFAC+2])
   {
-    static const Treal twopi = 6.28318530717959;
-    Treal arg, argh, argld, fi;
+    static const double twopi = 6.28318530717959;
+    /* twiddles are computed in double for the float build, too */
+    double arg, argh, argld, fi;
     int idot, i, j;
     int i1, k1, l1, l2;
     int ld, ii, nf, ip;
@@ -1306,13 +1412,170 @@ static void cffti1(int n, Treal wa[], int ifac[MAXFAC+2])
 
 void cffti(int n, Treal wsave[])
  {
-    int iw1, iw2;
+    int iw1, iw2, m;
+    m = bluestein_size(n);
+    PLAN_M(wsave) = m;
+    wsave += PLAN_HEAD;
     if (n == 1) return;
+    if (m) {
+      bluesteini(n, m, wsave);
+      return;
+    }
     iw1 = 2*n;
     iw2 = iw1 + 2*n;
     cffti1(n, wsave+iw1, (int*)(wsave+iw2));
   } /* cffti */
 
+
+  /* ----------------------------------------------------------------------
+bluestein_size, cffti_size, rffti_size, bluesteini, bluestein. Sizes with
+large prime factors.  The generic passf/radfg passes cost O(n*p) for a
+prime factor p, so for p > MAXGENERIC the DFT is instead written as a
+convolution with the chirp exp(-i*pi*j^2/n) (Bluestein's algorithm), which
+is done with power of two FFTs of a length m >= 2n-1.
+
+The work array of such a size holds chirp[2n], the transformed and scaled
+convolution kernel[2m], scratch[2m] and the cffti array of size m.
+---------------------------------------------------------------------- */
+
+#define MAXGENERIC 100
+
+static int bluestein_size(int n)
+  /* Returns m if n is transformed with Bluestein's algorithm, else 0. */
+  {
+    int f, nl = n, big = 1, m;
+    for (f = 2; f*f <= nl; f++) {
+      while (nl % f == 0) {
+        nl /= f;
+        big = f;
+      }
+    }
+    if (nl > big) big = nl;
+    if (big <= MAXGENERIC) return 0;
+    for (m = 1; m < 2*n - 1; m *= 2)
+      ;
+    return m;
+  }
+
+
+int cffti_size(int n)
+  /* Length of the work array which cffti(n) fills in. */
+  {
+    int m = bluestein_size(n);
+    if (m) return PLAN_HEAD + 2*n + 4*m + cffti_size(m);
+    return PLAN_HEAD + 4*n + 15;
+  } /* cffti_size */
+
+
+int rffti_size(int n)
+  /* Length of the work array which rffti(n) fills in. */
+  {
+    int m = bluestein_size(n);
+    if (m) return cffti_size(n) + 2*n;
+    return PLAN_HEAD + 2*n + 15;
+  } /* rffti_size */
+
+
+static void bluesteini(int n, int m, Treal wsave[])
+  {
+    static const double pi = 3.14159265358979323846;
+    Treal *chirp = wsave, *bk = wsave + 2*n, *wm = wsave + 2*n + 4*m;
+    double arg;
+    int j, jj;
+    cffti(m, wm);
+    /* j*j mod 2n, so that the argument stays small */
+    jj = 0;
+    for (j = 0; j < n; j++) {
+      arg = pi*jj/n;
+      chirp[2*j] = cos(arg);
+      chirp[2*j+1] = -sin(arg);
+      jj += 2*j + 1;
+      if (jj >= 2*n) jj -= 2*n;
+    }
+    for (j = 0; j < 2*m; j++) bk[j] = 0;
+    bk[0] = chirp[0];
+    bk[1] = -chirp[1];
+    for (j = 1; j < n; j++) {
+      bk[2*j] = bk[2*(m - j)] = chirp[2*j];
+      bk[2*j+1] = bk[2*(m - j)+1] = -chirp[2*j+1];
+    }
+    cfftf(m, bk, wm);
+    for (j = 0; j < 2*m; j++) bk[j] /= m;
+  } /* bluesteini */
+
+
+static void bluestein(int n, int m, Treal c[], Treal wsave[], int isign)
+  /* isign is -1 for forward transform and +1 for backward transform;
+     the chirp and kernel of the backward transform are the conjugates. */
+  {
+    Treal *chirp = wsave, *bk = wsave + 2*n, *a = bk + 2*m, *wm = a + 2*m;
+    Treal cr, ci, tr, ti;
+    int j;
+    for (j = 0; j < n; j++) {
+      cr = chirp[2*j];
+      ci = -isign*chirp[2*j+1];
+      a[2*j] = c[2*j]*cr - c[2*j+1]*ci;
+      a[2*j+1] = c[2*j]*ci + c[2*j+1]*cr;
+    }
+    for (j = 2*n; j < 2*m; j++) a[j] = 0;
+    cfftf(m, a, wm);
+    for (j = 0; j < m; j++) {
+      cr = bk[2*j];
+      ci = -isign*bk[2*j+1];
+      tr = a[2*j]*cr - a[2*j+1]*ci;
+      ti = a[2*j]*ci + a[2*j+1]*cr;
+      a[2*j] = tr;
+      a[2*j+1] = ti;
+    }
+    cfftb(m, a, wm);
+    for (j = 0; j < n; j++) {
+      cr = chirp[2*j];
+      ci = -isign*chirp[2*j+1];
+      c[2*j] = a[2*j]*cr - a[2*j+1]*ci;
+      c[2*j+1] = a[2*j]*ci + a[2*j+1]*cr;
+    }
+  } /* bluestein */
+
+
+static void rbluesteinf(int n, int m, Treal r[], Treal wsave[])
+  /* Real forward transform through the complex one; the result is packed
+     like that of rfftf1. */
+  {
+    Treal *z = wsave + cffti_size(n) - PLAN_HEAD;
+    int k;
+    for (k = 0; k < n; k++) {
+      z[2*k] = r[k];
+      z[2*k+1] = 0;
+    }
+    bluestein(n, m, z, wsave, -1);
+    r[0] = z[0];
+    for (k = 1; 2*k < n; k++) {
+      r[2*k-1] = z[2*k];
+      r[2*k] = z[2*k+1];
+    }
+    if (n % 2 == 0) r[n-1] = z[n];
+  } /* rbluesteinf */
+
+
+static void rbluesteinb(int n, int m, Treal r[], Treal wsave[])
+  {
+    Treal *z = wsave + cffti_size(n) - PLAN_HEAD;
+    int k;
+    z[0] = r[0];
+    z[1] = 0;
+    for (k = 1; 2*k < n; k++) {
+      z[2*k] = z[2*(n-k)] = r[2*k-1];
+      z[2*k+1] = r[2*k];
+      z[2*(n-k)+1] = -r[2*k];
+    }
+    if (n % 2 == 0) {
+      z[n] = r[n-1];
+      z[n+1] = 0;
+    }
+    bluestein(n, m, z, wsave, +1);
+    for (k = 0; k < n; k++) r[k] = z[2*k];
+  } /* rbluesteinb */
+
   /* ----------------------------------------------------------------------
 rfftf1, rfftb1, rfftf, rfftb, rffti1, rffti. Treal FFTs.
 ---------------------------------------------------------------------- */
@@ -1436,22 +1699,37 @@ void rfftb1(int n, Treal c[], Treal ch[], const Treal wa[], const int ifac[MAXFA
 
 void rfftf(int n, Treal r[], Treal wsave[])
   {
+    int m;
     if (n == 1) return;
+    m = PLAN_M(wsave);
+    wsave += PLAN_HEAD;
+    if (m) {
+      rbluesteinf(n, m, r, wsave);
+      return;
+    }
     rfftf1(n, r, wsave, wsave+n, (int*)(wsave+2*n));
   } /* rfftf */
 
 
 void rfftb(int n, Treal r[], Treal wsave[])
   {
+    int m;
     if (n == 1) return;
+    m = PLAN_M(wsave);
+    wsave += PLAN_HEAD;
+    if (m) {
+      rbluesteinb(n, m, r, wsave);
+      return;
+    }
     rfftb1(n, r, wsave, wsave+n, (int*)(wsave+2*n));
   } /* rfftb */
 
 
 static void rffti1(int n, Treal wa[], int ifac[MAXFAC+2])
   {
-    static const Treal twopi = 6.28318530717959;
-    Treal arg, argh, argld, fi;
+    static const double twopi = 6.28318530717959;
+    /* twiddles are computed in double for the float build, too */
+    double arg, argh, argld, fi;
     int i, j;
     int k1, l1, l2;
     int ld, ii, nf, ip, is;
@@ -1474,7 +1752,7 @@ static void rffti1(int n, Treal wa[], int ifac[MAXFAC+2])
       for (j = 1; j <= ipm; ++j) {
         ld += l1;
         i = is;
-        argld = (Treal) ld*argh;
+        argld = (double) ld*argh;
         fi = 0;
         for (ii = 3; ii <= ido; ii += 2) {
           i += 2;
@@ -1492,7 +1770,15 @@ static void rffti1(int n, Treal wa[], int ifac[MAXFAC+2])
 
 void rffti(int n, Treal wsave[])
   {
+    int m;
+    m = bluestein_size(n);
+    PLAN_M(wsave) = m;
+    wsave += PLAN_HEAD;
     if (n == 1) return;
+    if (m) {
+      bluesteini(n, m, wsave);
+      return;
+    }
     rffti1(n, wsave+n, (int*)(wsave+2*n));
   } /* rffti */
 
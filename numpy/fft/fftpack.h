@@ -3,10 +3,18 @@
  * Copyright (c) 1994-1995 Pekka Janhunen
  */
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/* rows transformed per tile by cfft_axis; buf holds 2*n*FFT_BLOCK values */
+#define FFT_BLOCK 16
+
+/* fftpack.c, which is also built in single precision, wants FFT_BLOCK only */
+#ifndef FFTPACK_NO_PROTOTYPES
+
 #define DOUBLE
 
 #ifdef DOUBLE
@@ -18,10 +26,28 @@ extern "C" {
 extern void cfftf(int N, Treal data[], const Treal wrk[]);
 extern void cfftb(int N, Treal data[], const Treal wrk[]);
 extern void cffti(int N, Treal wrk[]);
+/* work array lengths, in elements of either precision */
+extern int cffti_size(int N);
+extern void cfft_axis(Treal data[], ptrdiff_t outer, int N, ptrdiff_t inner,
+                      Treal wrk[], Treal buf[], int isign);
 
 extern void rfftf(int N, Treal data[], const Treal wrk[]);
 extern void rfftb(int N, Treal data[], const Treal wrk[]);
 extern void rffti(int N, Treal wrk[]);
+extern int rffti_size(int N);
+
+/* single precision versions, built from fftpack.c by fftpack_float.c */
+extern void scfftf(int N, float data[], const float wrk[]);
+extern void scfftb(int N, float data[], const float wrk[]);
+extern void scffti(int N, float wrk[]);
+extern void scfft_axis(float data[], ptrdiff_t outer, int N, ptrdiff_t inner,
+                       float wrk[], float buf[], int isign);
+
+extern void srfftf(int N, float data[], const float wrk[]);
+extern void srfftb(int N, float data[], const float wrk[]);
+extern void srffti(int N, float wrk[]);
+
+#endif /* FFTPACK_NO_PROTOTYPES */
 
 #ifdef __cplusplus
 }
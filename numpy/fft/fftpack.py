@@ -29,6 +29,10 @@ behavior.)
 The underlying code for these functions is an f2c-translated and modified
 version of the FFTPACK routines.
 
+Single precision (float32 or complex64) input is transformed in single
+precision and gives a complex64 (or float32) result; all other input is
+transformed in double precision.
+
 """
 __all__ = ['fft','ifft', 'rfft', 'irfft', 'hfft', 'ihfft', 'rfftn',
            'irfftn', 'rfft2', 'irfft2', 'fft2', 'ifft2', 'fftn', 'ifftn',
@@ -40,14 +44,40 @@ import fftpack_lite as fftpack
 
 _fft_cache = {}
 _real_fft_cache = {}
+_sfft_cache = {}
+_real_sfft_cache = {}
 
-def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
-             work_function=fftpack.cfftf, fft_cache = _fft_cache ):
-    a = asarray(a)
+def _is_single(a):
+    # float32 and complex64 input is transformed in single precision
+    return a.dtype.char in 'fF'
 
-    if n is None:
-        n = a.shape[axis]
 
+def _float_type(a):
+    if _is_single(a):
+        return 'f'
+    return float
+
+
+def _complex_type(a):
+    if _is_single(a):
+        return 'F'
+    return complex
+
+
+def _cffti(a):
+    # Work array constructor and cache matching the precision of `a`.
+    if _is_single(a):
+        return fftpack.scffti, _sfft_cache
+    return fftpack.cffti, _fft_cache
+
+
+def _rffti(a):
+    if _is_single(a):
+        return fftpack.srffti, _real_sfft_cache
+    return fftpack.rffti, _real_fft_cache
+
+
+def _get_wsave(n, init_function, fft_cache):
     if n < 1:
         raise ValueError("Invalid number of FFT data points (%d) specified." % n)
 
@@ -56,20 +86,35 @@ def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
     except(KeyError):
         wsave = init_function(n)
         fft_cache[n] = wsave
+    return wsave
+
+
+def _fix_shape(a, n, axis):
+    # Crop or zero-pad `a` to length `n` along `axis`.
+    s = list(a.shape)
+    if s[axis] > n:
+        index = [slice(None)]*len(s)
+        index[axis] = slice(0,n)
+        a = a[index]
+    elif s[axis] < n:
+        index = [slice(None)]*len(s)
+        index[axis] = slice(0,s[axis])
+        s[axis] = n
+        z = zeros(s, a.dtype.char)
+        z[index] = a
+        a = z
+    return a
 
-    if a.shape[axis] != n:
-        s = list(a.shape)
-        if s[axis] > n:
-            index = [slice(None)]*len(s)
-            index[axis] = slice(0,n)
-            a = a[index]
-        else:
-            index = [slice(None)]*len(s)
-            index[axis] = slice(0,s[axis])
-            s[axis] = n
-            z = zeros(s, a.dtype.char)
-            z[index] = a
-            a = z
+
+def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
+             work_function=fftpack.cfftf, fft_cache = _fft_cache ):
+    a = asarray(a)
+
+    if n is None:
+        n = a.shape[axis]
+
+    wsave = _get_wsave(n, init_function, fft_cache)
+    a = _fix_shape(a, n, axis)
 
     if axis != -1:
         a = swapaxes(a, axis, -1)
@@ -79,6 +124,20 @@ def _raw_fft(a, n=None, axis=-1, init_function=fftpack.cffti,
     return r
 
 
+def _raw_cfftnd(a, s, axes, isign):
+    # Complex transform over all of `axes` in a single call into C, which
+    # transforms the rows of every axis in place without swapaxes copies.
+    a = asarray(a)
+    if len(axes) == 0:
+        return a
+    init_function, fft_cache = _cffti(a)
+    wsaves = []
+    for n, axis in zip(s, axes):
+        wsaves.append(_get_wsave(n, init_function, fft_cache))
+        a = _fix_shape(a, n, axis)
+    return fftpack.cfftn(a, axes, wsaves, isign)
+
+
 def fft(a, n=None, axis=-1):
     """
     Compute the one-dimensional discrete Fourier Transform.
@@ -162,7 +221,10 @@ def fft(a, n=None, axis=-1):
 
     """
 
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftf, _fft_cache)
+    a = asarray(a)
+    if n is None:
+        n = a.shape[axis]
+    return _raw_cfftnd(a, [n], [axis], -1)
 
 
 def ifft(a, n=None, axis=-1):
@@ -240,10 +302,11 @@ def ifft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(complex)
+    a = asarray(a)
+    a = a.astype(_complex_type(a))
     if n is None:
         n = shape(a)[axis]
-    return _raw_fft(a, n, axis, fftpack.cffti, fftpack.cfftb, _fft_cache) / n
+    return _raw_cfftnd(a, [n], [axis], 1) / n
 
 
 def rfft(a, n=None, axis=-1):
@@ -319,8 +382,10 @@ def rfft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(float)
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftf, _real_fft_cache)
+    a = asarray(a)
+    a = a.astype(_float_type(a))
+    init_function, fft_cache = _rffti(a)
+    return _raw_fft(a, n, axis, init_function, fftpack.rfftf, fft_cache)
 
 
 def irfft(a, n=None, axis=-1):
@@ -400,11 +465,13 @@ def irfft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(complex)
+    a = asarray(a)
+    a = a.astype(_complex_type(a))
     if n is None:
         n = (shape(a)[axis] - 1) * 2
-    return _raw_fft(a, n, axis, fftpack.rffti, fftpack.rfftb,
-                    _real_fft_cache) / n
+    init_function, fft_cache = _rffti(a)
+    return _raw_fft(a, n, axis, init_function, fftpack.rfftb,
+                    fft_cache) / n
 
 
 def hfft(a, n=None, axis=-1):
@@ -452,7 +519,8 @@ def hfft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(complex)
+    a = asarray(a)
+    a = a.astype(_complex_type(a))
     if n is None:
         n = (shape(a)[axis] - 1) * 2
     return irfft(conjugate(a), n, axis) * n
@@ -491,7 +559,8 @@ def ihfft(a, n=None, axis=-1):
 
     """
 
-    a = asarray(a).astype(float)
+    a = asarray(a)
+    a = a.astype(_float_type(a))
     if n is None:
         n = shape(a)[axis]
     return conjugate(rfft(a, n, axis))/n
@@ -516,14 +585,18 @@ def _cook_nd_args(a, s=None, axes=None, invreal=0):
     return s, axes
 
 
-def _raw_fftnd(a, s=None, axes=None, function=fft):
+def _nd_scale(a, axes):
+    # Normalization of an inverse transform over `axes` of the padded `a`.
+    n = 1
+    for axis in axes:
+        n *= a.shape[axis]
+    return n
+
+
+def _raw_fftnd(a, s=None, axes=None, isign=-1):
     a = asarray(a)
     s, axes = _cook_nd_args(a, s, axes)
-    itl = range(len(axes))
-    itl.reverse()
-    for ii in itl:
-        a = function(a, n=s[ii], axis=axes[ii])
-    return a
+    return _raw_cfftnd(a, s, axes, isign)
 
 
 def fftn(a, s=None, axes=None):
@@ -616,7 +689,7 @@ def fftn(a, s=None, axes=None):
 
     """
 
-    return _raw_fftnd(a,s,axes,fft)
+    return _raw_fftnd(a, s, axes, -1)
 
 def ifftn(a, s=None, axes=None):
     """
@@ -708,7 +781,8 @@ def ifftn(a, s=None, axes=None):
 
     """
 
-    return _raw_fftnd(a, s, axes, ifft)
+    a = _raw_fftnd(a, s, axes, 1)
+    return a / _nd_scale(a, axes)
 
 
 def fft2(a, s=None, axes=(-2,-1)):
@@ -789,7 +863,7 @@ def fft2(a, s=None, axes=(-2,-1)):
 
     """
 
-    return _raw_fftnd(a,s,axes,fft)
+    return _raw_fftnd(a, s, axes, -1)
 
 
 def ifft2(a, s=None, axes=(-2,-1)):
@@ -872,7 +946,8 @@ def ifft2(a, s=None, axes=(-2,-1)):
 
     """
 
-    return _raw_fftnd(a, s, axes, ifft)
+    a = _raw_fftnd(a, s, axes, 1)
+    return a / _nd_scale(a, axes)
 
 
 def rfftn(a, s=None, axes=None):
@@ -955,12 +1030,11 @@ def rfftn(a, s=None, axes=None):
 
     """
 
-    a = asarray(a).astype(float)
+    a = asarray(a)
+    a = a.astype(_float_type(a))
     s, axes = _cook_nd_args(a, s, axes)
     a = rfft(a, s[-1], axes[-1])
-    for ii in range(len(axes)-1):
-        a = fft(a, s[ii], axes[ii])
-    return a
+    return _raw_cfftnd(a, s[:-1], axes[:-1], -1)
 
 def rfft2(a, s=None, axes=(-2,-1)):
     """
@@ -1076,10 +1150,11 @@ def irfftn(a, s=None, axes=None):
 
     """
 
-    a = asarray(a).astype(complex)
+    a = asarray(a)
+    a = a.astype(_complex_type(a))
     s, axes = _cook_nd_args(a, s, axes, invreal=1)
-    for ii in range(len(axes)-1):
-        a = ifft(a, s[ii], axes[ii])
+    a = _raw_cfftnd(a, s[:-1], axes[:-1], 1)
+    a = a / _nd_scale(a, axes[:-1])
     a = irfft(a, s[-1], axes[-1])
     return a
 
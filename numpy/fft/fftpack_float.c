@@ -0,0 +1,20 @@
+/*
+ * Single precision FFTPACK: fftpack.c compiled with Treal as float and the
+ * exported routines renamed with an 's' prefix.
+ */
+
+#define FFTPACK_SINGLE
+
+#define cfftf scfftf
+#define cfftb scfftb
+#define cffti scffti
+#define cfft_axis scfft_axis
+#define rfftf srfftf
+#define rfftb srfftb
+#define rffti srffti
+#define rfftb1 srfftb1
+/* the work array lengths do not depend on the precision */
+#define cffti_size scffti_size
+#define rffti_size srffti_size
+
+#include "fftpack.c"
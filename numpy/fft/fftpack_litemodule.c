@@ -6,112 +6,126 @@ static PyObject *ErrorObject;
 
 /* ----------------------------------------------------- */
 
-static char fftpack_cfftf__doc__[] = "";
+/*
+ * The precision of a transform follows its work array: the float32 arrays
+ * made by scffti and srffti select the single precision fftpack routines.
+ */
+static int
+is_single(PyObject *wsave)
+{
+    return PyArray_Check(wsave) &&
+        PyArray_TYPE((PyArrayObject *)wsave) == PyArray_FLOAT;
+}
 
-PyObject *
-fftpack_cfftf(PyObject *NPY_UNUSED(self), PyObject *args)
+static PyObject *
+execute_complex(PyObject *args, int isign)
 {
     PyObject *op1, *op2;
-    PyArrayObject *data;
-    PyArray_Descr *descr;
-    double *wsave, *dptr;
-    npy_intp nsave;
-    int npts, nrepeats, i;
+    PyArrayObject *data, *wsave;
+    char *dptr, *wptr;
+    int single, npts, nrepeats, i;
 
     if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
         return NULL;
     }
+    single = is_single(op2);
     data = (PyArrayObject *)PyArray_CopyFromObject(op1,
-            PyArray_CDOUBLE, 1, 0);
+            single ? PyArray_CFLOAT : PyArray_CDOUBLE, 1, 0);
     if (data == NULL) {
         return NULL;
     }
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
-        goto fail;
-    }
-    if (data == NULL) {
+    wsave = (PyArrayObject *)PyArray_ContiguousFromObject(op2,
+            single ? PyArray_FLOAT : PyArray_DOUBLE, 1, 1);
+    if (wsave == NULL) {
         goto fail;
     }
 
     npts = data->dimensions[data->nd - 1];
-    if (nsave != npts*4 + 15) {
+    if (PyArray_DIM(wsave, 0) != cffti_size(npts)) {
         PyErr_SetString(ErrorObject, "invalid work array for fft size");
         goto fail;
     }
 
     nrepeats = PyArray_SIZE(data)/npts;
-    dptr = (double *)data->data;
+    dptr = data->data;
+    wptr = wsave->data;
     NPY_SIGINT_ON;
     for (i = 0; i < nrepeats; i++) {
-        cfftf(npts, dptr, wsave);
-        dptr += npts*2;
+        if (single) {
+            if (isign < 0) {
+                scfftf(npts, (float *)dptr, (float *)wptr);
+            }
+            else {
+                scfftb(npts, (float *)dptr, (float *)wptr);
+            }
+        }
+        else {
+            if (isign < 0) {
+                cfftf(npts, (double *)dptr, (double *)wptr);
+            }
+            else {
+                cfftb(npts, (double *)dptr, (double *)wptr);
+            }
+        }
+        dptr += npts*data->descr->elsize;
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    Py_DECREF(wsave);
     return (PyObject *)data;
 
 fail:
-    PyArray_Free(op2, (char *)wsave);
+    Py_XDECREF(wsave);
     Py_DECREF(data);
     return NULL;
 }
 
+static char fftpack_cfftf__doc__[] = "";
+
+PyObject *
+fftpack_cfftf(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    return execute_complex(args, -1);
+}
+
 static char fftpack_cfftb__doc__[] = "";
 
 PyObject *
 fftpack_cfftb(PyObject *NPY_UNUSED(self), PyObject *args)
 {
-    PyObject *op1, *op2;
-    PyArrayObject *data;
-    PyArray_Descr *descr;
-    double *wsave, *dptr;
-    npy_intp nsave;
-    int npts, nrepeats, i;
+    return execute_complex(args, +1);
+}
 
-    if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
+static char fftpack_cffti__doc__[] ="";
+
+static PyObject *
+fftpack_cffti(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyArrayObject *op;
+    npy_intp dim;
+    long n;
+
+    if (!PyArg_ParseTuple(args, "l", &n)) {
         return NULL;
     }
-    data = (PyArrayObject *)PyArray_CopyFromObject(op1,
-            PyArray_CDOUBLE, 1, 0);
-    if (data == NULL) {
+    /*Magic size needed by cffti*/
+    dim = cffti_size(n);
+    /*Create a 1 dimensional array of dimensions of type double*/
+    op = (PyArrayObject *)PyArray_SimpleNew(1, &dim, PyArray_DOUBLE);
+    if (op == NULL) {
         return NULL;
     }
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
-        goto fail;
-    }
-    if (data == NULL) {
-        goto fail;
-    }
 
-    npts = data->dimensions[data->nd - 1];
-    if (nsave != npts*4 + 15) {
-        PyErr_SetString(ErrorObject, "invalid work array for fft size");
-        goto fail;
-    }
-
-    nrepeats = PyArray_SIZE(data)/npts;
-    dptr = (double *)data->data;
     NPY_SIGINT_ON;
-    for (i = 0; i < nrepeats; i++) {
-        cfftb(npts, dptr, wsave);
-        dptr += npts*2;
-    }
+    cffti(n, (double *)((PyArrayObject*)op)->data);
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
-    return (PyObject *)data;
 
-fail:
-    PyArray_Free(op2, (char *)wsave);
-    Py_DECREF(data);
-    return NULL;
+    return (PyObject *)op;
 }
 
-static char fftpack_cffti__doc__[] ="";
+static char fftpack_scffti__doc__[] ="";
 
 static PyObject *
-fftpack_cffti(PyObject *NPY_UNUSED(self), PyObject *args)
+fftpack_scffti(PyObject *NPY_UNUSED(self), PyObject *args)
 {
     PyArrayObject *op;
     npy_intp dim;
@@ -120,81 +134,233 @@ fftpack_cffti(PyObject *NPY_UNUSED(self), PyObject *args)
     if (!PyArg_ParseTuple(args, "l", &n)) {
         return NULL;
     }
-    /*Magic size needed by cffti*/
-    dim = 4*n + 15;
-    /*Create a 1 dimensional array of dimensions of type double*/
-    op = (PyArrayObject *)PyArray_SimpleNew(1, &dim, PyArray_DOUBLE);
+    /*Same magic size as cffti, in floats*/
+    dim = cffti_size(n);
+    op = (PyArrayObject *)PyArray_SimpleNew(1, &dim, PyArray_FLOAT);
     if (op == NULL) {
         return NULL;
     }
 
     NPY_SIGINT_ON;
-    cffti(n, (double *)((PyArrayObject*)op)->data);
+    scffti(n, (float *)((PyArrayObject*)op)->data);
     NPY_SIGINT_OFF;
 
     return (PyObject *)op;
 }
 
+static char fftpack_cfftn__doc__[] =
+"cfftn(a, axes, wsaves, isign)\n\n"
+"Complex transform of a over each of the given axes, in order.  wsaves\n"
+"holds the cffti (or scffti) work array for each axis, isign is -1 for the\n"
+"forward and +1 for the backward transform.  Returns a new C-contiguous\n"
+"array.";
+
+static PyObject *
+fftpack_cfftn(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *op1, *op2, *op3, *item;
+    PyArrayObject *data = NULL, *axes = NULL, *wsave = NULL;
+    char *buf = NULL, *wcopy = NULL;
+    npy_intp *axptr, outer, inner;
+    int isign, single, elsize, naxes, nd, npts, maxpts, wsize, ax, i, k;
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTuple(args, "OOOi", &op1, &op2, &op3, &isign)) {
+        return NULL;
+    }
+    if (!PySequence_Check(op3)) {
+        PyErr_SetString(PyExc_TypeError, "work arrays must be a sequence");
+        return NULL;
+    }
+    single = 0;
+    if (PySequence_Size(op3) > 0) {
+        item = PySequence_GetItem(op3, 0);
+        if (item == NULL) {
+            return NULL;
+        }
+        single = is_single(item);
+        Py_DECREF(item);
+    }
+    elsize = single ? sizeof(float) : sizeof(double);
+    data = (PyArrayObject *)PyArray_CopyFromObject(op1,
+            single ? PyArray_CFLOAT : PyArray_CDOUBLE, 0, 0);
+    if (data == NULL) {
+        return NULL;
+    }
+    axes = (PyArrayObject *)PyArray_ContiguousFromObject(op2,
+            PyArray_INTP, 1, 1);
+    if (axes == NULL) {
+        goto fail;
+    }
+    naxes = PyArray_DIM(axes, 0);
+    if (PySequence_Size(op3) != naxes) {
+        PyErr_SetString(PyExc_ValueError,
+                "need one work array per transformed axis");
+        goto fail;
+    }
+    nd = data->nd;
+    axptr = (npy_intp *)axes->data;
+    maxpts = 1;
+    wsize = 0;
+    for (k = 0; k < naxes; k++) {
+        ax = axptr[k] < 0 ? axptr[k] + nd : axptr[k];
+        if (ax < 0 || ax >= nd) {
+            PyErr_SetString(PyExc_ValueError, "invalid axis for fft");
+            goto fail;
+        }
+        if (data->dimensions[ax] > maxpts) {
+            maxpts = data->dimensions[ax];
+        }
+        if (cffti_size(data->dimensions[ax]) > wsize) {
+            wsize = cffti_size(data->dimensions[ax]);
+        }
+    }
+    if (PyArray_SIZE(data) == 0 || naxes == 0) {
+        Py_DECREF(axes);
+        return (PyObject *)data;
+    }
+
+    buf = malloc(2*FFT_BLOCK*maxpts*elsize);
+    wcopy = malloc(wsize*elsize);
+    if (buf == NULL || wcopy == NULL) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    for (k = 0; k < naxes; k++) {
+        ax = axptr[k] < 0 ? axptr[k] + nd : axptr[k];
+        npts = data->dimensions[ax];
+        item = PySequence_GetItem(op3, k);
+        if (item == NULL) {
+            goto fail;
+        }
+        wsave = (PyArrayObject *)PyArray_ContiguousFromObject(item,
+                single ? PyArray_FLOAT : PyArray_DOUBLE, 1, 1);
+        Py_DECREF(item);
+        if (wsave == NULL) {
+            goto fail;
+        }
+        if (PyArray_DIM(wsave, 0) != cffti_size(npts)) {
+            PyErr_SetString(ErrorObject, "invalid work array for fft size");
+            goto fail;
+        }
+        /*
+         * cfftf/cfftb use the head of the work array as scratch space, so
+         * work on a private copy which no other thread can see.
+         */
+        memcpy(wcopy, wsave->data, cffti_size(npts)*elsize);
+        Py_DECREF(wsave);
+        wsave = NULL;
+
+        outer = 1;
+        for (i = 0; i < ax; i++) {
+            outer *= data->dimensions[i];
+        }
+        inner = 1;
+        for (i = ax + 1; i < nd; i++) {
+            inner *= data->dimensions[i];
+        }
+        NPY_BEGIN_THREADS;
+        if (single) {
+            scfft_axis((float *)data->data, outer, npts, inner,
+                       (float *)wcopy, (float *)buf, isign);
+        }
+        else {
+            cfft_axis((double *)data->data, outer, npts, inner,
+                      (double *)wcopy, (double *)buf, isign);
+        }
+        NPY_END_THREADS;
+    }
+
+    free(buf);
+    free(wcopy);
+    Py_DECREF(axes);
+    return (PyObject *)data;
+
+fail:
+    free(buf);
+    free(wcopy);
+    Py_XDECREF(wsave);
+    Py_XDECREF(axes);
+    Py_DECREF(data);
+    return NULL;
+}
+
 static char fftpack_rfftf__doc__[] ="";
 
 PyObject *
 fftpack_rfftf(PyObject *NPY_UNUSED(self), PyObject *args)
 {
     PyObject *op1, *op2;
-    PyArrayObject *data, *ret;
-    PyArray_Descr *descr;
-    double *wsave, *dptr, *rptr;
-    npy_intp nsave;
-    int npts, nrepeats, i, rstep;
+    PyArrayObject *data, *ret = NULL, *wsave = NULL;
+    int single, npts, nrepeats, i, rstep;
 
     if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
         return NULL;
     }
+    single = is_single(op2);
     data = (PyArrayObject *)PyArray_ContiguousFromObject(op1,
-            PyArray_DOUBLE, 1, 0);
+            single ? PyArray_FLOAT : PyArray_DOUBLE, 1, 0);
     if (data == NULL) {
         return NULL;
     }
     npts = data->dimensions[data->nd-1];
     data->dimensions[data->nd - 1] = npts/2 + 1;
     ret = (PyArrayObject *)PyArray_Zeros(data->nd, data->dimensions,
-            PyArray_DescrFromType(PyArray_CDOUBLE), 0);
+            PyArray_DescrFromType(single ? PyArray_CFLOAT : PyArray_CDOUBLE),
+            0);
     data->dimensions[data->nd - 1] = npts;
-    rstep = (ret->dimensions[ret->nd - 1])*2;
-
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
+    if (ret == NULL) {
         goto fail;
     }
-    if (data == NULL || ret == NULL) {
+    rstep = (ret->dimensions[ret->nd - 1])*2;
+
+    wsave = (PyArrayObject *)PyArray_ContiguousFromObject(op2,
+            single ? PyArray_FLOAT : PyArray_DOUBLE, 1, 1);
+    if (wsave == NULL) {
         goto fail;
     }
-    if (nsave != npts*2+15) {
+    if (PyArray_DIM(wsave, 0) != rffti_size(npts)) {
         PyErr_SetString(ErrorObject, "invalid work array for fft size");
         goto fail;
     }
 
     nrepeats = PyArray_SIZE(data)/npts;
-    rptr = (double *)ret->data;
-    dptr = (double *)data->data;
-
 
     NPY_SIGINT_ON;
-    for (i = 0; i < nrepeats; i++) {
-        memcpy((char *)(rptr+1), dptr, npts*sizeof(double));
-        rfftf(npts, rptr+1, wsave);
-        rptr[0] = rptr[1];
-        rptr[1] = 0.0;
-        rptr += rstep;
-        dptr += npts;
+    if (single) {
+        float *rptr = (float *)ret->data, *dptr = (float *)data->data;
+        float *wptr = (float *)wsave->data;
+
+        for (i = 0; i < nrepeats; i++) {
+            memcpy((char *)(rptr+1), dptr, npts*sizeof(float));
+            srfftf(npts, rptr+1, wptr);
+            rptr[0] = rptr[1];
+            rptr[1] = 0.0;
+            rptr += rstep;
+            dptr += npts;
+        }
+    }
+    else {
+        double *rptr = (double *)ret->data, *dptr = (double *)data->data;
+        double *wptr = (double *)wsave->data;
+
+        for (i = 0; i < nrepeats; i++) {
+            memcpy((char *)(rptr+1), dptr, npts*sizeof(double));
+            rfftf(npts, rptr+1, wptr);
+            rptr[0] = rptr[1];
+            rptr[1] = 0.0;
+            rptr += rstep;
+            dptr += npts;
+        }
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    Py_DECREF(wsave);
     Py_DECREF(data);
     return (PyObject *)ret;
 
 fail:
-    PyArray_Free(op2, (char *)wsave);
+    Py_XDECREF(wsave);
     Py_XDECREF(data);
     Py_XDECREF(ret);
     return NULL;
@@ -207,55 +373,69 @@ PyObject *
 fftpack_rfftb(PyObject *NPY_UNUSED(self), PyObject *args)
 {
     PyObject *op1, *op2;
-    PyArrayObject *data, *ret;
-    PyArray_Descr *descr;
-    double *wsave, *dptr, *rptr;
-    npy_intp nsave;
-    int npts, nrepeats, i;
+    PyArrayObject *data, *ret = NULL, *wsave = NULL;
+    int single, npts, nrepeats, i;
 
     if(!PyArg_ParseTuple(args, "OO", &op1, &op2)) {
         return NULL;
     }
+    single = is_single(op2);
     data = (PyArrayObject *)PyArray_ContiguousFromObject(op1,
-            PyArray_CDOUBLE, 1, 0);
+            single ? PyArray_CFLOAT : PyArray_CDOUBLE, 1, 0);
     if (data == NULL) {
         return NULL;
     }
     npts = data->dimensions[data->nd - 1];
     ret = (PyArrayObject *)PyArray_Zeros(data->nd, data->dimensions,
-            PyArray_DescrFromType(PyArray_DOUBLE), 0);
-
-    descr = PyArray_DescrFromType(PyArray_DOUBLE);
-    if (PyArray_AsCArray(&op2, (void *)&wsave, &nsave, 1, descr) == -1) {
+            PyArray_DescrFromType(single ? PyArray_FLOAT : PyArray_DOUBLE), 0);
+    if (ret == NULL) {
         goto fail;
     }
-    if (data == NULL || ret == NULL) {
+
+    wsave = (PyArrayObject *)PyArray_ContiguousFromObject(op2,
+            single ? PyArray_FLOAT : PyArray_DOUBLE, 1, 1);
+    if (wsave == NULL) {
         goto fail;
     }
-    if (nsave != npts*2 + 15) {
+    if (PyArray_DIM(wsave, 0) != rffti_size(npts)) {
         PyErr_SetString(ErrorObject, "invalid work array for fft size");
         goto fail;
     }
 
     nrepeats = PyArray_SIZE(ret)/npts;
-    rptr = (double *)ret->data;
-    dptr = (double *)data->data;
 
     NPY_SIGINT_ON;
-    for (i = 0; i < nrepeats; i++) {
-        memcpy((char *)(rptr + 1), (dptr + 2), (npts - 1)*sizeof(double));
-        rptr[0] = dptr[0];
-        rfftb(npts, rptr, wsave);
-        rptr += npts;
-        dptr += npts*2;
+    if (single) {
+        float *rptr = (float *)ret->data, *dptr = (float *)data->data;
+        float *wptr = (float *)wsave->data;
+
+        for (i = 0; i < nrepeats; i++) {
+            memcpy((char *)(rptr + 1), (dptr + 2), (npts - 1)*sizeof(float));
+            rptr[0] = dptr[0];
+            srfftb(npts, rptr, wptr);
+            rptr += npts;
+            dptr += npts*2;
+        }
+    }
+    else {
+        double *rptr = (double *)ret->data, *dptr = (double *)data->data;
+        double *wptr = (double *)wsave->data;
+
+        for (i = 0; i < nrepeats; i++) {
+            memcpy((char *)(rptr + 1), (dptr + 2), (npts - 1)*sizeof(double));
+            rptr[0] = dptr[0];
+            rfftb(npts, rptr, wptr);
+            rptr += npts;
+            dptr += npts*2;
+        }
     }
     NPY_SIGINT_OFF;
-    PyArray_Free(op2, (char *)wsave);
+    Py_DECREF(wsave);
     Py_DECREF(data);
     return (PyObject *)ret;
 
 fail:
-    PyArray_Free(op2, (char *)wsave);
+    Py_XDECREF(wsave);
     Py_XDECREF(data);
     Py_XDECREF(ret);
     return NULL;
@@ -275,7 +455,7 @@ fftpack_rffti(PyObject *NPY_UNUSED(self), PyObject *args)
       return NULL;
   }
   /*Magic size needed by rffti*/
-  dim = 2*n + 15;
+  dim = rffti_size(n);
   /*Create a 1 dimensional array of dimensions of type double*/
   op = (PyArrayObject *)PyArray_SimpleNew(1, &dim, PyArray_DOUBLE);
   if (op == NULL) {
@@ -288,6 +468,31 @@ fftpack_rffti(PyObject *NPY_UNUSED(self), PyObject *args)
   return (PyObject *)op;
 }
 
+static char fftpack_srffti__doc__[] ="";
+
+static PyObject *
+fftpack_srffti(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyArrayObject *op;
+    npy_intp dim;
+    long n;
+
+    if (!PyArg_ParseTuple(args, "l", &n)) {
+        return NULL;
+    }
+    /*Same magic size as rffti, in floats*/
+    dim = rffti_size(n);
+    op = (PyArrayObject *)PyArray_SimpleNew(1, &dim, PyArray_FLOAT);
+    if (op == NULL) {
+        return NULL;
+    }
+    NPY_SIGINT_ON;
+    srffti(n, (float *)((PyArrayObject*)op)->data);
+    NPY_SIGINT_OFF;
+
+    return (PyObject *)op;
+}
+
 
 /* List of methods defined in the module */
 
@@ -295,9 +500,12 @@ static struct PyMethodDef fftpack_methods[] = {
     {"cfftf",   fftpack_cfftf,  1,      fftpack_cfftf__doc__},
     {"cfftb",   fftpack_cfftb,  1,      fftpack_cfftb__doc__},
     {"cffti",   fftpack_cffti,  1,      fftpack_cffti__doc__},
+    {"scffti",  fftpack_scffti, 1,      fftpack_scffti__doc__},
+    {"cfftn",   fftpack_cfftn,  1,      fftpack_cfftn__doc__},
     {"rfftf",   fftpack_rfftf,  1,      fftpack_rfftf__doc__},
     {"rfftb",   fftpack_rfftb,  1,      fftpack_rfftb__doc__},
     {"rffti",   fftpack_rffti,  1,      fftpack_rffti__doc__},
+    {"srffti",  fftpack_srffti, 1,      fftpack_srffti__doc__},
     {NULL, NULL, 0, NULL}          /* sentinel */
 };
 
@@ -6,6 +6,7 @@ def configuration(parent_package = '', top_path = None):
 
     config.add_sconscript('SConstruct',
                           source_files = ['fftpack_litemodule.c', 'fftpack.c',
+                                          'fftpack_float.c',
                                           'fftpack.h'])
 
     return config
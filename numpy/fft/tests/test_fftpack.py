@@ -18,6 +18,69 @@ class TestFFT1D(TestCase):
         x = rand(30) + 1j*rand(30)
         assert_array_almost_equal(fft1(x), np.fft.fft(x))
 
+    def test_axis(self):
+        x = np.random.random((6, 20, 5)) + 1j*np.random.random((6, 20, 5))
+        y = np.fft.fft(x, axis=1)
+        for i in range(6):
+            for j in range(5):
+                assert_array_almost_equal(fft1(x[i, :, j]), y[i, :, j])
+        assert_array_almost_equal(np.fft.ifft(y, axis=1), x)
+
+    def test_large_prime_factor(self):
+        # sizes with prime factors > 100 use Bluestein's algorithm
+        for n in [211, 2*223, 1009]:
+            x = np.random.random(n) + 1j*np.random.random(n)
+            assert_array_almost_equal(fft1(x), np.fft.fft(x))
+            assert_array_almost_equal(np.fft.ifft(np.fft.fft(x)), x)
+            assert_array_almost_equal(np.fft.rfft(x.real),
+                                      np.fft.fft(x.real)[:n//2 + 1])
+            assert_array_almost_equal(np.fft.irfft(np.fft.rfft(x.real), n),
+                                      x.real)
+
+
+class TestFFTSingle(TestCase):
+    def test_complex64(self):
+        x = (np.random.random(30) + 1j*np.random.random(30)).astype(np.complex64)
+        y = np.fft.fft(x)
+        assert_equal(y.dtype, np.complex64)
+        assert_array_almost_equal(y, fft1(x.astype(complex)), decimal=4)
+        assert_equal(np.fft.ifft(y).dtype, np.complex64)
+        assert_array_almost_equal(np.fft.ifft(y), x, decimal=5)
+
+    def test_float32(self):
+        x = np.random.random((3, 97)).astype(np.float32)
+        y = np.fft.rfft(x)
+        assert_equal(y.dtype, np.complex64)
+        assert_array_almost_equal(y, np.fft.rfft(x.astype(float)), decimal=4)
+        z = np.fft.irfft(y, 97)
+        assert_equal(z.dtype, np.float32)
+        assert_array_almost_equal(z, x, decimal=5)
+        assert_equal(np.fft.fftn(x).dtype, np.complex64)
+        assert_equal(np.fft.rfftn(x).dtype, np.complex64)
+
+
+class TestFFTND(TestCase):
+    def test_fftn(self):
+        x = np.random.random((4, 33, 6)) + 1j*np.random.random((4, 33, 6))
+        y = x
+        for axis in range(3):
+            y = np.apply_along_axis(fft1, axis, y)
+        assert_array_almost_equal(np.fft.fftn(x), y)
+        assert_array_almost_equal(np.fft.ifftn(y), x)
+
+    def test_fft2_shape(self):
+        x = np.random.random((8, 9))
+        y = np.fft.fft2(x, s=(10, 4))
+        assert_equal(y.shape, (10, 4))
+        z = np.zeros((10, 9))
+        z[:8] = x
+        assert_array_almost_equal(y, np.fft.fft(np.fft.fft(z[:, :4], axis=0)))
+
+    def test_rfftn(self):
+        x = np.random.random((5, 6, 7))
+        assert_array_almost_equal(np.fft.rfftn(x), np.fft.fftn(x)[..., :4])
+        assert_array_almost_equal(np.fft.irfftn(np.fft.rfftn(x), x.shape), x)
+
 
 if __name__ == "__main__":
     run_module_suite()
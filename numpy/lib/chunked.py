@@ -0,0 +1,492 @@
+"""
+Chunked, compressed storage for big arrays on disk.
+
+An array is cut into blocks along a regular grid ("chunks") and each chunk
+is compressed on its own, so that slicing a stored array only reads and
+decompresses the chunks the slice touches.  This suits arrays much larger
+than memory that are only ever accessed a piece at a time; `numpy.memmap`
+and `format.open_memmap` need the flat, uncompressed layout instead.
+
+Format
+------
+The file starts like a ``.npy`` file (see `numpy.lib.format`), with its own
+magic string::
+
+    "\\x93NPCHK" major minor
+
+The version is 1.0.  It is followed by the little-endian unsigned short
+header length and the header itself, a Python literal dictionary padded
+with spaces to a multiple of 16 bytes and ended by a newline, with the
+keys of a ``.npy`` header plus:
+
+    "chunks" : tuple of int
+        The shape of a chunk.  Chunks at the upper edges of the array are
+        cut short rather than padded.
+    "codec" : str or None
+        ``"zlib"``, or None for chunks stored uncompressed.
+    "shuffle" : bool
+        Whether the bytes of each chunk were regrouped by their position
+        within an item before compression, all first bytes, then all second
+        bytes and so on.  This usually makes numeric data compress better
+        and faster.
+
+"fortran_order" is always False.  After the header comes the index, two
+little-endian 64-bit unsigned integers per chunk giving the offset of its
+data from the start of the magic string and its length, with the chunks in
+C order of the grid.  The offsets being relative, a stored array can be
+embedded anywhere in another file.
+The chunk data follows, each chunk holding its items in C order.
+
+"""
+
+__all__ = ['save_chunked', 'open_chunked', 'ChunkedArray']
+
+import sys
+import zlib
+import threading
+import Queue
+
+import numpy
+from numpy.lib import format
+from numpy.lib.utils import safe_eval
+from numpy.compat import asbytes
+
+MAGIC_PREFIX = asbytes('\x93NPCHK')
+MAGIC_LEN = len(MAGIC_PREFIX) + 2
+
+# Bytes in a chunk when the chunk shape is not given
+CHUNK_SIZE = 2**20
+
+_index_dtype = numpy.dtype('<u8')
+
+
+def default_chunks(shape, itemsize, nbytes=CHUNK_SIZE):
+    """ Pick a chunk shape of at most `nbytes` bytes for an array.
+
+    The largest dimension of the chunk is halved until it fits, which
+    keeps chunks close to cubic.
+    """
+    chunks = [max(n, 1) for n in shape]
+    size = itemsize
+    for n in chunks:
+        size *= n
+    while size > nbytes:
+        i = numpy.argmax(chunks)
+        if chunks[i] == 1:
+            break
+        half = (chunks[i] + 1) // 2
+        size = size // chunks[i] * half
+        chunks[i] = half
+    return tuple(chunks)
+
+def _grid(shape, chunks):
+    return tuple([-(-n // c) for n, c in zip(shape, chunks)])
+
+def _shuffle(data, itemsize):
+    if itemsize == 1:
+        return data
+    a = numpy.frombuffer(data, dtype=numpy.uint8)
+    return a.reshape(-1, itemsize).T.tostring()
+
+def _unshuffle(data, itemsize):
+    a = numpy.frombuffer(data, dtype=numpy.uint8)
+    if itemsize == 1:
+        return a
+    return a.reshape(itemsize, -1).T.copy()
+
+
+def save_chunked(file, arr, chunks=None, level=1, shuffle=True):
+    """
+    Save an array in chunks, each compressed on its own.
+
+    Parameters
+    ----------
+    file : str or file
+        The file name, or a file object open for writing that supports
+        `seek`.  The array is written at the current position.
+    arr : array_like
+        The array to store.  It is read one chunk at a time, so it can be a
+        `memmap` or anything else that supports slicing with `shape` and
+        `dtype` attributes.
+    chunks : tuple of int, optional
+        The shape of a chunk.  By default chunks are about `CHUNK_SIZE`
+        bytes.
+    level : int, optional
+        The zlib compression level from 0 to 9.  Level 0 stores the chunks
+        uncompressed; the default of 1 is the fastest that compresses.
+    shuffle : bool, optional
+        Whether to regroup the bytes of each chunk by their position within
+        an item before compressing.
+
+    See Also
+    --------
+    open_chunked
+
+    Examples
+    --------
+    >>> from tempfile import TemporaryFile
+    >>> f = TemporaryFile()
+    >>> x = np.arange(100.).reshape(10, 10)
+    >>> np.lib.chunked.save_chunked(f, x, chunks=(4, 4))
+    >>> f.seek(0)
+    >>> np.lib.chunked.open_chunked(f)[2:5, -1]
+    array([ 29.,  39.,  49.])
+
+    """
+    if not (hasattr(arr, 'shape') and hasattr(arr, 'dtype')):
+        arr = numpy.asanyarray(arr)
+    shape = tuple(arr.shape)
+    dtype = numpy.dtype(arr.dtype)
+    if dtype.hasobject:
+        raise ValueError("cannot store arrays with Python objects in chunks")
+    if chunks is None:
+        chunks = default_chunks(shape, dtype.itemsize)
+    chunks = tuple([int(c) for c in chunks])
+    if len(chunks) != len(shape) or min(chunks + (1,)) < 1:
+        raise ValueError("chunks must have one positive length per dimension")
+    if level < 0 or level > 9:
+        raise ValueError("level must be between 0 and 9")
+    codec = 'zlib'
+    if level == 0:
+        codec = None
+    shuffle = bool(shuffle and dtype.itemsize > 1)
+
+    own_file = isinstance(file, basestring)
+    if own_file:
+        fp = open(file, 'wb')
+    else:
+        fp = file
+    try:
+        d = dict(descr=format.dtype_to_descr(dtype), fortran_order=False,
+                 shape=shape, chunks=chunks, codec=codec, shuffle=shuffle)
+        start = fp.tell()
+        fp.write(MAGIC_PREFIX + asbytes('\x01\x00'))
+        format.write_array_header_1_0(fp, d)
+
+        grid = _grid(shape, chunks)
+        nchunks = int(numpy.multiply.reduce(grid))
+        index = numpy.zeros((nchunks, 2), dtype=_index_dtype)
+        index_pos = fp.tell()
+        fp.write(index.tostring())
+        offset = fp.tell()
+        for i, coord in enumerate(numpy.ndindex(*grid)):
+            sl = tuple([slice(k*c, (k+1)*c) for k, c in zip(coord, chunks)])
+            data = numpy.ascontiguousarray(arr[sl], dtype=dtype).tostring()
+            if shuffle:
+                data = _shuffle(data, dtype.itemsize)
+            if codec is not None:
+                data = zlib.compress(data, level)
+            fp.write(data)
+            index[i] = offset - start, len(data)
+            offset += len(data)
+        fp.seek(index_pos)
+        fp.write(index.tostring())
+        fp.seek(offset)
+    finally:
+        if own_file:
+            fp.close()
+
+
+def open_chunked(file, cache_size=64*2**20, prefetch=True):
+    """
+    Open an array stored with `save_chunked` for reading.
+
+    Parameters
+    ----------
+    file : str or file
+        The file name, or a file object open for reading that supports
+        `seek`, positioned at the start of the stored array.
+    cache_size : int, optional
+        How many bytes of decompressed chunks to keep around for later
+        slices.  The least recently used chunks are dropped first.
+    prefetch : bool, optional
+        Whether to read and decompress the chunks of a slice in a
+        background thread while earlier ones are copied out.
+
+    Returns
+    -------
+    array : ChunkedArray
+        The stored array, read lazily as it is sliced.
+
+    """
+    return ChunkedArray(file, cache_size, prefetch)
+
+
+class ChunkedArray(object):
+    """
+    Read-only view of an array stored with `save_chunked`.
+
+    Indexing with integers, slices and Ellipsis returns an ndarray, reading
+    only the chunks that the index touches.  `numpy.asarray` reads the
+    whole array, and `numpy.lib.Arrayterator` can iterate over it in
+    blocks.
+
+    Parameters
+    ----------
+    file : str or file
+        The file name, or a file object open for reading that supports
+        `seek`, positioned at the start of the stored array.
+    cache_size : int, optional
+        Bytes of decompressed chunks kept between slices.
+    prefetch : bool, optional
+        Whether to decompress chunks in a background thread.
+
+    Attributes
+    ----------
+    shape, dtype, ndim, size : as for ndarray
+    chunks : tuple of int
+        The shape of a chunk.
+
+    """
+    def __init__(self, file, cache_size=64*2**20, prefetch=True):
+        self._own_file = isinstance(file, basestring)
+        if self._own_file:
+            self._fp = open(file, 'rb')
+        else:
+            self._fp = file
+        try:
+            self._read_header()
+        except:
+            self.close()
+            raise
+        self.cache_size = cache_size
+        self.prefetch = prefetch
+        self._cache = {}
+        self._lru = []
+        self._cached_bytes = 0
+        self._lock = threading.Lock()
+
+    def _read_header(self):
+        fp = self._fp
+        self._start = fp.tell()
+        magic_str = fp.read(MAGIC_LEN)
+        if magic_str[:-2] != MAGIC_PREFIX:
+            msg = "the magic string is not correct; expected %r, got %r"
+            raise ValueError(msg % (MAGIC_PREFIX, magic_str[:-2]))
+        version = tuple(numpy.frombuffer(magic_str[-2:], numpy.uint8))
+        if version != (1, 0):
+            msg = "only support version (1,0) of chunked arrays, not %r"
+            raise ValueError(msg % (version,))
+        hlength = numpy.frombuffer(fp.read(2), dtype='<u2')
+        if len(hlength) != 1:
+            raise ValueError("EOF before reading array header length")
+        header = fp.read(int(hlength[0]))
+        try:
+            d = safe_eval(header)
+        except SyntaxError, e:
+            msg = "Cannot parse header: %r\nException: %r"
+            raise ValueError(msg % (header, e))
+        keys = d.keys()
+        keys.sort()
+        if keys != ['chunks', 'codec', 'descr', 'fortran_order', 'shape',
+                    'shuffle']:
+            msg = "Header does not contain the correct keys: %r"
+            raise ValueError(msg % (keys,))
+        if d['codec'] not in (None, 'zlib'):
+            raise ValueError("unknown codec %r" % (d['codec'],))
+        self.shape = tuple(d['shape'])
+        self.chunks = tuple(d['chunks'])
+        self.dtype = numpy.dtype(d['descr'])
+        if len(self.chunks) != len(self.shape):
+            raise ValueError("chunks do not match the shape: %r" % (d,))
+        self._codec = d['codec']
+        self._shuffle = d['shuffle']
+        self._grid = _grid(self.shape, self.chunks)
+        nchunks = int(numpy.multiply.reduce(self._grid))
+        data = fp.read(nchunks * 2 * _index_dtype.itemsize)
+        if len(data) != nchunks * 2 * _index_dtype.itemsize:
+            raise ValueError("EOF before reading the chunk index")
+        self._index = numpy.frombuffer(data, _index_dtype).reshape(-1, 2)
+
+    ndim = property(lambda self: len(self.shape))
+    size = property(lambda self: int(numpy.multiply.reduce(self.shape)))
+
+    def __len__(self):
+        if not self.shape:
+            raise TypeError("len() of unsized object")
+        return self.shape[0]
+
+    def __array__(self, dtype=None):
+        a = self[...]
+        if dtype is not None:
+            a = a.astype(dtype)
+        return a
+
+    def close(self):
+        """ Close the file, if it was opened by name. """
+        if self._own_file and self._fp is not None:
+            self._fp.close()
+        self._fp = None
+
+    def _chunk_shape(self, coord):
+        return tuple([min(c, n - k*c)
+                      for k, c, n in zip(coord, self.chunks, self.shape)])
+
+    def _load(self, coord):
+        """ Read and decompress one chunk. """
+        i = 0
+        for k, g in zip(coord, self._grid):
+            i = i*g + k
+        offset, nbytes = self._index[i]
+        self._lock.acquire()
+        try:
+            self._fp.seek(self._start + int(offset))
+            data = self._fp.read(int(nbytes))
+        finally:
+            self._lock.release()
+        if len(data) != nbytes:
+            raise ValueError("EOF while reading chunk %r" % (coord,))
+        if self._codec == 'zlib':
+            data = zlib.decompress(data)
+        if self._shuffle:
+            data = _unshuffle(data, self.dtype.itemsize)
+        a = numpy.frombuffer(data, dtype=self.dtype)
+        return a.reshape(self._chunk_shape(coord))
+
+    def _remember(self, coord, chunk):
+        if chunk.nbytes > self.cache_size:
+            return
+        self._cache[coord] = chunk
+        self._lru.append(coord)
+        self._cached_bytes += chunk.nbytes
+        while self._cached_bytes > self.cache_size:
+            old = self._lru.pop(0)
+            self._cached_bytes -= self._cache.pop(old).nbytes
+
+    def _lookup(self, coord):
+        chunk = self._cache.get(coord)
+        if chunk is not None:
+            self._lru.remove(coord)
+            self._lru.append(coord)
+        return chunk
+
+    def _normalize(self, index):
+        """ Turn an index into a (start, step, count, keep) per dimension. """
+        if not isinstance(index, tuple):
+            index = (index,)
+        n_ellipsis = len([i for i in index if i is Ellipsis])
+        if n_ellipsis > 1:
+            raise IndexError("an index can only have a single Ellipsis")
+        if n_ellipsis:
+            i = list(index).index(Ellipsis)
+            fill = (slice(None),) * (self.ndim - len(index) + 1)
+            index = index[:i] + fill + index[i+1:]
+        if len(index) > self.ndim:
+            raise IndexError("too many indices")
+        index = index + (slice(None),) * (self.ndim - len(index))
+        dims = []
+        for i, n in zip(index, self.shape):
+            if isinstance(i, slice):
+                start, stop, step = i.indices(n)
+                count = max(0, (stop - start + step - (step > 0) +
+                                (step < 0)) // step)
+                dims.append((start, step, count, True))
+            else:
+                try:
+                    k = int(i)
+                except TypeError:
+                    raise TypeError("chunked arrays can only be indexed "
+                                    "with integers, slices and Ellipsis")
+                if k < 0:
+                    k += n
+                if not 0 <= k < n:
+                    raise IndexError("index %d out of bounds" % i)
+                dims.append((k, 1, 1, False))
+        return dims
+
+    def _pieces(self, dims):
+        """ List (chunk coordinate, chunk index, output index) triples. """
+        per_dim = []
+        for (start, step, count, keep), c in zip(dims, self.chunks):
+            runs = []
+            j = 0
+            while j < count:
+                pos = start + j*step
+                k = pos // c
+                # items of the progression that fall inside chunk k
+                if step > 0:
+                    m = min(count - j, ((k+1)*c - 1 - pos) // step + 1)
+                else:
+                    m = min(count - j, (pos - k*c) // -step + 1)
+                first = pos - k*c
+                last = first + (m - 1)*step
+                if last + step < 0:
+                    stop = None
+                else:
+                    stop = last + step
+                runs.append((k, slice(first, stop, step), slice(j, j + m)))
+                j += m
+            per_dim.append(runs)
+        pieces = []
+        counts = [len(r) for r in per_dim]
+        if min(counts + [1]) == 0:
+            return pieces
+        for sel in numpy.ndindex(*counts):
+            runs = [per_dim[d][s] for d, s in enumerate(sel)]
+            pieces.append((tuple([r[0] for r in runs]),
+                           tuple([r[1] for r in runs]),
+                           tuple([r[2] for r in runs])))
+        return pieces
+
+    def __getitem__(self, index):
+        dims = self._normalize(index)
+        out = numpy.empty([d[2] for d in dims], dtype=self.dtype)
+        pieces = self._pieces(dims)
+
+        # hold on to the cached chunks, so that only the others need loading
+        loaded = {}
+        missing = []
+        for coord, chunk_index, out_index in pieces:
+            chunk = self._lookup(coord)
+            if chunk is None:
+                missing.append(coord)
+            else:
+                loaded[coord] = chunk
+        if self.prefetch and len(missing) > 1:
+            chunks, stop = self._prefetch(missing)
+        else:
+            chunks = None
+        try:
+            for coord, chunk_index, out_index in pieces:
+                chunk = loaded.get(coord)
+                if chunk is None:
+                    if chunks is not None:
+                        chunk = chunks.get()
+                        if isinstance(chunk, tuple):
+                            raise chunk[0], chunk[1], chunk[2]
+                    else:
+                        chunk = self._load(coord)
+                    self._remember(coord, chunk)
+                out[out_index] = chunk[chunk_index]
+        finally:
+            if chunks is not None:
+                # let the loader finish if it is waiting on a full queue
+                stop.append(True)
+                try:
+                    while True:
+                        chunks.get_nowait()
+                except Queue.Empty:
+                    pass
+        if self.ndim == 0 and index is not Ellipsis and Ellipsis not in index:
+            # as for ndarray, a[()] of a 0-d array is a scalar
+            return out[()]
+        if min([d[3] for d in dims] + [True]):
+            return out
+        return out[tuple([[slice(None), 0][not d[3]] for d in dims])]
+
+    def _prefetch(self, coords):
+        """ Load chunks in order in a background thread, into a queue. """
+        chunks = Queue.Queue(4)
+        stop = []
+        def worker():
+            try:
+                for coord in coords:
+                    if stop:
+                        return
+                    chunks.put(self._load(coord))
+            except:
+                chunks.put(sys.exc_info())
+        t = threading.Thread(target=worker)
+        t.setDaemon(True)
+        t.start()
+        return chunks, stop
@@ -144,6 +144,9 @@ from numpy.compat import asbytes, isfileobj
 
 MAGIC_PREFIX = asbytes('\x93NUMPY')
 MAGIC_LEN = len(MAGIC_PREFIX) + 2
+# Bytes of array data converted per read from or write to objects that are
+# not files
+BUFFER_SIZE = 2**20
 
 def magic(major, minor):
     """ Return the magic string for the given file format version.
@@ -366,9 +369,8 @@ def write_array(fp, array, version=(1,0)):
     """
     Write an array to an NPY file, including a header.
 
-    If the array is neither C-contiguous or Fortran-contiguous AND if the
-    filelike object is not a real file object, then this function will have
-    to copy data in memory.
+    If the filelike object is not a real file object, the data is copied
+    and written out in blocks of about `BUFFER_SIZE` bytes.
 
     Parameters
     ----------
@@ -403,14 +405,40 @@ def write_array(fp, array, version=(1,0)):
         if isfileobj(fp):
             array.T.tofile(fp)
         else:
-            fp.write(array.T.tostring('C'))
+            _write_blocks(fp, array.T)
     else:
         if isfileobj(fp):
             array.tofile(fp)
         else:
-            # XXX: We could probably chunk this using something like
-            # arrayterator.
-            fp.write(array.tostring('C'))
+            _write_blocks(fp, array)
+
+def _read_blocks(fp, array):
+    """ Fill a contiguous array with data read from fp, `BUFFER_SIZE` bytes
+    at a time.
+    """
+    buf = array.view(numpy.uint8)
+    nbytes = len(buf)
+    pos = 0
+    while pos < nbytes:
+        data = fp.read(min(BUFFER_SIZE, nbytes - pos))
+        if not data:
+            msg = "EOF: reading array data, expected %d bytes got %d"
+            raise ValueError(msg % (nbytes, pos))
+        buf[pos:pos+len(data)] = numpy.frombuffer(data, dtype=numpy.uint8)
+        pos += len(data)
+
+def _write_blocks(fp, array):
+    """ Write the data of an array in C order, a few leading rows at a time.
+
+    This avoids making a full contiguous copy of a large view.
+    """
+    if array.ndim == 0 or array.size == 0:
+        fp.write(array.tostring('C'))
+        return
+    rowsize = array.itemsize * (array.size // len(array))
+    step = max(BUFFER_SIZE // max(rowsize, 1), 1)
+    for i in range(0, len(array), step):
+        fp.write(array[i:i+step].tostring('C'))
 
 def read_array(fp):
     """
@@ -419,8 +447,8 @@ def read_array(fp):
     Parameters
     ----------
     fp : filelike object
-        If this is not a real file object, then this may take extra memory and
-        time.
+        If this is not a real file object, the data is read into the array
+        `BUFFER_SIZE` bytes at a time.
 
     Returns
     -------
@@ -452,11 +480,10 @@ def read_array(fp):
             # We can use the fast fromfile() function.
             array = numpy.fromfile(fp, dtype=dtype, count=count)
         else:
-            # This is not a real file. We have to read it the memory-intensive
-            # way.
-            # XXX: we can probably chunk this to avoid the memory hit.
-            data = fp.read(int(count * dtype.itemsize))
-            array = numpy.fromstring(data, dtype=dtype, count=count)
+            # This is not a real file.  Read it block by block straight into
+            # the array, so that the data is only held in memory once.
+            array = numpy.empty(count, dtype=dtype)
+            _read_blocks(fp, array)
 
         if fortran_order:
             array.shape = shape[::-1]
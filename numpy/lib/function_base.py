@@ -28,6 +28,7 @@ from numpy.core import atleast_1d, atleast_2d
 from numpy.lib.twodim_base import diag
 from _compiled_base import _insert, add_docstring
 from _compiled_base import digitize, bincount, interp as compiled_interp
+from _compiled_base import _histogram_uniform
 from arraysetops import setdiff1d
 from utils import deprecate
 import numpy as np
@@ -128,7 +129,8 @@ def histogram(a, bins=10, range=None, normed=False, weights=None):
             raise AttributeError(
                 'max must be larger than min in range parameter.')
 
-    if not iterable(bins):
+    uniform = not iterable(bins)
+    if uniform:
         if range is None:
             range = (a.min(), a.max())
         mn, mx = [mi+0.0 for mi in range]
@@ -147,6 +149,17 @@ def histogram(a, bins=10, range=None, normed=False, weights=None):
         ntype = int
     else:
         ntype = weights.dtype
+
+    # Equally spaced bins are found arithmetically in a single pass.
+    if uniform and a.dtype.kind in 'biuf' and \
+           (weights is None or weights.dtype.kind in 'biuf'):
+        n = _histogram_uniform(a, bins, weights).astype(ntype)
+        if normed:
+            db = array(np.diff(bins), float)
+            return n/(n*db).sum(), bins
+        else:
+            return n, bins
+
     n = np.zeros(bins.shape, ntype)
 
     block = 65536
@@ -299,11 +312,6 @@ def histogramdd(sample, bins=10, range=None, normed=False, weights=None):
         # Shift these points one bin to the left.
         Ncount[i][on_edge] -= 1
 
-    # Flattened histogram matrix (1D)
-    # Reshape is used so that overlarge arrays
-    # will raise an error.
-    hist = zeros(nbin, float).reshape(-1)
-
     # Compute the sample indices in the flattened histogram matrix.
     ni = nbin.argsort()
     shape = []
@@ -312,14 +320,12 @@ def histogramdd(sample, bins=10, range=None, normed=False, weights=None):
         xy += Ncount[ni[i]] * nbin[ni[i+1:]].prod()
     xy += Ncount[ni[-1]]
 
-    # Compute the number of repetitions in xy and assign it to the
-    # flattened histmat.
+    # Compute the number of repetitions in xy, which is the flattened
+    # histogram matrix.
     if len(xy) == 0:
         return zeros(nbin-2, int), edges
 
-    flatcount = bincount(xy, weights)
-    a = arange(len(flatcount))
-    hist[a] = flatcount
+    hist = bincount(xy, weights, minlength=nbin.prod()).astype(float)
 
     # Shape into a proper matrix
     hist = hist.reshape(sort(nbin))
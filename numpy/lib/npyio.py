@@ -4,6 +4,7 @@ __all__ = ['savetxt', 'loadtxt', 'genfromtxt', 'ndfromtxt', 'mafromtxt',
 
 import numpy as np
 import format
+import chunked
 import sys
 import os
 import sys
@@ -14,6 +15,7 @@ from operator import itemgetter
 from cPickle import load as _cload, loads
 from _datasource import DataSource
 from _compiled_base import packbits, unpackbits
+from numpy.core.multiarray import _readtext, _writetext
 
 from _iotools import LineSplitter, NameValidator, StringConverter, \
                      ConverterError, ConverterLockError, ConversionWarning, \
@@ -179,21 +181,28 @@ class NpzFile(object):
         self.f = BagObj(self)
 
     def __getitem__(self, key):
-        # FIXME: This seems like it will copy strings around
-        #   more than is strictly necessary.  The zipfile
-        #   will read the string and then
-        #   the format.read_array will copy the string
-        #   to another place in memory.
-        #   It would be better if the zipfile could read
-        #   (or at least uncompress) the data
-        #   directly into the array memory.
         member = 0
         if key in self._files:
             member = 1
         elif key in self.files:
             member = 1
             key += '.npy'
-        if member:
+        if member and hasattr(self.zip, 'open'):
+            # Stream arrays out of the archive into their memory, rather
+            # than reading the whole member into a string first.
+            fid = self.zip.open(key)
+            try:
+                magic = fid.read(len(format.MAGIC_PREFIX))
+            finally:
+                fid.close()
+            if magic != format.MAGIC_PREFIX:
+                return self.zip.read(key)
+            fid = self.zip.open(key)
+            try:
+                return format.read_array(fid)
+            finally:
+                fid.close()
+        elif member:
             bytes = self.zip.read(key)
             if bytes.startswith(format.MAGIC_PREFIX):
                 value = BytesIO(bytes)
@@ -253,7 +262,9 @@ def load(file, mmap_mode=None):
     Returns
     -------
     result : array, tuple, dict, etc.
-        Data stored in the file.
+        Data stored in the file.  Files written by
+        `numpy.lib.chunked.save_chunked` give a `ChunkedArray`, which
+        reads the data lazily as it is sliced.
 
     Raises
     ------
@@ -312,6 +323,11 @@ def load(file, mmap_mode=None):
             return format.open_memmap(file, mode=mmap_mode)
         else:
             return format.read_array(fid)
+    elif magic == chunked.MAGIC_PREFIX: # chunked array, read when sliced
+        if isinstance(file, basestring):
+            fid.close()
+            return chunked.open_chunked(file)
+        return chunked.open_chunked(fid)
     else:  # Try a pickle
         try:
             return _cload(fid)
@@ -495,6 +511,16 @@ def _getconv(dtype):
     else:
         return str
 
+def _readtext_types(dtypes):
+    """Whether `_readtext` converts all of `dtypes` itself."""
+    for dt in dtypes:
+        if dt.char == 'S':
+            if dt.itemsize == 0:
+                return False
+        elif dt.char not in '?bBhHiIlLqQfdg' or not dt.isnative:
+            return False
+    return True
+
 
 
 def loadtxt(fname, dtype=float, comments='#', delimiter=None,
@@ -635,7 +661,9 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         # Read until we find a line with some values, and use
         # it to estimate the number of columns, N.
         first_vals = None
+        lineno = skiprows - 1
         while not first_vals:
+            lineno += 1
             first_line = fh.readline()
             if not first_line: # EOF reached
                 raise IOError('End-of-file reached before encountering data.')
@@ -661,17 +689,38 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
                     continue
             converters[i] = conv
 
-        # Parse each line, including the first
-        for i, line in enumerate(itertools.chain([first_line], fh)):
-            vals = split_line(line)
-            if len(vals) == 0:
-                continue
+        # Without user converters, read the columns directly into arrays
+        # laid out as np.array would make them from the list of rows
+        if (not user_converters and hasattr(fh, 'read') and
+                _readtext_types(dtype_types) and
+                (len(dtype_types) == 1 and dtype.names is None or
+                 len(dtype_types) == N > 1)):
+            columns = _readtext(fh, asbytes(first_line),
+                                dtype_types * (N // len(dtype_types)),
+                                delimiter=delimiter, comments=comments,
+                                usecols=usecols or None, lineno=lineno)[0]
+            if len(dtype_types) > 1:
+                X = np.empty(len(columns[0]),
+                             dtype=np.dtype([('', t) for t in dtype_types]))
+                for (name, column) in zip(X.dtype.names, columns):
+                    X[name] = column
+            else:
+                X = np.empty((len(columns[0]), N), dtype=dtype)
+                for (i, column) in enumerate(columns):
+                    X[:, i] = column
+        else:
+            # Parse each line, including the first
+            for i, line in enumerate(itertools.chain([first_line], fh)):
+                vals = split_line(line)
+                if len(vals) == 0:
+                    continue
 
-            if usecols:
-                vals = [vals[i] for i in usecols]
+                if usecols:
+                    vals = [vals[i] for i in usecols]
 
-            # Convert each value according to its column and store
-            X.append(tuple([conv(val) for (conv, val) in zip(converters, vals)]))
+                # Convert each value according to its column and store
+                X.append(tuple([conv(val)
+                                for (conv, val) in zip(converters, vals)]))
     finally:
         if isstring:
             fh.close()
@@ -685,13 +734,13 @@ def loadtxt(fname, dtype=float, comments='#', delimiter=None,
         #
         # Then, view the array using the specified dtype.
         try:
-            X = np.array(X, dtype=np.dtype([('', t) for t in dtype_types]))
+            X = np.asarray(X, dtype=np.dtype([('', t) for t in dtype_types]))
             X = X.view(dtype)
         except TypeError:
             # In the case we have an object dtype
             X = np.array(X, dtype=dtype)
     else:
-        X = np.array(X, dtype)
+        X = np.asarray(X, dtype)
 
     X = np.squeeze(X)
     if unpack:
@@ -766,6 +815,8 @@ def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n'):
 
         ``o`` : signed octal
 
+        ``r`` : shortest representation that reads back to the same value
+
         ``s`` : string of characters
 
         ``u`` : unsigned decimal integer
@@ -840,8 +891,16 @@ def savetxt(fname, X, fmt='%.18e', delimiter=' ', newline='\n'):
         else:
             format = fmt
 
-    for row in X:
-        fh.write(asbytes(format % tuple(row) + newline))
+    # Format the numeric columns in C, and anything else row by row
+    if X.ndim == 2 and X.dtype.names is None:
+        columns = [X[:, i] for i in range(ncol)]
+    elif X.ndim == 1 and X.dtype.names is not None:
+        columns = [X[name] for name in X.dtype.names]
+    else:
+        columns = []
+    if not (columns and _writetext(fh, columns, asbytes(format + newline))):
+        for row in X:
+            fh.write(asbytes(format % tuple(row) + newline))
 
 import re
 def fromregex(file, regexp, dtype):
@@ -928,6 +987,50 @@ def fromregex(file, regexp, dtype):
 
 
 
+def _genfromtxt_invalid(invalid, nbrows, nbcols, skip_header, skip_footer,
+                        invalid_raise):
+    """Report the rows of genfromtxt with a wrong number of columns."""
+    if len(invalid) > 0:
+        # Construct the error message
+        template = "    Line #%%i (got %%i columns instead of %i)" % nbcols
+        if skip_footer > 0:
+            nbrows -= skip_footer
+            errmsg = [template % (i + skip_header + 1, nb)
+                      for (i, nb) in invalid if i < nbrows]
+        else:
+            errmsg = [template % (i + skip_header + 1, nb)
+                      for (i, nb) in invalid]
+        if len(errmsg):
+            errmsg.insert(0, "Some errors were detected !")
+            errmsg = "\n".join(errmsg)
+            # Raise an exception ?
+            if invalid_raise:
+                raise ValueError(errmsg)
+            # Issue a warning ?
+            else:
+                warnings.warn(errmsg, ConversionWarning)
+
+
+def _genfromtxt_finish(output, outputmask, converters, usemask, unpack):
+    """Mask the missing values of genfromtxt and shape its output."""
+    # Try to take care of the missing data we missed
+    names = output.dtype.names
+    if usemask and names:
+        for (name, conv) in zip(names or (), converters):
+            missing_values = [conv(_) for _ in conv.missing_values
+                              if _ != asbytes('')]
+            for mval in missing_values:
+                outputmask[name] |= (output[name] == mval)
+    # Construct the final array
+    if usemask:
+        from numpy.ma import MaskedArray
+        output = output.view(MaskedArray)
+        output._mask = outputmask
+    if unpack:
+        return output.squeeze().T
+    return output.squeeze()
+
+
 def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
                skiprows=0, skip_header=0, skip_footer=0, converters=None,
                missing='', missing_values=None, filling_values=None,
@@ -1315,12 +1418,71 @@ def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
 
     miss_chars = [_.missing_values for _ in converters]
 
+    # With a given dtype and the default converters, read the columns in C.
+    # A field that cannot be converted takes the filling value of its
+    # column, as with the _loose_call of the converters.
+    fills = None
+    if (dtype is not None and loose and not user_converters and
+            not autostrip and hasattr(fhd, 'read') and
+            (delimiter is None or _is_bytes_like(delimiter))):
+        if len(dtype_flat) > 1:
+            coltypes = dtype_flat
+        elif dtype.names is None:
+            coltypes = dtype_flat * nbcols
+        else:
+            coltypes = []
+        if len(coltypes) == nbcols and _readtext_types(coltypes):
+            try:
+                fills = [np.array(conv.default, dtype=t)
+                         for (conv, t) in zip(converters, coltypes)]
+            except (TypeError, ValueError):
+                fills = None
+    if fills is not None:
+        invalid = []
+        (columns, masks) = _readtext(fhd, asbytes(first_line), coltypes,
+                                     delimiter=delimiter or None,
+                                     comments=comments,
+                                     strip=asbytes(" \r\n"),
+                                     usecols=usecols or None,
+                                     exact=not usecols,
+                                     missing=usemask and miss_chars or None,
+                                     filling=fills, invalid=invalid,
+                                     boolwords=True)
+        if skip_footer > 0:
+            columns = [column[:-skip_footer] for column in columns]
+            if usemask:
+                masks = [mask[:-skip_footer] for mask in masks]
+        _genfromtxt_invalid(invalid, len(columns[0]), nbcols, skip_header,
+                            skip_footer, invalid_raise)
+        if names and dtype.names:
+            dtype.names = names
+        outputmask = None
+        if len(dtype_flat) > 1:
+            output = np.empty(len(columns[0]),
+                              dtype=[('', t) for t in dtype_flat])
+            for (name, column) in zip(output.dtype.names, columns):
+                output[name] = column
+            output = output.view(dtype)
+            if usemask:
+                rowmasks = np.empty(len(columns[0]),
+                                    dtype=[('', np.bool) for t in dtype_flat])
+                for (name, mask) in zip(rowmasks.dtype.names, masks):
+                    rowmasks[name] = mask
+                outputmask = rowmasks.view(make_mask_descr(dtype))
+        else:
+            output = np.column_stack(columns)
+            if usemask:
+                outputmask = np.column_stack(masks)
+        return _genfromtxt_finish(output, outputmask, converters, usemask,
+                                  unpack)
+
 
     # Initialize the output lists ...
     # ... rows
     rows = []
     append_to_rows = rows.append
     # ... masks
+    outputmask = None
     if usemask:
         masks = []
         append_to_masks = masks.append
@@ -1375,26 +1537,8 @@ def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
                         raise ConverterError(errmsg)
 
     # Check that we don't have invalid values
-    if len(invalid) > 0:
-        nbrows = len(rows)
-        # Construct the error message
-        template = "    Line #%%i (got %%i columns instead of %i)" % nbcols
-        if skip_footer > 0:
-            nbrows -= skip_footer
-            errmsg = [template % (i + skip_header + 1, nb)
-                      for (i, nb) in invalid if i < nbrows]
-        else:
-            errmsg = [template % (i + skip_header + 1, nb)
-                      for (i, nb) in invalid]
-        if len(errmsg):
-            errmsg.insert(0, "Some errors were detected !")
-            errmsg = "\n".join(errmsg)
-            # Raise an exception ?
-            if invalid_raise:
-                raise ValueError(errmsg)
-            # Issue a warning ?
-            else:
-                warnings.warn(errmsg, ConversionWarning)
+    _genfromtxt_invalid(invalid, len(rows), nbcols, skip_header, skip_footer,
+                        invalid_raise)
 
     # Convert each value according to the converter:
     # We want to modify the list in place to avoid creating a new one...
@@ -1499,22 +1643,7 @@ def genfromtxt(fname, dtype=float, comments='#', delimiter=None,
                 else:
                     mdtype = np.bool
                 outputmask = np.array(masks, dtype=mdtype)
-    # Try to take care of the missing data we missed
-    names = output.dtype.names
-    if usemask and names:
-        for (name, conv) in zip(names or (), converters):
-            missing_values = [conv(_) for _ in conv.missing_values
-                              if _ != asbytes('')]
-            for mval in missing_values:
-                outputmask[name] |= (output[name] == mval)
-    # Construct the final array
-    if usemask:
-        output = output.view(MaskedArray)
-        output._mask = outputmask
-    if unpack:
-        return output.squeeze().T
-    return output.squeeze()
-
+    return _genfromtxt_finish(output, outputmask, converters, usemask, unpack)
 
 
 def ndfromtxt(fname, **kwargs):
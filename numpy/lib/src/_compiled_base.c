@@ -3,30 +3,81 @@
 #include "numpy/noprefix.h"
 #include "npy_config.h"
 
+/*
+ * For monotonic bins the slot of x is the number of bins b with
+ * !(x < b) if the bins increase, or with x < b if they decrease.  Either
+ * way those bins form a prefix of the array, so the slot is found by
+ * bisection, or, for equally spaced bins, estimated arithmetically and
+ * then corrected against the actual bin edges.
+ */
+#define IN_SLOT_PREFIX_(x, b, incr) ((incr) ? !((x) < (b)) : ((x) < (b)))
+
 static intp
-incr_slot_(double x, double *bins, intp lbins)
+search_slot_(double x, double *bins, intp lbins, int incr)
 {
-    intp i;
+    intp imin = 0, imax = lbins;
 
-    for ( i = 0; i < lbins; i ++ ) {
-        if ( x < bins [i] ) {
-            return i;
+    while (imin < imax) {
+        intp imid = imin + ((imax - imin) >> 1);
+
+        if (IN_SLOT_PREFIX_(x, bins[imid], incr)) {
+            imin = imid + 1;
+        }
+        else {
+            imax = imid;
         }
     }
-    return lbins;
+    return imin;
 }
 
 static intp
-decr_slot_(double x, double * bins, intp lbins)
+uniform_slot_(double x, double *bins, intp lbins, int incr, double step)
+{
+    double t = (x - bins[0])/step;
+    intp k;
+
+    if (t >= lbins) {
+        k = lbins;
+    }
+    else if (t >= 0) {
+        k = (intp)t + 1;
+    }
+    else if (t < 0) {
+        k = 0;
+    }
+    else {
+        /* nan */
+        k = incr ? lbins : 0;
+    }
+    while (k > 0 && !IN_SLOT_PREFIX_(x, bins[k - 1], incr)) {
+        k--;
+    }
+    while (k < lbins && IN_SLOT_PREFIX_(x, bins[k], incr)) {
+        k++;
+    }
+    return k;
+}
+
+/*
+ * Return the spacing of bins if they are equally spaced to within rounding,
+ * as those made by linspace are, and 0 otherwise.
+ */
+static double
+uniform_step_(double *bins, intp lbins)
 {
+    double step = (bins[lbins - 1] - bins[0])/(lbins - 1);
+    double tol = 1e-8*fabs(step);
     intp i;
 
-    for ( i = lbins - 1; i >= 0; i -- ) {
-        if (x < bins [i]) {
-            return i + 1;
+    if (!(step != 0 && fabs(step) < HUGE_VAL)) {
+        return 0;
+    }
+    for (i = 1; i < lbins - 1; i++) {
+        if (!(fabs(bins[i] - (bins[0] + i*step)) <= tol)) {
+            return 0;
         }
     }
-    return 0;
+    return step;
 }
 
 static int
@@ -56,96 +107,229 @@ monotonic_(double * a, int lena)
 
 
 
-/* find the index of the maximum element of an integer array */
-static intp
-mxx (intp *i , intp len)
-{
-    intp mx = 0, max = i[0];
-    intp j;
-
-    for ( j = 1; j < len; j ++ ) {
-        if ( i [j] > max ) {
-            max = i [j];
-            mx = j;
-        }
-    }
-    return mx;
+/*
+ * Counting loops of bincount, one set per integer type so that the input
+ * is read in its native type instead of being converted to intp first.
+ *
+ * bincount_bounds_<tag> finds the bounds in a single pass and returns -1
+ * if a value is negative and -2 if one does not fit in an intp.
+ *
+ * For long inputs over few bins, consecutive equal values make every
+ * increment wait on the previous store to the same counter.  The counts
+ * are then spread over BINCOUNT_WAYS private arrays, which are summed at
+ * the end.  Weighted sums are always accumulated in order so that the
+ * result does not depend on the input length.
+ */
+#define BINCOUNT_WAYS 4
+#define BINCOUNT_MIN_LEN 65536
+#define BINCOUNT_MAX_SPREAD 65536
+
+#define BINCOUNT_TYPED(tag, type)                                       \
+static int                                                              \
+bincount_bounds_##tag(char *data, intp len, intp *max)                  \
+{                                                                       \
+    type *x = (type *)data, mn = x[0], mx = x[0];                       \
+    intp i;                                                             \
+                                                                        \
+    for (i = 1; i < len; i++) {                                         \
+        mn = (x[i] < mn) ? x[i] : mn;                                   \
+        mx = (x[i] > mx) ? x[i] : mx;                                   \
+    }                                                                   \
+    /* mn < 0, written so that it is not always false when unsigned */  \
+    if (mn < (type)1 && mn != (type)0) {                                \
+        return -1;                                                      \
+    }                                                                   \
+    /* only types at least as wide as intp can exceed it */             \
+    if (sizeof(type) >= sizeof(intp) &&                                 \
+            (npy_ulonglong)mx > (npy_ulonglong)NPY_MAX_INTP - 1) {      \
+        return -2;                                                      \
+    }                                                                   \
+    *max = (intp)mx;                                                    \
+    return 0;                                                           \
+}                                                                       \
+                                                                        \
+static void                                                             \
+bincount_count_##tag(char *data, intp len, intp *out, intp nout,        \
+                     intp *spread)                                      \
+{                                                                       \
+    type *x = (type *)data;                                             \
+    intp i, j;                                                          \
+                                                                        \
+    if (spread == NULL) {                                               \
+        for (i = 0; i < len; i++) {                                     \
+            out[x[i]]++;                                                \
+        }                                                               \
+        return;                                                         \
+    }                                                                   \
+    for (i = 0; i + BINCOUNT_WAYS <= len; i += BINCOUNT_WAYS) {         \
+        spread[x[i]]++;                                                 \
+        spread[nout + x[i + 1]]++;                                      \
+        spread[2*nout + x[i + 2]]++;                                    \
+        spread[3*nout + x[i + 3]]++;                                    \
+    }                                                                   \
+    for (; i < len; i++) {                                              \
+        out[x[i]]++;                                                    \
+    }                                                                   \
+    for (j = 0; j < nout; j++) {                                        \
+        out[j] += spread[j] + spread[nout + j] + spread[2*nout + j] +   \
+                  spread[3*nout + j];                                   \
+    }                                                                   \
+}                                                                       \
+                                                                        \
+static void                                                             \
+bincount_weight_##tag(char *data, intp len, double *w, double *out)     \
+{                                                                       \
+    type *x = (type *)data;                                             \
+    intp i;                                                             \
+                                                                        \
+    for (i = 0; i < len; i++) {                                         \
+        out[x[i]] += w[i];                                              \
+    }                                                                   \
 }
 
-/* find the index of the minimum element of an integer array */
-static intp
-mnx (intp *i , intp len)
+BINCOUNT_TYPED(byte, npy_byte)
+BINCOUNT_TYPED(ubyte, npy_ubyte)
+BINCOUNT_TYPED(short, npy_short)
+BINCOUNT_TYPED(ushort, npy_ushort)
+BINCOUNT_TYPED(int, npy_int)
+BINCOUNT_TYPED(uint, npy_uint)
+BINCOUNT_TYPED(long, npy_long)
+BINCOUNT_TYPED(ulong, npy_ulong)
+BINCOUNT_TYPED(longlong, npy_longlong)
+BINCOUNT_TYPED(ulonglong, npy_ulonglong)
+
+typedef struct {
+    int (*bounds)(char *, intp, intp *);
+    void (*count)(char *, intp, intp *, intp, intp *);
+    void (*weight)(char *, intp, double *, double *);
+} bincount_loops;
+
+#define BINCOUNT_LOOPS(tag)                                             \
+    {bincount_bounds_##tag, bincount_count_##tag, bincount_weight_##tag}
+
+/* Return the loops for an integer type number, NULL for other types */
+static const bincount_loops *
+bincount_get_loops(int type_num)
 {
-    intp mn = 0, min = i [0];
-    intp j;
-
-    for ( j = 1; j < len; j ++ )
-        if ( i [j] < min )
-            {min = i [j];
-                mn = j;}
-    return mn;
+    static const bincount_loops loops[] = {
+        BINCOUNT_LOOPS(byte), BINCOUNT_LOOPS(ubyte),
+        BINCOUNT_LOOPS(short), BINCOUNT_LOOPS(ushort),
+        BINCOUNT_LOOPS(int), BINCOUNT_LOOPS(uint),
+        BINCOUNT_LOOPS(long), BINCOUNT_LOOPS(ulong),
+        BINCOUNT_LOOPS(longlong), BINCOUNT_LOOPS(ulonglong)
+    };
+
+    if (type_num == PyArray_BOOL) {
+        /* booleans are stored as 0 or 1 in a single byte */
+        return &loops[1];
+    }
+    if (type_num < PyArray_BYTE || type_num > PyArray_ULONGLONG) {
+        return NULL;
+    }
+    return &loops[type_num - PyArray_BYTE];
 }
 
-
 /*
  * arr_bincount is registered as bincount.
  *
- * bincount accepts one or two arguments. The first is an array of
- * non-negative integers and the second, if present, is an array of weights,
- * which must be promotable to double.  Call these arguments list and
- * weight. Both must be one-dimensional with len(weight) == len(list). If
+ * bincount accepts one to three arguments. The first is an array of
+ * non-negative integers, the second, if present, is an array of weights,
+ * which must be promotable to double, and the third a minimum length of
+ * the output.  Call these arguments list, weight and minlength. list and
+ * weight must be one-dimensional with len(weight) == len(list). If
  * weight is not present then bincount(list)[i] is the number of occurrences
  * of i in list.  If weight is present then bincount(self,list, weight)[i]
  * is the sum of all weight[j] where list [j] == i.  Self is not used.
+ *
+ * Integer inputs of any size are counted in their own type; anything else
+ * must be safely castable to intp.
  */
 static PyObject *
 arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 {
     PyArray_Descr *type;
-    PyObject *list = NULL, *weight=Py_None;
-    PyObject *lst=NULL, *ans=NULL, *wts=NULL;
-    intp *numbers, *ians, len , mxi, mni, ans_size;
-    int i;
-    double *weights , *dans;
-    static char *kwlist[] = {"list", "weights", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|O",
-                kwlist, &list, &weight)) {
+    PyObject *list = NULL, *weight = Py_None, *mlength = Py_None;
+    PyObject *lst = NULL, *ans = NULL, *wts = NULL;
+    intp len, mx = -1, minlength = 0, ans_size;
+    intp *spread = NULL;
+    const bincount_loops *loops = NULL;
+    int status;
+    char *numbers;
+    static char *kwlist[] = {"list", "weights", "minlength", NULL};
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|OO",
+                kwlist, &list, &weight, &mlength)) {
+            goto fail;
+    }
+    if (mlength != Py_None) {
+        minlength = PyArray_PyIntAsIntp(mlength);
+        if (minlength == -1 && PyErr_Occurred()) {
+            goto fail;
+        }
+        if (minlength < 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "minlength must be non-negative");
             goto fail;
+        }
+    }
+    lst = PyArray_FromAny(list, NULL, 1, 1, CARRAY, NULL);
+    if (lst != NULL && PyArray_ISNOTSWAPPED(lst)) {
+        loops = bincount_get_loops(PyArray_TYPE(lst));
     }
-    if (!(lst = PyArray_ContiguousFromAny(list, PyArray_INTP, 1, 1))) {
+    if (loops == NULL) {
+        Py_XDECREF(lst);
+        PyErr_Clear();
+        if (!(lst = PyArray_ContiguousFromAny(list, PyArray_INTP, 1, 1))) {
             goto fail;
+        }
+        loops = bincount_get_loops(PyArray_INTP);
     }
     len = PyArray_SIZE(lst);
-    if (len < 1) {
+    if (len < 1 && minlength == 0) {
         PyErr_SetString(PyExc_ValueError,
                 "The first argument cannot be empty.");
         goto fail;
     }
-    numbers = (intp *) PyArray_DATA(lst);
-    mxi = mxx(numbers, len);
-    mni = mnx(numbers, len);
-    if (numbers[mni] < 0) {
-        PyErr_SetString(PyExc_ValueError,
-                "The first argument of bincount must be non-negative");
-        goto fail;
+    numbers = PyArray_DATA(lst);
+    if (len > 0) {
+        NPY_BEGIN_THREADS;
+        status = loops->bounds(numbers, len, &mx);
+        NPY_END_THREADS;
+        if (status == -1) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The first argument of bincount must be non-negative");
+            goto fail;
+        }
+        if (status == -2) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The first argument of bincount has too large values");
+            goto fail;
+        }
     }
-    ans_size = numbers [mxi] + 1;
-    type = PyArray_DescrFromType(PyArray_INTP);
+    ans_size = (mx + 1 > minlength) ? mx + 1 : minlength;
     if (weight == Py_None) {
+        type = PyArray_DescrFromType(PyArray_INTP);
         if (!(ans = PyArray_Zeros(1, &ans_size, type, 0))) {
             goto fail;
         }
-        ians = (intp *)(PyArray_DATA(ans));
-        for (i = 0; i < len; i++)
-            ians [numbers [i]] += 1;
-        Py_DECREF(lst);
+        if (len >= BINCOUNT_MIN_LEN && ans_size <= BINCOUNT_MAX_SPREAD) {
+            spread = (intp *)PyDataMem_NEW(BINCOUNT_WAYS*ans_size*
+                                           sizeof(intp));
+            if (spread != NULL) {
+                memset(spread, 0, BINCOUNT_WAYS*ans_size*sizeof(intp));
+            }
+        }
+        NPY_BEGIN_THREADS;
+        loops->count(numbers, len, (intp *)PyArray_DATA(ans), ans_size,
+                     spread);
+        NPY_END_THREADS;
+        PyDataMem_FREE(spread);
     }
     else {
         if (!(wts = PyArray_ContiguousFromAny(weight, PyArray_DOUBLE, 1, 1))) {
             goto fail;
         }
-        weights = (double *)PyArray_DATA (wts);
         if (PyArray_SIZE(wts) != len) {
             PyErr_SetString(PyExc_ValueError,
                     "The weights and list don't have the same length.");
@@ -155,13 +339,13 @@ arr_bincount(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
         if (!(ans = PyArray_Zeros(1, &ans_size, type, 0))) {
             goto fail;
         }
-        dans = (double *)PyArray_DATA (ans);
-        for (i = 0; i < len; i++) {
-            dans[numbers[i]] += weights[i];
-        }
-        Py_DECREF(lst);
+        NPY_BEGIN_THREADS;
+        loops->weight(numbers, len, (double *)PyArray_DATA(wts),
+                      (double *)PyArray_DATA(ans));
+        NPY_END_THREADS;
         Py_DECREF(wts);
     }
+    Py_DECREF(lst);
     return ans;
 
 fail:
@@ -171,6 +355,119 @@ fail:
     return NULL;
 }
 
+/*
+ * arr_histogram_uniform is registered as _histogram_uniform.
+ *
+ * _histogram_uniform(a, edges, weights=None) computes what histogram does
+ * for equally spaced edges, as made by linspace, in a single pass: the bin
+ * of each value is found arithmetically and then nudged by at most one
+ * against the actual edges, so values on an edge land exactly where the
+ * searchsorted based binning would put them.  Values outside the edges,
+ * and nans, are not counted; the last bin includes its right edge.
+ */
+static PyObject *
+arr_histogram_uniform(PyObject *NPY_UNUSED(self), PyObject *args,
+                      PyObject *kwds)
+{
+    PyObject *oa, *oedges, *oweights = Py_None;
+    PyObject *aa = NULL, *aedges = NULL, *aweights = NULL, *ans = NULL;
+    PyArray_Descr *type;
+    double *a, *edges, *w = NULL, *dans = NULL, lo, hi, scale, x;
+    intp len, nbins, i, k, *ians = NULL;
+    static char *kwlist[] = {"a", "edges", "weights", NULL};
+    NPY_BEGIN_THREADS_DEF;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|O", kwlist,
+                &oa, &oedges, &oweights)) {
+        return NULL;
+    }
+    if (!(aa = PyArray_ContiguousFromAny(oa, PyArray_DOUBLE, 1, 1))) {
+        goto fail;
+    }
+    if (!(aedges = PyArray_ContiguousFromAny(oedges, PyArray_DOUBLE, 1, 1))) {
+        goto fail;
+    }
+    len = PyArray_SIZE(aa);
+    nbins = PyArray_SIZE(aedges) - 1;
+    if (nbins < 1) {
+        PyErr_SetString(PyExc_ValueError, "edges must have two or more "
+                "elements");
+        goto fail;
+    }
+    a = (double *)PyArray_DATA(aa);
+    edges = (double *)PyArray_DATA(aedges);
+    lo = edges[0];
+    hi = edges[nbins];
+    if (!(lo < hi && hi - lo < HUGE_VAL)) {
+        PyErr_SetString(PyExc_ValueError,
+                "edges must be finite and increasing");
+        goto fail;
+    }
+    scale = nbins/(hi - lo);
+    if (oweights != Py_None) {
+        aweights = PyArray_ContiguousFromAny(oweights, PyArray_DOUBLE, 1, 1);
+        if (aweights == NULL) {
+            goto fail;
+        }
+        if (PyArray_SIZE(aweights) != len) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The weights and a don't have the same length.");
+            goto fail;
+        }
+        w = (double *)PyArray_DATA(aweights);
+        type = PyArray_DescrFromType(PyArray_DOUBLE);
+    }
+    else {
+        type = PyArray_DescrFromType(PyArray_INTP);
+    }
+    if (!(ans = PyArray_Zeros(1, &nbins, type, 0))) {
+        goto fail;
+    }
+    if (w != NULL) {
+        dans = (double *)PyArray_DATA(ans);
+    }
+    else {
+        ians = (intp *)PyArray_DATA(ans);
+    }
+
+    NPY_BEGIN_THREADS;
+    for (i = 0; i < len; i++) {
+        x = a[i];
+        if (!(x >= lo && x <= hi)) {
+            continue;
+        }
+        k = (intp)((x - lo)*scale);
+        if (k >= nbins) {
+            k = nbins - 1;
+        }
+        if (x < edges[k]) {
+            k--;
+        }
+        else if (x >= edges[k + 1] && k < nbins - 1) {
+            k++;
+        }
+        if (w != NULL) {
+            dans[k] += w[i];
+        }
+        else {
+            ians[k]++;
+        }
+    }
+    NPY_END_THREADS;
+
+    Py_DECREF(aa);
+    Py_DECREF(aedges);
+    Py_XDECREF(aweights);
+    return ans;
+
+fail:
+    Py_XDECREF(aa);
+    Py_XDECREF(aedges);
+    Py_XDECREF(aweights);
+    Py_XDECREF(ans);
+    return NULL;
+}
+
 
 /*
  * digitize (x, bins) returns an array of python integers the same
@@ -188,9 +485,12 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     double *dx, *dbins;
     intp lbins, lx;             /* lengths */
     intp *iret;
-    int m, i;
+    intp i;
+    int m;
+    double step;
     static char *kwlist[] = {"x", "bins", NULL};
     PyArray_Descr *type;
+    NPY_BEGIN_THREADS_DEF;
 
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &ox, &obins)) {
         goto fail;
@@ -219,7 +519,12 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
             goto fail;
     }
 
-    if (lbins == 1)  {
+    if (lbins == 0) {
+        for (i = 0; i < lx; i++) {
+            iret[i] = 0;
+        }
+    }
+    else if (lbins == 1)  {
         for (i = 0; i < lx; i++) {
             if (dx [i] >= dbins[0]) {
                 iret[i] = 1;
@@ -231,21 +536,24 @@ arr_digitize(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
     }
     else {
         m = monotonic_ (dbins, lbins);
-        if ( m == -1 ) {
-            for ( i = 0; i < lx; i ++ ) {
-                iret [i] = decr_slot_ ((double)dx[i], dbins, lbins);
-            }
+        if ( m == 0 ) {
+            PyErr_SetString(PyExc_ValueError,
+                    "The bins must be montonically increasing or decreasing");
+            goto fail;
         }
-        else if ( m == 1 ) {
+        step = uniform_step_(dbins, lbins);
+        NPY_BEGIN_THREADS;
+        if (step != 0) {
             for ( i = 0; i < lx; i ++ ) {
-                iret [i] = incr_slot_ ((double)dx[i], dbins, lbins);
+                iret [i] = uniform_slot_(dx[i], dbins, lbins, m == 1, step);
             }
         }
         else {
-            PyErr_SetString(PyExc_ValueError,
-                    "The bins must be montonically increasing or decreasing");
-            goto fail;
+            for ( i = 0; i < lx; i ++ ) {
+                iret [i] = search_slot_(dx[i], dbins, lbins, m == 1);
+            }
         }
+        NPY_END_THREADS;
     }
 
     Py_DECREF(ax);
@@ -407,39 +715,89 @@ fail:
     return NULL;
 }
 
-/** @brief Use bisection on a sorted array to find first entry > key.
+/** @brief Find the interval of a sorted array containing key.
  *
- * Use bisection to find an index i s.t. arr[i] <= key < arr[i + 1]. If there is
- * no such i the error returns are:
+ * Find the largest index i s.t. arr[i] <= key, so that arr[i] <= key <
+ * arr[i + 1] for keys inside the array. If there is no such i the error
+ * returns are:
  *     key < arr[0] -- -1
  *     key == arr[len - 1] -- len - 1
  *     key > arr[len - 1] -- len
- * The array is assumed contiguous and sorted in ascending order.
+ * Nan keys return -1. The array is assumed contiguous and sorted in
+ * ascending order.
+ *
+ * The search starts from guess, normally the result for the previous key.
+ * The guess and the interval after it are tested first, which settles
+ * sorted or clustered keys in O(1); otherwise the bracket around the
+ * guess is grown exponentially and then bisected, so that unsorted keys
+ * still cost O(log(len)).
  *
  * @param key key value.
  * @param arr contiguous sorted array to be searched.
  * @param len length of the array.
+ * @param guess initial guess of index
  * @return index
  */
 static npy_intp
-binary_search(double key, double arr [], npy_intp len)
+binary_search_with_guess(double key, double arr [], npy_intp len,
+                         npy_intp guess)
 {
-    npy_intp imin = 0;
-    npy_intp imax = len;
+    npy_intp imin, imax, step = 1;
 
     if (key > arr[len - 1]) {
         return len;
     }
-    while (imin < imax) {
+    else if (!(key >= arr[0])) {
+        return -1;
+    }
+
+    if (guess < 0) {
+        guess = 0;
+    }
+    else if (guess > len - 1) {
+        guess = len - 1;
+    }
+
+    if (key >= arr[guess]) {
+        if (guess == len - 1 || key < arr[guess + 1]) {
+            return guess;
+        }
+        /* arr[imin] <= key, and key < arr[imax] unless imax == len */
+        imin = guess + 1;
+        imax = imin + step;
+        while (imax < len && key >= arr[imax]) {
+            imin = imax;
+            step <<= 1;
+            imax = imin + step;
+        }
+        if (imax > len) {
+            imax = len;
+        }
+    }
+    else {
+        /* key < arr[imax], and arr[imin] <= key since arr[0] <= key */
+        imax = guess;
+        imin = imax - step;
+        while (imin > 0 && key < arr[imin]) {
+            imax = imin;
+            step <<= 1;
+            imin = imax - step;
+        }
+        if (imin < 0) {
+            imin = 0;
+        }
+    }
+
+    while (imax - imin > 1) {
         npy_intp imid = imin + ((imax - imin) >> 1);
         if (key >= arr[imid]) {
-            imin = imid + 1;
+            imin = imid;
         }
         else {
             imax = imid;
         }
     }
-    return imin - 1;
+    return imin;
 }
 
 static PyObject *
@@ -451,7 +809,10 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     PyArrayObject *afp = NULL, *axp = NULL, *ax = NULL, *af = NULL;
     npy_intp i, lenx, lenxp, indx;
     double lval, rval;
-    double *dy, *dx, *dz, *dres, *slopes;
+    double *dy, *dx, *dres, *slopes;
+    void *dz;
+    int xfloat;
+    NPY_BEGIN_THREADS_DEF;
 
     static char *kwlist[] = {"x", "xp", "fp", "left", "right", NULL};
 
@@ -468,7 +829,10 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     if (axp == NULL) {
         goto fail;
     }
-    ax = (NPY_AO*)PyArray_ContiguousFromAny(x, NPY_DOUBLE, 1, 0);
+    /* single precision x is read as is rather than through a double copy */
+    xfloat = PyArray_Check(x) && PyArray_TYPE(x) == NPY_FLOAT;
+    ax = (NPY_AO*)PyArray_ContiguousFromAny(x,
+            xfloat ? NPY_FLOAT : NPY_DOUBLE, 1, 0);
     if (ax == NULL) {
         goto fail;
     }
@@ -492,7 +856,7 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
 
     dy = (double *)PyArray_DATA(afp);
     dx = (double *)PyArray_DATA(axp);
-    dz = (double *)PyArray_DATA(ax);
+    dz = PyArray_DATA(ax);
     dres = (double *)PyArray_DATA(af);
 
     /* Get left and right fill values. */
@@ -516,24 +880,38 @@ arr_interp(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwdict)
     }
 
     slopes = (double *) PyDataMem_NEW((lenxp - 1)*sizeof(double));
+    if (slopes == NULL && lenxp > 1) {
+        PyErr_NoMemory();
+        goto fail;
+    }
+
+    NPY_BEGIN_THREADS;
     for (i = 0; i < lenxp - 1; i++) {
         slopes[i] = (dy[i + 1] - dy[i])/(dx[i + 1] - dx[i]);
     }
+    /*
+     * Each search starts from the previous interval, so sorted x is
+     * interpolated in a single merge-like pass over xp.
+     */
+    indx = 0;
     for (i = 0; i < lenx; i++) {
-        indx = binary_search(dz[i], dx, lenxp);
+        const double x_val = xfloat ? ((float *)dz)[i] : ((double *)dz)[i];
+
+        indx = binary_search_with_guess(x_val, dx, lenxp, indx);
         if (indx == -1) {
             dres[i] = lval;
         }
-        else if (indx == lenxp - 1) {
-            dres[i] = dy[indx];
-        }
         else if (indx == lenxp) {
             dres[i] = rval;
         }
+        else if (indx == lenxp - 1) {
+            dres[i] = dy[indx];
+        }
         else {
-            dres[i] = slopes[indx]*(dz[i] - dx[indx]) + dy[indx];
+            dres[i] = slopes[indx]*(x_val - dx[indx]) + dy[indx];
         }
     }
+    NPY_END_THREADS;
 
     PyDataMem_FREE(slopes);
     Py_DECREF(afp);
@@ -641,6 +1019,47 @@ arr_add_docstring(PyObject *NPY_UNUSED(dummy), PyObject *args)
 }
 
 
+/*
+ * Byte tables for the bit packing routines, indexed by bit order, 0 for
+ * big (first element in the most significant bit) and 1 for little.
+ *
+ * unpack_lookup[order][byte] holds the eight 0/1 values the byte unpacks
+ * to, so that a contiguous unpack is one 8 byte copy per input byte.
+ *
+ * pack_gather[order] is a multiplier that moves the low bits of the eight
+ * bytes of a word loaded from memory into its top byte in element order:
+ * each low bit lands in a distinct bit of the product, so there are no
+ * carries and the shifted product is the packed byte.
+ */
+static unsigned char unpack_lookup[2][256][8];
+static npy_uint64 pack_gather[2];
+
+static void
+init_bit_tables(void)
+{
+    int order, i, k;
+
+    for (order = 0; order < 2; order++) {
+        pack_gather[order] = 0;
+        for (i = 0; i < 8; i++) {
+            /* significance of element i in a word loaded from memory */
+#if NPY_BYTE_ORDER == NPY_BIG_ENDIAN
+            int pos = 7 - i;
+#else
+            int pos = i;
+#endif
+            int bit = order ? i : 7 - i;
+
+            pack_gather[order] |= (npy_uint64)1 << (8*(7 - pos) + bit);
+        }
+        for (k = 0; k < 256; k++) {
+            for (i = 0; i < 8; i++) {
+                unpack_lookup[order][k][i] = (k >> (order ? i : 7 - i)) & 1;
+            }
+        }
+    }
+}
+
 /*  PACKBITS
  *
  *  This function packs binary (0 or 1) 1-bit per pixel arrays
@@ -655,45 +1074,57 @@ _packbits( void *In,
            npy_intp in_stride,
            void *Out,
            npy_intp out_N,
-           npy_intp out_stride
+           npy_intp out_stride,
+           int little
 )
 {
-    char build;
-    int i, index;
-    npy_intp out_Nm1;
-    int maxi, remain, nonzero, j;
+    unsigned char build;
+    npy_intp index = 0;
+    int i, j, maxi, nonzero;
     char *outptr,*inptr;
 
     outptr = Out;    /* pointer to output buffer */
     inptr  = In;     /* pointer to input buffer */
 
     /*
-     * Loop through the elements of In
+     * Contiguous bytes are packed eight at a time: the high bit of each
+     * byte of the word is set if the byte is nonzero, and the gather
+     * multiplication collects those bits into the output byte.
+     */
+    if (element_size == 1 && in_stride == 1) {
+        const npy_uint64 ones = ~(npy_uint64)0/255;
+        const npy_uint64 low7 = 0x7f*ones;
+        const npy_uint64 gather = pack_gather[little];
+        npy_intp nfull = in_N >> 3;
+        npy_uint64 v;
+
+        for (; index < nfull; index++) {
+            memcpy(&v, inptr, 8);
+            v = ((((v & low7) + low7) | v) >> 7) & ones;
+            *outptr = (char)((v*gather) >> 56);
+            outptr += out_stride;
+            inptr += 8;
+        }
+    }
+
+    /*
+     * Loop through the remaining elements of In
      * Determine whether or not it is nonzero.
-     *  Yes: set correspdoning bit (and adjust build value)
+     *  Yes: set correspdoning bit
      *  No:  move on
      * Every 8th value, set the value of build and increment the outptr
      */
-
-    remain = in_N % 8;                      /* uneven bits */
-    if (remain == 0) {
-        remain = 8;
-    }
-    out_Nm1 = out_N - 1;
-    for (index = 0; index < out_N; index++) {
+    for (; index < out_N; index++) {
         build = 0;
-        maxi = (index != out_Nm1 ? 8 : remain);
+        maxi = (in_N - (index << 3) < 8 ? (int)(in_N - (index << 3)) : 8);
         for (i = 0; i < maxi; i++) {
-            build <<= 1;
             nonzero = 0;
             for (j = 0; j < element_size; j++) {
-                nonzero += (*(inptr++) != 0);
+                nonzero |= (inptr[j] != 0);
             }
-            inptr += (in_stride - element_size);
-            build += (nonzero != 0);
+            inptr += in_stride;
+            build |= nonzero << (little ? i : 7 - i);
         }
-        if (index == out_Nm1) build <<= (8-remain);
-        /* printf("Here: %d %d %d %d\n",build,slice,index,maxi); */
         *outptr = build;
         outptr += out_stride;
     }
@@ -708,21 +1139,30 @@ _unpackbits(void *In,
         npy_intp in_stride,
         void *Out,
         npy_intp NPY_UNUSED(out_N),
-        npy_intp out_stride
+        npy_intp out_stride,
+        int little
         )
 {
-    unsigned char mask;
-    int i, index;
+    npy_intp index;
+    int i;
     char *inptr, *outptr;
+    const unsigned char *bits;
 
     outptr = Out;
     inptr  = In;
+    if (out_stride == 1) {
+        for (index = 0; index < in_N; index++) {
+            memcpy(outptr, unpack_lookup[little][(unsigned char)*inptr], 8);
+            outptr += 8;
+            inptr += in_stride;
+        }
+        return;
+    }
     for (index = 0; index < in_N; index++) {
-        mask = 128;
+        bits = unpack_lookup[little][(unsigned char)*inptr];
         for (i = 0; i < 8; i++) {
-            *outptr = ((mask & (unsigned char)(*inptr)) != 0);
+            *outptr = bits[i];
             outptr += out_stride;
-            mask >>= 1;
         }
         inptr += in_stride;
     }
@@ -731,15 +1171,17 @@ _unpackbits(void *In,
 
 /* Fixme -- pack and unpack should be separate routines */
 static PyObject *
-pack_or_unpack_bits(PyObject *input, int axis, int unpack)
+pack_or_unpack_bits(PyObject *input, int axis, int unpack, int little)
 {
     PyArrayObject *inp;
     PyObject *new = NULL;
     PyObject *out = NULL;
     npy_intp outdims[MAX_DIMS];
     int i;
-    void (*thefunc)(void *, int, npy_intp, npy_intp, void *, npy_intp, npy_intp);
+    void (*thefunc)(void *, int, npy_intp, npy_intp, void *, npy_intp,
+                    npy_intp, int);
     PyArrayIterObject *it, *ot;
+    NPY_BEGIN_THREADS_DEF;
 
     inp = (PyArrayObject *)PyArray_FROM_O(input);
 
@@ -753,9 +1195,9 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
             goto fail;
         }
     }
-    else if (!PyArray_ISINTEGER(inp)) {
+    else if (!PyArray_ISINTEGER(inp) && !PyArray_ISBOOL(inp)) {
         PyErr_SetString(PyExc_TypeError,
-                "Expected an input array of integer data type");
+                "Expected an input array of integer or boolean data type");
         goto fail;
     }
 
@@ -831,6 +1273,29 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
     if (out == NULL) {
         goto fail;
     }
+
+    /*
+     * When the axis is the last one of C contiguous arrays the slices are
+     * consecutive, so step through them directly instead of iterating.
+     */
+    if (axis == PyArray_NDIM(new) - 1 && PyArray_ISCONTIGUOUS(new) &&
+            PyArray_ISCONTIGUOUS(out)) {
+        char *iptr = PyArray_DATA(new), *optr = PyArray_DATA(out);
+        npy_intp in_N = PyArray_DIM(new, axis), out_N = PyArray_DIM(out, axis);
+        npy_intp nslices = PyArray_SIZE(new)/in_N;
+        npy_intp k;
+
+        NPY_BEGIN_THREADS;
+        for (k = 0; k < nslices; k++) {
+            thefunc(iptr, PyArray_ITEMSIZE(new), in_N, PyArray_ITEMSIZE(new),
+                    optr, out_N, 1, little);
+            iptr += in_N*PyArray_ITEMSIZE(new);
+            optr += out_N;
+        }
+        NPY_END_THREADS;
+        goto finish;
+    }
+
     /* Setup iterators to iterate over all but given axis */
     it = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)new, &axis);
     ot = (PyArrayIterObject *)PyArray_IterAllButAxis((PyObject *)out, &axis);
@@ -840,14 +1305,16 @@ pack_or_unpack_bits(PyObject *input, int axis, int unpack)
         goto fail;
     }
 
+    NPY_BEGIN_THREADS;
     while(PyArray_ITER_NOTDONE(it)) {
         thefunc(PyArray_ITER_DATA(it), PyArray_ITEMSIZE(new),
                 PyArray_DIM(new, axis), PyArray_STRIDE(new, axis),
                 PyArray_ITER_DATA(ot), PyArray_DIM(out, axis),
-                PyArray_STRIDE(out, axis));
+                PyArray_STRIDE(out, axis), little);
         PyArray_ITER_NEXT(it);
         PyArray_ITER_NEXT(ot);
     }
+    NPY_END_THREADS;
     Py_DECREF(it);
     Py_DECREF(ot);
 
@@ -862,18 +1329,41 @@ fail:
 }
 
 
+/*
+ * Convert the bitorder argument of packbits and unpackbits, returning 1
+ * for little, 0 for big and -1 with an exception set otherwise.
+ */
+static int
+bitorder_converter(const char *order)
+{
+    if (order == NULL || strcmp(order, "big") == 0) {
+        return 0;
+    }
+    else if (strcmp(order, "little") == 0) {
+        return 1;
+    }
+    PyErr_SetString(PyExc_ValueError,
+            "bitorder must be either 'big' or 'little'");
+    return -1;
+}
+
 static PyObject *
 io_pack(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 {
     PyObject *obj;
     int axis = NPY_MAXDIMS;
-    static char *kwlist[] = {"in", "axis", NULL};
+    char *order = NULL;
+    int little;
+    static char *kwlist[] = {"in", "axis", "bitorder", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&" , kwlist,
-                &obj, PyArray_AxisConverter, &axis)) {
+    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&s" , kwlist,
+                &obj, PyArray_AxisConverter, &axis, &order)) {
         return NULL;
     }
-    return pack_or_unpack_bits(obj, axis, 0);
+    if ((little = bitorder_converter(order)) < 0) {
+        return NULL;
+    }
+    return pack_or_unpack_bits(obj, axis, 0, little);
 }
 
 static PyObject *
@@ -881,13 +1371,18 @@ io_unpack(PyObject *NPY_UNUSED(self), PyObject *args, PyObject *kwds)
 {
     PyObject *obj;
     int axis = NPY_MAXDIMS;
-    static char *kwlist[] = {"in", "axis", NULL};
+    char *order = NULL;
+    int little;
+    static char *kwlist[] = {"in", "axis", "bitorder", NULL};
 
-    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&" , kwlist,
-                &obj, PyArray_AxisConverter, &axis)) {
+    if (!PyArg_ParseTupleAndKeywords( args, kwds, "O|O&s" , kwlist,
+                &obj, PyArray_AxisConverter, &axis, &order)) {
+        return NULL;
+    }
+    if ((little = bitorder_converter(order)) < 0) {
         return NULL;
     }
-    return pack_or_unpack_bits(obj, axis, 1);
+    return pack_or_unpack_bits(obj, axis, 1, little);
 }
 
 static struct PyMethodDef methods[] = {
@@ -895,6 +1390,8 @@ static struct PyMethodDef methods[] = {
         METH_VARARGS | METH_KEYWORDS, arr_insert__doc__},
     {"bincount", (PyCFunction)arr_bincount,
         METH_VARARGS | METH_KEYWORDS, NULL},
+    {"_histogram_uniform", (PyCFunction)arr_histogram_uniform,
+        METH_VARARGS | METH_KEYWORDS, NULL},
     {"digitize", (PyCFunction)arr_digitize,
         METH_VARARGS | METH_KEYWORDS, NULL},
     {"interp", (PyCFunction)arr_interp,
@@ -971,6 +1468,8 @@ init_compiled_base(void)
     /* Import the array objects */
     import_array();
 
+    init_bit_tables();
+
     /* Add some symbolic constants to the module */
     d = PyModule_GetDict(m);
 
@@ -0,0 +1,92 @@
+import os
+import sys
+import tempfile
+
+if sys.version_info[0] >= 3:
+    from io import BytesIO as StringIO
+else:
+    from cStringIO import StringIO
+
+import numpy as np
+from numpy.testing import *
+from numpy.lib.chunked import save_chunked, open_chunked, ChunkedArray
+
+
+def roundtrip(a, **kwargs):
+    f = StringIO()
+    save_chunked(f, a, **kwargs)
+    f.seek(0)
+    return open_chunked(f)
+
+class TestChunked(TestCase):
+    def test_roundtrip(self):
+        for dt in ['f8', '>i4', 'u1', 'c16',
+                   [('a', 'i4'), ('b', 'f4', (2,))]]:
+            a = np.zeros((7, 5, 3), dtype=dt)
+            a.view(np.uint8).flat = np.arange(a.nbytes) % 251
+            for kwargs in [dict(chunks=(2, 3, 1)), dict(level=0),
+                           dict(chunks=(7, 5, 3), shuffle=False, level=9)]:
+                c = roundtrip(a, **kwargs)
+                assert_equal(c.shape, a.shape)
+                assert_equal(c.dtype, a.dtype)
+                assert_array_equal(np.asarray(c), a)
+
+    def test_slicing(self):
+        a = np.arange(11*13*4).reshape(11, 13, 4) % 37
+        c = roundtrip(a, chunks=(3, 5, 3))
+        for index in [np.s_[...], np.s_[2], np.s_[-1, 3:9], np.s_[::-1],
+                      np.s_[1:10:4, ::-3, 2], np.s_[..., 1],
+                      np.s_[5, 7, 3], np.s_[8:2:-2, :0], np.s_[:, 12:, -2:]]:
+            assert_array_equal(c[index], a[index])
+        assert_equal(c[5, 7, 3], a[5, 7, 3])
+        assert_raises(IndexError, c.__getitem__, np.s_[11])
+        assert_raises(IndexError, c.__getitem__, np.s_[0, 0, 0, 0])
+        assert_raises(TypeError, c.__getitem__, [0, 1])
+
+    def test_edge_shapes(self):
+        for a in [np.array(3.5), np.zeros((0, 4)), np.arange(1)]:
+            c = roundtrip(a)
+            assert_array_equal(c[...], a)
+        assert_equal(roundtrip(np.array(3.5))[()], 3.5)
+
+    def test_cache_and_prefetch(self):
+        a = np.arange(64*64.).reshape(64, 64)
+        for cache_size in [0, 8*16*16, 2**20]:
+            for prefetch in [False, True]:
+                f = StringIO()
+                save_chunked(f, a, chunks=(16, 16))
+                f.seek(0)
+                c = open_chunked(f, cache_size=cache_size, prefetch=prefetch)
+                for i in range(3):
+                    assert_array_equal(c[5:60:3, 10:], a[5:60:3, 10:])
+                    assert_array_equal(c[20], a[20])
+                assert_(c._cached_bytes <= cache_size)
+
+    def test_embedded(self):
+        # chunk offsets are relative to the start of the stored array
+        a = np.arange(30*20).reshape(30, 20)
+        prefix = np.array('some other data').tostring()
+        f = StringIO()
+        f.write(prefix)
+        save_chunked(f, a, chunks=(7, 6))
+        f.seek(len(prefix))
+        assert_array_equal(open_chunked(f)[3:25, ::3], a[3:25, ::3])
+        c = open_chunked(StringIO(f.getvalue()[len(prefix):]))
+        assert_array_equal(c[...], a)
+
+    def test_load(self):
+        fd, name = tempfile.mkstemp()
+        os.close(fd)
+        try:
+            a = np.arange(1000).reshape(10, 100)
+            save_chunked(name, a, chunks=(3, 30))
+            c = np.load(name)
+            assert_(isinstance(c, ChunkedArray))
+            assert_array_equal(c[2:7, 95:], a[2:7, 95:])
+            c.close()
+        finally:
+            os.unlink(name)
+
+
+if __name__ == "__main__":
+    run_module_suite()
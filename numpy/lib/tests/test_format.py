@@ -466,6 +466,33 @@ def test_memmap_roundtrip():
             #del ma
 
 
+def test_roundtrip_large_views():
+    # views bigger than the write buffers, to real files and file-likes
+    a = np.arange(3*300*500, dtype='>f8').reshape(3, 300, 500)
+    views = [a[:, ::2, 1::3], a.transpose(2, 0, 1), a[::-1, :, ::7], a[1, 5]]
+    fn = os.path.join(tempdir, 'view.npy')
+    for v in views:
+        yield assert_array_equal, roundtrip(v), v
+        fp = open(fn, 'wb')
+        try:
+            format.write_array(fp, v)
+        finally:
+            fp.close()
+        fp = open(fn, 'rb')
+        try:
+            yield assert_array_equal, format.read_array(fp), v
+        finally:
+            fp.close()
+
+
+def test_read_truncated():
+    f = StringIO()
+    format.write_array(f, np.arange(2*format.BUFFER_SIZE, dtype=np.int16))
+    for n in [20, 100, 3*format.BUFFER_SIZE]:
+        f2 = StringIO(f.getvalue()[:n])
+        assert_raises(ValueError, format.read_array, f2)
+
+
 def test_write_version_1_0():
     f = StringIO()
     arr = np.arange(1)
@@ -409,6 +409,25 @@ class TestDigitize(TestCase):
         bin = linspace(x.min(), x.max(), 10)
         assert all(digitize(x, bin) != 0)
 
+    def test_uniform_bins(self):
+        # equally spaced bins take an arithmetic path, which must agree
+        # with the search used for general bins
+        x = np.r_[np.linspace(-1, 11, 1001), np.arange(11), np.nan]
+        bins = np.linspace(0, 10, 11)
+        irregular = bins.copy()
+        irregular[1] = 0.5
+        ref = np.array([(~(xi < bins)).sum() for xi in x])
+        assert_array_equal(digitize(x, bins), ref)
+        ref = np.array([(~(xi < irregular)).sum() for xi in x])
+        assert_array_equal(digitize(x, irregular), ref)
+        ref = np.array([(xi < bins[::-1]).sum() for xi in x])
+        assert_array_equal(digitize(x, bins[::-1]), ref)
+
+    def test_repeated_bins(self):
+        x = np.array([0., 1., 1.5, 2., 3.])
+        assert_array_equal(digitize(x, [1, 1, 2, 2]), [0, 2, 2, 4, 4])
+        assert_array_equal(digitize(x, [2, 2, 1, 1]), [4, 4, 2, 0, 0])
+
 
 class TestUnwrap(TestCase):
     def test_simple(self):
@@ -607,6 +626,19 @@ class TestHistogram(TestCase):
         wa, wb = histogram([1, 2, 2, 4], bins=4, weights=[4, 3, 2, 1], normed=True)
         assert_array_equal(wa, array([4, 5, 0, 1]) / 10. / 3. * 4)
 
+    def test_uniform_matches_edges(self):
+        # The arithmetic binning for a number of bins must agree with the
+        # search over the same edges, also for values on the edges.
+        v = np.concatenate((rand(1000)*3 - 1, linspace(0, 1, 21)))
+        for bins in [1, 7, 20]:
+            h, e = histogram(v, bins, range=(0, 1))
+            he, ee = histogram(v, e)
+            assert_array_equal(h, he)
+            w = rand(len(v))
+            h, e = histogram(v, bins, range=(0, 1), weights=w)
+            he, ee = histogram(v, e, weights=w)
+            assert_array_almost_equal(h, he)
+
 
 class TestHistogramdd(TestCase):
     def test_simple(self):
@@ -972,6 +1004,33 @@ class TestBincount(TestCase):
         y = np.bincount(x, w)
         assert_array_equal(y, np.array([0, 0.2, 0.5, 0, 0.5, 0.1]))
 
+    def test_minlength(self):
+        x = np.array([0, 1, 0, 1, 1])
+        assert_array_equal(np.bincount(x, minlength=3), [2, 3, 0])
+        assert_array_equal(np.bincount(x, minlength=1), [2, 3])
+        assert_array_equal(np.bincount([], minlength=2), [0, 0])
+        assert_array_equal(np.bincount(x, np.ones(5), minlength=3),
+                           [2., 3., 0.])
+        assert_raises(ValueError, np.bincount, x, minlength=-1)
+
+    def test_native_types(self):
+        x = np.array([1, 5, 2, 4, 1])
+        expected = np.bincount(x)
+        for t in np.typecodes['AllInteger']:
+            assert_array_equal(np.bincount(x.astype(t)), expected)
+        assert_array_equal(np.bincount(np.array([True, False, True])),
+                           [1, 2])
+        assert_raises(ValueError, np.bincount, np.array([1, -1], np.int8))
+        assert_raises(TypeError, np.bincount, np.arange(3.))
+
+    def test_long_input(self):
+        # long inputs over few bins are counted in several passes
+        x = np.arange(200000) % 7
+        x[::3] = 2
+        y = np.bincount(x.astype(np.int16))
+        assert_equal(y.sum(), len(x))
+        assert_array_equal(y, [(x == i).sum() for i in range(7)])
+
 
 class TestInterp(TestCase):
     def test_exceptions(self):
@@ -1010,6 +1069,24 @@ class TestInterp(TestCase):
         x0 = np.array(.3, dtype=object)
         assert_almost_equal(np.interp(x0, x, y), .3)
 
+    def test_unsorted_points(self):
+        xp = np.linspace(0, 1, 17)**2
+        fp = np.sin(xp)
+        x0 = np.linspace(-0.5, 1.5, 401)
+        y0 = np.interp(x0, xp, fp)
+        perm = np.random.permutation(len(x0))
+        assert_equal(np.interp(x0[perm], xp, fp), y0[perm])
+        assert_equal(np.interp(x0[::-1], xp, fp), y0[::-1])
+        assert_equal(np.interp([np.nan], xp, fp, left=-1), [-1])
+
+    def test_float32_points(self):
+        x = np.linspace(0, 1, 5)
+        y = np.linspace(0, 1, 5)
+        x0 = np.linspace(0, 1, 50).astype(np.float32)
+        y0 = np.interp(x0, x, y)
+        assert_equal(y0.dtype, np.float64)
+        assert_equal(y0, np.interp(x0.astype(np.float64), x, y))
+
 
 def compare_results(res, desired):
     for i in range(len(desired)):
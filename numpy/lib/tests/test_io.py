@@ -136,6 +136,13 @@ class TestSavezLoad(RoundtripTest, TestCase):
         assert_equal(a, l['file_a'])
         assert_equal(b, l['file_b'])
 
+    def test_large_arrays(self):
+        # members bigger than the read blocks are streamed into the arrays
+        a = np.arange(3*2**18, dtype=np.float64).reshape(-1, 3)
+        b = np.arange(2**20 + 7, dtype=np.int8)
+        self.roundtrip(a, b)
+        self.roundtrip(a.T, b[::3], file_on_disk=True)
+
     def test_savez_filename_clashes(self):
         # Test that issue #852 is fixed
         # and savez functions in multithreaded environment
@@ -236,6 +243,52 @@ class TestSaveTxt(TestCase):
         finally:
             os.unlink(name)
 
+    def test_formats_match_python(self):
+        # numeric columns are formatted in C, which must agree with %
+        a = np.array([[0, -1.5, 1e300], [np.inf, -np.nan, 2.**-1074],
+                      [123456789, -0.0, 3e-5]])
+        for fmt in ['%.18e', '%10.3f', '%-12g', '%+E', '%G', '% .0f']:
+            c = StringIO()
+            np.savetxt(c, a, fmt=fmt, delimiter=',')
+            c.seek(0)
+            expected = [(','.join([fmt]*3) + '\n') % tuple(row) for row in a]
+            assert_equal(c.readlines(), asbytes_nested(expected))
+
+        a = np.array([[0, -7, 2**31 - 1], [-2**31, 42, 255]], np.int32)
+        for fmt in ['%d', '%05i', '%-4d|', '%x', '%o', '%+X']:
+            c = StringIO()
+            np.savetxt(c, a, fmt=fmt)
+            c.seek(0)
+            expected = [(' '.join([fmt]*3) + '\n') % tuple(row) for row in a]
+            assert_equal(c.readlines(), asbytes_nested(expected))
+
+    def test_repr_roundtrip(self):
+        a = np.random.random((50, 3))*10.**np.random.randint(-300, 300, 3)
+        a[0] = [0.1, 1./3, 1e16]
+        c = StringIO()
+        np.savetxt(c, a, fmt='%r')
+        c.seek(0)
+        assert_equal(c.readline(), asbytes('0.1 0.3333333333333333 1e+16\n'))
+        c.seek(0)
+        assert_array_equal(np.loadtxt(c), a)
+
+    def test_mixed_record(self):
+        a = np.array([(1, 2.5, True), (-3, 0.125, False)],
+                     dtype=[('i', 'i8'), ('f', 'f4'), ('b', '?')])
+        c = StringIO()
+        np.savetxt(c, a, fmt='%d:%.2f:%s')
+        c.seek(0)
+        assert_equal(c.readlines(),
+                     asbytes_nested(['1:2.50:True\n', '-3:0.12:False\n']))
+
+    def test_python_fallback(self):
+        # complex values and object columns are still formatted by Python
+        c = StringIO()
+        np.savetxt(c, np.array([[1 + 2j, 3]]), fmt='%s')
+        np.savetxt(c, np.array([[1, 'x']], object), fmt='%s')
+        c.seek(0)
+        assert_equal(c.readlines(), asbytes_nested(['(1+2j) (3+0j)\n', '1 x\n']))
+
 
 class TestLoadTxt(TestCase):
     def test_record(self):
@@ -425,6 +478,31 @@ class TestLoadTxt(TestCase):
         finally:
             os.unlink(name)
 
+    def test_large_file(self):
+        "Test input spanning several read chunks"
+        a = np.arange(300000, dtype=float).reshape(-1, 3) / 7
+        c = StringIO()
+        np.savetxt(c, a, fmt='%.17g')
+        c.seek(0)
+        assert_array_equal(np.loadtxt(c), a)
+        c.seek(0)
+        assert_array_equal(np.loadtxt(c, usecols=(-1, 0)), a[:, [2, 0]])
+
+    def test_native_dtypes(self):
+        c = StringIO('1 -2 1.5\n-0 4 2e3\n')
+        assert_array_equal(np.loadtxt(c, dtype=int),
+                           np.array([[1, -2, 1], [0, 4, 2000]]))
+        c.seek(0)
+        dt = [('a', np.uint8), ('b', np.int16), ('c', np.float32)]
+        assert_array_equal(np.loadtxt(c, dtype=dt),
+                           np.array([(1, -2, 1.5), (0, 4, 2e3)], dtype=dt))
+        c.seek(0)
+        assert_raises(OverflowError, np.loadtxt, c, dtype=np.uint8)
+
+    def test_bad_value(self):
+        assert_raises(ValueError, np.loadtxt, StringIO('1 2\n3 x\n'))
+        assert_raises(ValueError, np.loadtxt, StringIO('1 2\n3\n'))
+
 
 class Testfromregex(TestCase):
     def test_record(self):
@@ -1022,6 +1100,37 @@ M   33  21.99
         ctrl = np.array([[0., 1., 2.3], [4., 5., 6.7]], dtype=float)
         assert_equal(mtest, ctrl)
 
+    def test_native_missing_and_invalid(self):
+        "Test missing values and invalid rows with an explicit dtype"
+        data = ["%i, %i.5, %i" % (i, i, i) for i in range(200)]
+        data[3] = "3, N/A, 3"
+        data[5] = "5, 5.5"
+        data[7] = "7, 7.5, "
+        kwargs = dict(delimiter=",", dtype=[('a', int), ('b', float),
+                                            ('c', np.int16)],
+                      missing_values="N/A", filling_values=-1,
+                      invalid_raise=False, skip_footer=10)
+        ret = {}
+        def f(_ret={}):
+            _ret['mtest'] = np.mafromtxt(StringIO("\n".join(data)), **kwargs)
+        assert_warns(ConversionWarning, f, _ret=ret)
+        mtest = ret['mtest']
+        assert_equal(len(mtest), 189)
+        assert_equal(mtest['a'][:6], [0, 1, 2, 3, 4, 6])
+        assert_equal(mtest['b'].mask[:4], [False, False, False, True])
+        assert_equal(mtest['b'].data[3], -1)
+        assert_equal(mtest['c'].mask[6], True)
+        assert_equal(mtest['c'].data[6], -1)
+        assert_raises(ValueError, np.genfromtxt, StringIO("\n".join(data)),
+                      delimiter=",", dtype=float)
+
+    def test_native_bool_words(self):
+        data = "True FALSE\nfalse true\n"
+        test = np.genfromtxt(StringIO(data), dtype=[('a', bool), ('b', bool)])
+        control = np.array([(True, False), (False, True)],
+                           dtype=[('a', bool), ('b', bool)])
+        assert_equal(test, control)
+
     def test_single_dtype_w_explicit_names(self):
         "Test single dtype w explicit names"
         data = "0, 1, 2.3\n4, 5, 6.7"
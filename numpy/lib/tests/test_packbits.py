@@ -0,0 +1,67 @@
+from numpy.testing import *
+import numpy as np
+
+def pack_reference(a, little=False):
+    # pad the last axis to whole bytes and weight the bits explicitly
+    a = np.asarray(a) != 0
+    n = a.shape[-1]
+    pad = np.zeros(a.shape[:-1] + (-n % 8,), dtype=bool)
+    a = np.concatenate((a, pad), axis=-1).astype(np.uint8)
+    a = a.reshape(a.shape[:-1] + (-1, 8))
+    weights = 2**np.arange(8)
+    if not little:
+        weights = weights[::-1]
+    return (a*weights).sum(axis=-1).astype(np.uint8)
+
+class TestPackBits(TestCase):
+    def test_basic(self):
+        a = np.array([[[1,0,1], [0,1,0]], [[1,1,0], [0,0,1]]])
+        assert_equal(np.packbits(a, axis=-1), [[[160],[64]],[[192],[32]]])
+        assert_equal(np.packbits(a, axis=-1, bitorder='little'),
+                     [[[5],[2]],[[3],[4]]])
+
+    def test_contiguous(self):
+        # lengths around multiples of eight exercise both the word loop
+        # and the tail, for every nonzero byte value
+        for n in [1, 7, 8, 9, 63, 64, 65, 1000]:
+            a = np.random.randint(0, 256, n).astype(np.uint8)
+            a[::3] = 0
+            for little in [False, True]:
+                order = ['big', 'little'][little]
+                assert_equal(np.packbits(a, bitorder=order),
+                             pack_reference(a, little))
+
+    def test_strided_and_types(self):
+        a = np.random.randint(0, 2, (5, 37))*64
+        for t in [np.bool_, np.int8, np.uint16, np.int32, np.int64]:
+            b = a.astype(t)
+            assert_equal(np.packbits(b, axis=1), pack_reference(b))
+            assert_equal(np.packbits(b.T, axis=0), pack_reference(b).T)
+            assert_equal(np.packbits(b[:, ::2], axis=1),
+                         pack_reference(b[:, ::2]))
+        # only the high byte of the element is set
+        assert_equal(np.packbits(np.array([256, 0], np.uint16)), [128])
+
+    def test_unpack(self):
+        a = np.arange(256, dtype=np.uint8).reshape(16, 16)
+        for order in ['big', 'little']:
+            u = np.unpackbits(a, axis=1, bitorder=order)
+            assert_equal(u.shape, (16, 128))
+            assert_equal(np.packbits(u, axis=1, bitorder=order), a)
+            u = np.unpackbits(a, axis=0, bitorder=order)
+            assert_equal(u.shape, (128, 16))
+            assert_equal(np.packbits(u, axis=0, bitorder=order), a)
+        assert_equal(np.unpackbits(np.array([1, 128], np.uint8)),
+                     [0,0,0,0,0,0,0,1, 1,0,0,0,0,0,0,0])
+        assert_equal(np.unpackbits(np.array([1, 128], np.uint8),
+                                   bitorder='little'),
+                     [1,0,0,0,0,0,0,0, 0,0,0,0,0,0,0,1])
+
+    def test_bad_bitorder(self):
+        assert_raises(ValueError, np.packbits, [1], bitorder='middle')
+        assert_raises(ValueError, np.unpackbits, np.ones(1, np.uint8),
+                      bitorder='middle')
+
+
+if __name__ == "__main__":
+    run_module_suite()
@@ -105,7 +105,7 @@ check_object(PyObject *ob, int t, char *obname,
                      "Expected an array for parameter %s in lapack_lite.%s",
                      obname, funname);
         return 0;
-    } else if (!(((PyArrayObject *)ob)->flags & CONTIGUOUS)) {
+    } else if (!(((PyArrayObject *)ob)->flags & (CONTIGUOUS|FORTRAN))) {
         PyErr_Format(LapackError,
                      "Parameter %s is not contiguous in lapack_lite.%s",
                      obname, funname);
@@ -134,6 +134,116 @@ check_object(PyObject *ob, int t, char *obname,
 #define ZDATA(p) ((f2c_doublecomplex *) (((PyArrayObject *)p)->data))
 #define IDATA(p) ((int *) (((PyArrayObject *)p)->data))
 
+/*
+ * Workspace management.
+ *
+ * The syevd/heevd, gesdd and gelsd wrappers accept None for their work
+ * arrays.  They then run the workspace query themselves and take the
+ * workspace from a scratch arena kept by the module, instead of having
+ * Python allocate it on every call.  The arena only grows, up to
+ * SCRATCH_KEEP bytes; larger requests get a temporary allocation.  The
+ * wrappers hold the GIL throughout, which serializes all users of the
+ * arena.
+ */
+
+#define SCRATCH_KEEP (16*1024*1024)
+#define SCRATCH_ALIGN(n) (((n) + 15) & ~((size_t)15))
+
+static char *scratch_arena = NULL;
+static size_t scratch_arena_size = 0;
+
+static void *
+scratch_get(size_t size)
+{
+    if (size <= scratch_arena_size) {
+        return scratch_arena;
+    }
+    if (size > SCRATCH_KEEP) {
+        return malloc(size);
+    }
+    free(scratch_arena);
+    scratch_arena = malloc(size);
+    scratch_arena_size = (scratch_arena != NULL) ? size : 0;
+    return scratch_arena;
+}
+
+static void
+scratch_release(void *p)
+{
+    if (p != scratch_arena) {
+        free(p);
+    }
+}
+
+/* Carve the work, rwork and iwork arrays out of one scratch block */
+static void *
+get_workspace(int lwork, int elsize, int lrwork, int liwork,
+              void **work, double **rwork, int **iwork)
+{
+    size_t nwork = SCRATCH_ALIGN((size_t)lwork*elsize);
+    size_t nrwork = SCRATCH_ALIGN((size_t)lrwork*sizeof(double));
+    char *p;
+
+    p = scratch_get(nwork + nrwork + (size_t)liwork*sizeof(int) + 1);
+    if (p == NULL) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+    *work = p;
+    if (rwork != NULL) {
+        *rwork = (double *)(p + nwork);
+    }
+    if (iwork != NULL) {
+        *iwork = (int *)(p + nwork + nrwork);
+    }
+    return p;
+}
+
+/*
+ * The "optimal" workspace dgesdd reports is sometimes too small; use the
+ * maximum of it and the documented minimum.
+ */
+static long
+dgesdd_fix_lwork(char jobz, int m, int n, long work0)
+{
+    int mn = MIN(m,n);
+    int mx = MAX(m,n);
+
+    switch(jobz){
+    case 'N':
+            work0 = MAX(work0,3*mn + MAX(mx,6*mn)+500);
+            break;
+    case 'O':
+            work0 = MAX(work0,3*mn*mn +                 \
+                        MAX(mx,5*mn*mn+4*mn+500));
+            break;
+    case 'S':
+    case 'A':
+            work0 = MAX(work0,3*mn*mn +                 \
+                        MAX(mx,4*mn*(mn+1))+500);
+            break;
+    }
+    return work0;
+}
+
+/*
+ * Integer workspace of the gelsd routines, as documented; SMLSIZ is 25
+ * for the reference implementation.
+ */
+static int
+gelsd_liwork(int m, int n)
+{
+    int mn = MIN(m,n), nlvl = 0;
+
+    if (mn > 0) {
+        nlvl = (int)(log(mn/26.0)/log(2.0)) + 1;
+        if (nlvl < 0) {
+            nlvl = 0;
+        }
+    }
+    return MAX(1, 3*mn*nlvl + 11*mn);
+}
+
 static PyObject *
 lapack_lite_dgeev(PyObject *NPY_UNUSED(self), PyObject *args)
 {
@@ -244,12 +354,35 @@ lapack_lite_dsyevd(PyObject *NPY_UNUSED(self), PyObject *args)
 
     TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dsyevd"));
     TRY(check_object(w,PyArray_DOUBLE,"w","PyArray_DOUBLE","dsyevd"));
-    TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE","dsyevd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dsyevd"));
 
-    lapack_lite_status__ = \
-            FNAME(dsyevd)(&jobz,&uplo,&n,DDATA(a),&lda,DDATA(w),DDATA(work),
-                          &lwork,IDATA(iwork),&liwork,&info);
+    if (work == Py_None) {
+        double work0;
+        int iwork0;
+        void *ws;
+        double *pwork;
+        int *piwork;
+
+        lwork = liwork = -1;
+        FNAME(dsyevd)(&jobz,&uplo,&n,DDATA(a),&lda,DDATA(w),&work0,
+                      &lwork,&iwork0,&liwork,&info);
+        lwork = (int) work0;
+        liwork = iwork0;
+        TRY(ws = get_workspace(lwork, sizeof(double), 0, liwork,
+                               (void **)&pwork, NULL, &piwork));
+        lapack_lite_status__ = \
+                FNAME(dsyevd)(&jobz,&uplo,&n,DDATA(a),&lda,DDATA(w),pwork,
+                              &lwork,piwork,&liwork,&info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE",
+                         "dsyevd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dsyevd"));
+
+        lapack_lite_status__ = \
+                FNAME(dsyevd)(&jobz,&uplo,&n,DDATA(a),&lda,DDATA(w),
+                              DDATA(work),&lwork,IDATA(iwork),&liwork,&info);
+    }
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i}","dsyevd_",
                          lapack_lite_status__,"jobz",jobz,"uplo",uplo,
@@ -330,13 +463,40 @@ lapack_lite_zheevd(PyObject *NPY_UNUSED(self), PyObject *args)
 
     TRY(check_object(a,PyArray_CDOUBLE,"a","PyArray_CDOUBLE","zheevd"));
     TRY(check_object(w,PyArray_DOUBLE,"w","PyArray_DOUBLE","zheevd"));
-    TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE","zheevd"));
-    TRY(check_object(w,PyArray_DOUBLE,"rwork","PyArray_DOUBLE","zheevd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zheevd"));
 
-    lapack_lite_status__ = \
-    FNAME(zheevd)(&jobz,&uplo,&n,ZDATA(a),&lda,DDATA(w),ZDATA(work),
-                  &lwork,DDATA(rwork),&lrwork,IDATA(iwork),&liwork,&info);
+    if (work == Py_None) {
+        f2c_doublecomplex work0;
+        double rwork0;
+        int iwork0;
+        void *ws;
+        f2c_doublecomplex *pwork;
+        double *prwork;
+        int *piwork;
+
+        lwork = lrwork = liwork = -1;
+        FNAME(zheevd)(&jobz,&uplo,&n,ZDATA(a),&lda,DDATA(w),&work0,
+                      &lwork,&rwork0,&lrwork,&iwork0,&liwork,&info);
+        lwork = (int) work0.r;
+        lrwork = (int) rwork0;
+        liwork = iwork0;
+        TRY(ws = get_workspace(lwork, sizeof(f2c_doublecomplex), lrwork,
+                               liwork, (void **)&pwork, &prwork, &piwork));
+        lapack_lite_status__ = \
+        FNAME(zheevd)(&jobz,&uplo,&n,ZDATA(a),&lda,DDATA(w),pwork,
+                      &lwork,prwork,&lrwork,piwork,&liwork,&info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE",
+                         "zheevd"));
+        TRY(check_object(rwork,PyArray_DOUBLE,"rwork","PyArray_DOUBLE",
+                         "zheevd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zheevd"));
+
+        lapack_lite_status__ = \
+        FNAME(zheevd)(&jobz,&uplo,&n,ZDATA(a),&lda,DDATA(w),ZDATA(work),
+                      &lwork,DDATA(rwork),&lrwork,IDATA(iwork),&liwork,&info);
+    }
 
     return Py_BuildValue("{s:i,s:c,s:c,s:i,s:i,s:i,s:i,s:i,s:i}","zheevd_",
                          lapack_lite_status__,"jobz",jobz,"uplo",uplo,"n",n,
@@ -369,13 +529,37 @@ lapack_lite_dgelsd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(a,PyArray_DOUBLE,"a","PyArray_DOUBLE","dgelsd"));
     TRY(check_object(b,PyArray_DOUBLE,"b","PyArray_DOUBLE","dgelsd"));
     TRY(check_object(s,PyArray_DOUBLE,"s","PyArray_DOUBLE","dgelsd"));
-    TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE","dgelsd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dgelsd"));
 
-    lapack_lite_status__ = \
-            FNAME(dgelsd)(&m,&n,&nrhs,DDATA(a),&lda,DDATA(b),&ldb,
-                          DDATA(s),&rcond,&rank,DDATA(work),&lwork,
-                          IDATA(iwork),&info);
+    if (work == Py_None) {
+        double work0;
+        int iwork0, liwork;
+        void *ws;
+        double *pwork;
+        int *piwork;
+
+        lwork = -1;
+        FNAME(dgelsd)(&m,&n,&nrhs,DDATA(a),&lda,DDATA(b),&ldb,
+                      DDATA(s),&rcond,&rank,&work0,&lwork,&iwork0,&info);
+        lwork = (int) work0;
+        liwork = gelsd_liwork(m, n);
+        TRY(ws = get_workspace(lwork, sizeof(double), 0, liwork,
+                               (void **)&pwork, NULL, &piwork));
+        lapack_lite_status__ = \
+                FNAME(dgelsd)(&m,&n,&nrhs,DDATA(a),&lda,DDATA(b),&ldb,
+                              DDATA(s),&rcond,&rank,pwork,&lwork,
+                              piwork,&info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE",
+                         "dgelsd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dgelsd"));
+
+        lapack_lite_status__ = \
+                FNAME(dgelsd)(&m,&n,&nrhs,DDATA(a),&lda,DDATA(b),&ldb,
+                              DDATA(s),&rcond,&rank,DDATA(work),&lwork,
+                              IDATA(iwork),&info);
+    }
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i,s:d,s:i,s:i,s:i}","dgelsd_",
                          lapack_lite_status__,"m",m,"n",n,"nrhs",nrhs,
@@ -435,39 +619,43 @@ lapack_lite_dgesdd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(s,PyArray_DOUBLE,"s","PyArray_DOUBLE","dgesdd"));
     TRY(check_object(u,PyArray_DOUBLE,"u","PyArray_DOUBLE","dgesdd"));
     TRY(check_object(vt,PyArray_DOUBLE,"vt","PyArray_DOUBLE","dgesdd"));
-    TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE","dgesdd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dgesdd"));
 
-    lapack_lite_status__ = \
-            FNAME(dgesdd)(&jobz,&m,&n,DDATA(a),&lda,DDATA(s),DDATA(u),&ldu,
-                          DDATA(vt),&ldvt,DDATA(work),&lwork,IDATA(iwork),
-                          &info);
+    if (work == Py_None) {
+        double work0;
+        int iwork0;
+        void *ws;
+        double *pwork;
+        int *piwork;
+
+        lwork = -1;
+        FNAME(dgesdd)(&jobz,&m,&n,DDATA(a),&lda,DDATA(s),DDATA(u),&ldu,
+                      DDATA(vt),&ldvt,&work0,&lwork,&iwork0,&info);
+        lwork = (int) dgesdd_fix_lwork(jobz, m, n, (long) work0);
+        TRY(ws = get_workspace(lwork, sizeof(double), 0, 8*MIN(m,n),
+                               (void **)&pwork, NULL, &piwork));
+        lapack_lite_status__ = \
+                FNAME(dgesdd)(&jobz,&m,&n,DDATA(a),&lda,DDATA(s),DDATA(u),
+                              &ldu,DDATA(vt),&ldvt,pwork,&lwork,piwork,
+                              &info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_DOUBLE,"work","PyArray_DOUBLE",
+                         "dgesdd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","dgesdd"));
+
+        lapack_lite_status__ = \
+                FNAME(dgesdd)(&jobz,&m,&n,DDATA(a),&lda,DDATA(s),DDATA(u),
+                              &ldu,DDATA(vt),&ldvt,DDATA(work),&lwork,
+                              IDATA(iwork),&info);
 
-    if (info == 0 && lwork == -1) {
+        if (info == 0 && lwork == -1) {
             /* We need to check the result because
                sometimes the "optimal" value is actually
-               too small.
-               Change it to the maximum of the minimum and the optimal.
-            */
-            long work0 = (long) *DDATA(work);
-            int mn = MIN(m,n);
-            int mx = MAX(m,n);
-
-            switch(jobz){
-            case 'N':
-                    work0 = MAX(work0,3*mn + MAX(mx,6*mn)+500);
-                    break;
-            case 'O':
-                    work0 = MAX(work0,3*mn*mn +                 \
-                                MAX(mx,5*mn*mn+4*mn+500));
-                    break;
-            case 'S':
-            case 'A':
-                    work0 = MAX(work0,3*mn*mn +                 \
-                                MAX(mx,4*mn*(mn+1))+500);
-                    break;
-            }
-            *DDATA(work) = (double) work0;
+               too small. */
+            *DDATA(work) = (double) dgesdd_fix_lwork(jobz, m, n,
+                                                     (long) *DDATA(work));
+        }
     }
     return Py_BuildValue("{s:i,s:c,s:i,s:i,s:i,s:i,s:i,s:i,s:i}","dgesdd_",
                          lapack_lite_status__,"jobz",jobz,"m",m,"n",n,
@@ -630,13 +818,48 @@ lapack_lite_zgelsd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(a,PyArray_CDOUBLE,"a","PyArray_CDOUBLE","zgelsd"));
     TRY(check_object(b,PyArray_CDOUBLE,"b","PyArray_CDOUBLE","zgelsd"));
     TRY(check_object(s,PyArray_DOUBLE,"s","PyArray_DOUBLE","zgelsd"));
-    TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE","zgelsd"));
-    TRY(check_object(rwork,PyArray_DOUBLE,"rwork","PyArray_DOUBLE","zgelsd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zgelsd"));
 
-    lapack_lite_status__ = \
-    FNAME(zgelsd)(&m,&n,&nrhs,ZDATA(a),&lda,ZDATA(b),&ldb,DDATA(s),&rcond,
-                  &rank,ZDATA(work),&lwork,DDATA(rwork),IDATA(iwork),&info);
+    if (work == Py_None) {
+        f2c_doublecomplex work0;
+        double rwork0;
+        double dummy;
+        int iwork0, lrwork, liwork, dlwork = -1, dinfo;
+        void *ws;
+        f2c_doublecomplex *pwork;
+        double *prwork;
+        int *piwork;
+
+        lwork = -1;
+        FNAME(zgelsd)(&m,&n,&nrhs,ZDATA(a),&lda,ZDATA(b),&ldb,DDATA(s),
+                      &rcond,&rank,&work0,&lwork,&rwork0,&iwork0,&info);
+        lwork = (int) work0.r;
+        /*
+         * The real workspace zgelsd needs is bounded by the workspace of
+         * the corresponding real problem, which dgelsd reports.
+         */
+        FNAME(dgelsd)(&m,&n,&nrhs,&dummy,&lda,&dummy,&ldb,&dummy,&rcond,
+                      &rank,&rwork0,&dlwork,&iwork0,&dinfo);
+        lrwork = (int) rwork0;
+        liwork = gelsd_liwork(m, n);
+        TRY(ws = get_workspace(lwork, sizeof(f2c_doublecomplex), lrwork,
+                               liwork, (void **)&pwork, &prwork, &piwork));
+        lapack_lite_status__ = \
+        FNAME(zgelsd)(&m,&n,&nrhs,ZDATA(a),&lda,ZDATA(b),&ldb,DDATA(s),
+                      &rcond,&rank,pwork,&lwork,prwork,piwork,&info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE",
+                         "zgelsd"));
+        TRY(check_object(rwork,PyArray_DOUBLE,"rwork","PyArray_DOUBLE",
+                         "zgelsd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zgelsd"));
+
+        lapack_lite_status__ = \
+        FNAME(zgelsd)(&m,&n,&nrhs,ZDATA(a),&lda,ZDATA(b),&ldb,DDATA(s),
+                      &rcond,&rank,ZDATA(work),&lwork,DDATA(rwork),
+                      IDATA(iwork),&info);
+    }
 
     return Py_BuildValue("{s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i,s:i}","zgelsd_",
                          lapack_lite_status__,"m",m,"n",n,"nrhs",nrhs,"lda",lda,
@@ -696,14 +919,40 @@ lapack_lite_zgesdd(PyObject *NPY_UNUSED(self), PyObject *args)
     TRY(check_object(s,PyArray_DOUBLE,"s","PyArray_DOUBLE","zgesdd"));
     TRY(check_object(u,PyArray_CDOUBLE,"u","PyArray_CDOUBLE","zgesdd"));
     TRY(check_object(vt,PyArray_CDOUBLE,"vt","PyArray_CDOUBLE","zgesdd"));
-    TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE","zgesdd"));
-    TRY(check_object(rwork,PyArray_DOUBLE,"rwork","PyArray_DOUBLE","zgesdd"));
-    TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zgesdd"));
 
-    lapack_lite_status__ = \
-    FNAME(zgesdd)(&jobz,&m,&n,ZDATA(a),&lda,DDATA(s),ZDATA(u),&ldu,
-                  ZDATA(vt),&ldvt,ZDATA(work),&lwork,DDATA(rwork),
-                  IDATA(iwork),&info);
+    if (work == Py_None) {
+        f2c_doublecomplex work0;
+        double rwork0;
+        int iwork0, mn = MIN(m,n);
+        void *ws;
+        f2c_doublecomplex *pwork;
+        double *prwork;
+        int *piwork;
+
+        lwork = -1;
+        FNAME(zgesdd)(&jobz,&m,&n,ZDATA(a),&lda,DDATA(s),ZDATA(u),&ldu,
+                      ZDATA(vt),&ldvt,&work0,&lwork,&rwork0,&iwork0,&info);
+        lwork = (int) work0.r;
+        TRY(ws = get_workspace(lwork, sizeof(f2c_doublecomplex),
+                               5*mn*mn + 7*mn, 8*mn,
+                               (void **)&pwork, &prwork, &piwork));
+        lapack_lite_status__ = \
+        FNAME(zgesdd)(&jobz,&m,&n,ZDATA(a),&lda,DDATA(s),ZDATA(u),&ldu,
+                      ZDATA(vt),&ldvt,pwork,&lwork,prwork,piwork,&info);
+        scratch_release(ws);
+    }
+    else {
+        TRY(check_object(work,PyArray_CDOUBLE,"work","PyArray_CDOUBLE",
+                         "zgesdd"));
+        TRY(check_object(rwork,PyArray_DOUBLE,"rwork","PyArray_DOUBLE",
+                         "zgesdd"));
+        TRY(check_object(iwork,PyArray_INT,"iwork","PyArray_INT","zgesdd"));
+
+        lapack_lite_status__ = \
+        FNAME(zgesdd)(&jobz,&m,&n,ZDATA(a),&lda,DDATA(s),ZDATA(u),&ldu,
+                      ZDATA(vt),&ldvt,ZDATA(work),&lwork,DDATA(rwork),
+                      IDATA(iwork),&info);
+    }
 
     return Py_BuildValue("{s:i,s:c,s:i,s:i,s:i,s:i,s:i,s:i,s:i}","zgesdd_",
                          lapack_lite_status__,"jobz",jobz,"m",m,"n",n,
@@ -799,6 +1048,1182 @@ lapack_lite_zungqr(PyObject *NPY_UNUSED(self), PyObject *args)
 }
 
 
+/*
+ * Batched drivers.
+ *
+ * Each of these takes a C-contiguous stack of matrices of type double or
+ * cdouble and loops over the leading dimension in C with the GIL released.
+ * The workspace is sized once, by a query on the first matrix, and reused
+ * for the whole stack.  The matrices are handed to LAPACK in their row-major
+ * layout, so LAPACK sees their transposes; every driver arranges its calls
+ * so that no extra transposition is needed where this is possible.
+ *
+ * The drivers return their outputs together with the info value of the
+ * first matrix that failed, or 0.
+ *
+ * The f2c translation of LAPACK bundled with lapack_lite keeps its locals in
+ * static storage, so the GIL is only released when an external LAPACK is
+ * linked in (setup.py defines HAVE_EXTERNAL_LAPACK then).
+ */
+
+#ifdef HAVE_EXTERNAL_LAPACK
+#define LAPACK_THREADS_DEF NPY_BEGIN_THREADS_DEF
+#define LAPACK_BEGIN_THREADS NPY_BEGIN_THREADS
+#define LAPACK_END_THREADS NPY_END_THREADS
+#else
+#define LAPACK_THREADS_DEF
+#define LAPACK_BEGIN_THREADS
+#define LAPACK_END_THREADS
+#endif
+
+static int
+check_stack(PyObject *ob, int nd, char *obname, char *funname)
+{
+    if (!PyArray_Check(ob) || PyArray_NDIM(ob) != nd) {
+        PyErr_Format(LapackError,
+                     "Parameter %s must be a %d-dimensional array in "
+                     "lapack_lite.%s", obname, nd, funname);
+        return 0;
+    }
+    /* the drivers walk the stack in C order, unlike check_object */
+    if (!PyArray_ISCARRAY_RO(ob)) {
+        PyErr_Format(LapackError,
+                     "Parameter %s is not C-contiguous in lapack_lite.%s",
+                     obname, funname);
+        return 0;
+    }
+    if (PyArray_TYPE(ob) == PyArray_CDOUBLE) {
+        return check_object(ob, PyArray_CDOUBLE, obname, "PyArray_CDOUBLE",
+                            funname);
+    }
+    return check_object(ob, PyArray_DOUBLE, obname, "PyArray_DOUBLE",
+                        funname);
+}
+
+/* dst (cols x rows) = transpose of src (rows x cols), optionally conjugated */
+static void
+copy_transpose(char *dst, char *src, int rows, int cols, int elsize, int conj)
+{
+    int i, j;
+
+    for (i = 0; i < rows; i++) {
+        for (j = 0; j < cols; j++) {
+            memcpy(dst + (j*rows + i)*elsize, src + (i*cols + j)*elsize,
+                   elsize);
+            if (conj) {
+                ((f2c_doublecomplex *)dst)[j*rows + i].i *= -1;
+            }
+        }
+    }
+}
+
+static void
+set_identity(char *dst, int n, int elsize)
+{
+    int i;
+
+    memset(dst, 0, n*n*elsize);
+    for (i = 0; i < n; i++) {
+        *(double *)(dst + (i*n + i)*elsize) = 1.0;
+    }
+}
+
+static PyObject *
+lapack_lite_solve_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *b;
+    PyArrayObject *x = NULL;
+    int n, nrhs, elsize, iscomplex, info = 0, k_info;
+    npy_intp nb, k;
+    char *abuf, *bbuf, *pa, *pb, *px;
+    int *ipiv;
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "OO", &a, &b));
+    TRY(check_stack(a, 3, "a", "solve_batched"));
+    TRY(check_stack(b, 3, "b", "solve_batched"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    nrhs = (int)PyArray_DIM(b, 2);
+    if (PyArray_DIM(a, 2) != n || PyArray_DIM(b, 0) != nb ||
+            PyArray_DIM(b, 1) != n || PyArray_TYPE(a) != PyArray_TYPE(b)) {
+        PyErr_SetString(LapackError,
+                        "incompatible arrays in lapack_lite.solve_batched");
+        return NULL;
+    }
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    x = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(b),
+                                           PyArray_TYPE(b));
+    abuf = malloc((n*n + n*nrhs)*elsize + n*sizeof(int) + 1);
+    if (x == NULL || abuf == NULL) {
+        Py_XDECREF(x);
+        free(abuf);
+        return PyErr_NoMemory();
+    }
+    bbuf = abuf + n*n*elsize;
+    ipiv = (int *)(bbuf + n*nrhs*elsize);
+
+    LAPACK_BEGIN_THREADS;
+    pa = CHDATA(a);
+    pb = CHDATA(b);
+    px = CHDATA(x);
+    for (k = 0; k < nb; k++) {
+        copy_transpose(abuf, pa, n, n, elsize, 0);
+        copy_transpose(bbuf, pb, n, nrhs, elsize, 0);
+        if (iscomplex) {
+            FNAME(zgesv)(&n, &nrhs, (f2c_doublecomplex *)abuf, &n, ipiv,
+                         (f2c_doublecomplex *)bbuf, &n, &k_info);
+        }
+        else {
+            FNAME(dgesv)(&n, &nrhs, (double *)abuf, &n, ipiv,
+                         (double *)bbuf, &n, &k_info);
+        }
+        if (k_info != 0 && info == 0) {
+            info = k_info;
+        }
+        copy_transpose(px, bbuf, nrhs, n, elsize, 0);
+        pa += n*n*elsize;
+        pb += n*nrhs*elsize;
+        px += n*nrhs*elsize;
+    }
+    LAPACK_END_THREADS;
+
+    free(abuf);
+    return Py_BuildValue("(Ni)", x, info);
+}
+
+static PyObject *
+lapack_lite_inv_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *x = NULL;
+    int n, elsize, iscomplex, info = 0, k_info;
+    npy_intp nb, k;
+    char *abuf, *pa, *px;
+    int *ipiv;
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_stack(a, 3, "a", "inv_batched"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    if (PyArray_DIM(a, 2) != n) {
+        PyErr_SetString(LapackError,
+                        "matrices must be square in lapack_lite.inv_batched");
+        return NULL;
+    }
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    x = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(a),
+                                           PyArray_TYPE(a));
+    abuf = malloc(n*n*elsize + n*sizeof(int) + 1);
+    if (x == NULL || abuf == NULL) {
+        Py_XDECREF(x);
+        free(abuf);
+        return PyErr_NoMemory();
+    }
+    ipiv = (int *)(abuf + n*n*elsize);
+
+    /*
+     * LAPACK sees A^T, so solving against the identity in place yields
+     * A^-T in column-major order, which is A^-1 in row-major order.
+     */
+    LAPACK_BEGIN_THREADS;
+    pa = CHDATA(a);
+    px = CHDATA(x);
+    for (k = 0; k < nb; k++) {
+        memcpy(abuf, pa, n*n*elsize);
+        set_identity(px, n, elsize);
+        if (iscomplex) {
+            FNAME(zgesv)(&n, &n, (f2c_doublecomplex *)abuf, &n, ipiv,
+                         (f2c_doublecomplex *)px, &n, &k_info);
+        }
+        else {
+            FNAME(dgesv)(&n, &n, (double *)abuf, &n, ipiv, (double *)px, &n,
+                         &k_info);
+        }
+        if (k_info != 0 && info == 0) {
+            info = k_info;
+        }
+        pa += n*n*elsize;
+        px += n*n*elsize;
+    }
+    LAPACK_END_THREADS;
+
+    free(abuf);
+    return Py_BuildValue("(Ni)", x, info);
+}
+
+static PyObject *
+lapack_lite_slogdet_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *sign = NULL, *logdet = NULL;
+    int n, elsize, iscomplex, k_info, i;
+    npy_intp nb, k;
+    char *abuf, *pa;
+    int *ipiv;
+    double *plog, acc_log, absd, sr, si, dr, di, t;
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_stack(a, 3, "a", "slogdet_batched"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    if (PyArray_DIM(a, 2) != n) {
+        PyErr_SetString(LapackError,
+                    "matrices must be square in lapack_lite.slogdet_batched");
+        return NULL;
+    }
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    sign = (PyArrayObject *)PyArray_SimpleNew(1, &nb, PyArray_TYPE(a));
+    logdet = (PyArrayObject *)PyArray_SimpleNew(1, &nb, PyArray_DOUBLE);
+    abuf = malloc(n*n*elsize + n*sizeof(int) + 1);
+    if (sign == NULL || logdet == NULL || abuf == NULL) {
+        Py_XDECREF(sign);
+        Py_XDECREF(logdet);
+        free(abuf);
+        return PyErr_NoMemory();
+    }
+    ipiv = (int *)(abuf + n*n*elsize);
+
+    /* det(A^T) == det(A), so the LU factors of the row-major data serve */
+    LAPACK_BEGIN_THREADS;
+    pa = CHDATA(a);
+    plog = DDATA(logdet);
+    for (k = 0; k < nb; k++) {
+        memcpy(abuf, pa, n*n*elsize);
+        if (iscomplex) {
+            FNAME(zgetrf)(&n, &n, (f2c_doublecomplex *)abuf, &n, ipiv,
+                          &k_info);
+        }
+        else {
+            FNAME(dgetrf)(&n, &n, (double *)abuf, &n, ipiv, &k_info);
+        }
+        sr = 1.0;
+        si = 0.0;
+        acc_log = 0.0;
+        if (k_info > 0) {
+            sr = 0.0;
+            acc_log = -HUGE_VAL;
+        }
+        else {
+            for (i = 0; i < n; i++) {
+                if (ipiv[i] != i + 1) {
+                    sr = -sr;
+                }
+            }
+            for (i = 0; i < n; i++) {
+                if (iscomplex) {
+                    dr = ((f2c_doublecomplex *)abuf)[i*n + i].r;
+                    di = ((f2c_doublecomplex *)abuf)[i*n + i].i;
+                    absd = sqrt(dr*dr + di*di);
+                    dr /= absd;
+                    di /= absd;
+                    t = sr*dr - si*di;
+                    si = sr*di + si*dr;
+                    sr = t;
+                }
+                else {
+                    dr = ((double *)abuf)[i*n + i];
+                    absd = fabs(dr);
+                    if (dr < 0) {
+                        sr = -sr;
+                    }
+                }
+                acc_log += log(absd);
+            }
+        }
+        if (iscomplex) {
+            ((f2c_doublecomplex *)PyArray_DATA(sign))[k].r = sr;
+            ((f2c_doublecomplex *)PyArray_DATA(sign))[k].i = si;
+        }
+        else {
+            ((double *)PyArray_DATA(sign))[k] = sr;
+        }
+        plog[k] = acc_log;
+        pa += n*n*elsize;
+    }
+    LAPACK_END_THREADS;
+
+    free(abuf);
+    return Py_BuildValue("(NN)", sign, logdet);
+}
+
+static PyObject *
+lapack_lite_cholesky_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *x = NULL;
+    int n, elsize, iscomplex, info = 0, k_info, i;
+    npy_intp nb, k;
+    char *px;
+    char uplo = 'U';
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_stack(a, 3, "a", "cholesky_batched"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    if (PyArray_DIM(a, 2) != n) {
+        PyErr_SetString(LapackError,
+                   "matrices must be square in lapack_lite.cholesky_batched");
+        return NULL;
+    }
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    x = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(a),
+                                           PyArray_TYPE(a));
+    if (x == NULL) {
+        return NULL;
+    }
+
+    /*
+     * LAPACK sees conj(A) = U^H U for the upper factor U, so A = L L^H
+     * with L = U^T, which is U read back in row-major order.
+     */
+    LAPACK_BEGIN_THREADS;
+    memcpy(CHDATA(x), CHDATA(a), nb*n*n*elsize);
+    px = CHDATA(x);
+    for (k = 0; k < nb; k++) {
+        if (iscomplex) {
+            FNAME(zpotrf)(&uplo, &n, (f2c_doublecomplex *)px, &n, &k_info);
+        }
+        else {
+            FNAME(dpotrf)(&uplo, &n, (double *)px, &n, &k_info);
+        }
+        if (k_info != 0 && info == 0) {
+            info = k_info;
+        }
+        for (i = 0; i < n - 1; i++) {
+            memset(px + (i*n + i + 1)*elsize, 0, (n - i - 1)*elsize);
+        }
+        px += n*n*elsize;
+    }
+    LAPACK_END_THREADS;
+
+    return Py_BuildValue("(Ni)", x, info);
+}
+
+static PyObject *
+lapack_lite_eigh_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *w = NULL, *v = NULL;
+    int n, elsize, iscomplex, info = 0, k_info;
+    int lwork, lrwork, liwork;
+    npy_intp nb, k, dims[2];
+    char *abuf = NULL, *pa, *pv;
+    double *pw, *rwork = NULL;
+    char *work = NULL;
+    int *iwork = NULL;
+    f2c_doublecomplex wq;
+    double rq;
+    int iq;
+    char jobz, uplo;
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "Occ", &a, &uplo, &jobz));
+    TRY(check_stack(a, 3, "a", "eigh_batched"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    if (PyArray_DIM(a, 2) != n) {
+        PyErr_SetString(LapackError,
+                       "matrices must be square in lapack_lite.eigh_batched");
+        return NULL;
+    }
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    /* LAPACK sees A^T, whose lower triangle is the upper one of A */
+    uplo = (uplo == 'L') ? 'U' : 'L';
+    jobz = (jobz == 'V') ? 'V' : 'N';
+
+    /* Workspace query */
+    lwork = lrwork = liwork = -1;
+    if (iscomplex) {
+        FNAME(zheevd)(&jobz, &uplo, &n, &wq, &n, &rq, &wq, &lwork,
+                      &rq, &lrwork, &iq, &liwork, &k_info);
+        lwork = (int)wq.r;
+        lrwork = (int)rq;
+    }
+    else {
+        FNAME(dsyevd)(&jobz, &uplo, &n, &rq, &n, &rq, &rq, &lwork,
+                      &iq, &liwork, &k_info);
+        lwork = (int)rq;
+        lrwork = 0;
+    }
+    liwork = iq;
+    if (lwork < 1) lwork = 1;
+    if (lrwork < 1) lrwork = 1;
+    if (liwork < 1) liwork = 1;
+
+    dims[0] = nb;
+    dims[1] = n;
+    w = (PyArrayObject *)PyArray_SimpleNew(2, dims, PyArray_DOUBLE);
+    if (jobz == 'V') {
+        v = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(a),
+                                               PyArray_TYPE(a));
+    }
+    abuf = malloc(n*n*elsize + 1);
+    work = malloc(lwork*elsize);
+    rwork = malloc(lrwork*sizeof(double));
+    iwork = malloc(liwork*sizeof(int));
+    if (w == NULL || (jobz == 'V' && v == NULL) || abuf == NULL ||
+            work == NULL || rwork == NULL || iwork == NULL) {
+        Py_XDECREF(w);
+        Py_XDECREF(v);
+        free(abuf);
+        free(work);
+        free(rwork);
+        free(iwork);
+        return PyErr_NoMemory();
+    }
+
+    /*
+     * The eigenvectors LAPACK returns are those of A^T = conj(A), stored
+     * by column, so the conjugate transpose of the row-major result holds
+     * the eigenvectors of A in its columns.
+     */
+    LAPACK_BEGIN_THREADS;
+    pa = CHDATA(a);
+    pw = DDATA(w);
+    pv = (v != NULL) ? CHDATA(v) : NULL;
+    for (k = 0; k < nb; k++) {
+        memcpy(abuf, pa, n*n*elsize);
+        if (iscomplex) {
+            FNAME(zheevd)(&jobz, &uplo, &n, (f2c_doublecomplex *)abuf, &n, pw,
+                          (f2c_doublecomplex *)work, &lwork, rwork, &lrwork,
+                          iwork, &liwork, &k_info);
+        }
+        else {
+            FNAME(dsyevd)(&jobz, &uplo, &n, (double *)abuf, &n, pw,
+                          (double *)work, &lwork, iwork, &liwork, &k_info);
+        }
+        if (k_info != 0 && info == 0) {
+            info = k_info;
+        }
+        if (pv != NULL) {
+            copy_transpose(pv, abuf, n, n, elsize, iscomplex);
+            pv += n*n*elsize;
+        }
+        pa += n*n*elsize;
+        pw += n;
+    }
+    LAPACK_END_THREADS;
+
+    free(abuf);
+    free(work);
+    free(rwork);
+    free(iwork);
+    if (v == NULL) {
+        Py_INCREF(Py_None);
+        v = (PyArrayObject *)Py_None;
+    }
+    return Py_BuildValue("(NNi)", w, v, info);
+}
+
+static PyObject *
+lapack_lite_svd_batched(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *s = NULL, *u = NULL, *vt = NULL;
+    int m, n, mn, nu, nvt, ldu, ldvt, elsize, iscomplex, info = 0, k_info;
+    int lwork, full_matrices, compute_uv;
+    npy_intp nb, k, dims[3];
+    char *abuf = NULL, *work = NULL, *pa, *pu, *pvt;
+    double *ps, *rwork = NULL;
+    int *iwork = NULL;
+    f2c_doublecomplex wq, dummy[1];
+    double rq;
+    int iq;
+    char jobz;
+    LAPACK_THREADS_DEF
+
+    TRY(PyArg_ParseTuple(args, "Oii", &a, &full_matrices, &compute_uv));
+    TRY(check_stack(a, 3, "a", "svd_batched"));
+    nb = PyArray_DIM(a, 0);
+    m = (int)PyArray_DIM(a, 1);
+    n = (int)PyArray_DIM(a, 2);
+    mn = (m < n) ? m : n;
+    iscomplex = PyArray_TYPE(a) == PyArray_CDOUBLE;
+    elsize = PyArray_ITEMSIZE(a);
+
+    if (!compute_uv) {
+        jobz = 'N';
+        nu = nvt = 1;
+    }
+    else if (full_matrices) {
+        jobz = 'A';
+        nu = m;
+        nvt = n;
+    }
+    else {
+        jobz = 'S';
+        nu = nvt = mn;
+    }
+
+    /*
+     * LAPACK sees the n x m matrix A^T = conj(V) S U^T, so its left factor
+     * read back in row-major order is V^H, and its right one is U.
+     */
+    ldu = compute_uv ? n : 1;
+    ldvt = compute_uv ? nu : 1;
+
+    lwork = -1;
+    if (iscomplex) {
+        FNAME(zgesdd)(&jobz, &n, &m, dummy, &n, &rq, dummy, &ldu, dummy,
+                      &ldvt, &wq, &lwork, &rq, &iq, &k_info);
+        lwork = (int)wq.r;
+    }
+    else {
+        FNAME(dgesdd)(&jobz, &n, &m, &rq, &n, &rq, &rq, &ldu, &rq, &ldvt,
+                      &rq, &lwork, &iq, &k_info);
+        lwork = (int)dgesdd_fix_lwork(jobz, n, m, (long)rq);
+    }
+    if (lwork < 1) lwork = 1;
+
+    dims[0] = nb;
+    dims[1] = mn;
+    s = (PyArrayObject *)PyArray_SimpleNew(2, dims, PyArray_DOUBLE);
+    if (compute_uv) {
+        dims[1] = m;
+        dims[2] = nu;
+        u = (PyArrayObject *)PyArray_SimpleNew(3, dims, PyArray_TYPE(a));
+        dims[1] = nvt;
+        dims[2] = n;
+        vt = (PyArrayObject *)PyArray_SimpleNew(3, dims, PyArray_TYPE(a));
+    }
+    abuf = malloc(m*n*elsize + 1);
+    work = malloc(lwork*elsize);
+    rwork = malloc((5*mn*mn + 7*mn + 1)*sizeof(double));
+    iwork = malloc((8*mn + 1)*sizeof(int));
+    if (s == NULL || (compute_uv && (u == NULL || vt == NULL)) ||
+            abuf == NULL || work == NULL || rwork == NULL || iwork == NULL) {
+        Py_XDECREF(s);
+        Py_XDECREF(u);
+        Py_XDECREF(vt);
+        free(abuf);
+        free(work);
+        free(rwork);
+        free(iwork);
+        return PyErr_NoMemory();
+    }
+
+    LAPACK_BEGIN_THREADS;
+    pa = CHDATA(a);
+    ps = DDATA(s);
+    pu = compute_uv ? CHDATA(u) : (char *)dummy;
+    pvt = compute_uv ? CHDATA(vt) : (char *)dummy;
+    for (k = 0; k < nb; k++) {
+        memcpy(abuf, pa, m*n*elsize);
+        if (iscomplex) {
+            FNAME(zgesdd)(&jobz, &n, &m, (f2c_doublecomplex *)abuf, &n, ps,
+                          (f2c_doublecomplex *)pvt, &ldu,
+                          (f2c_doublecomplex *)pu, &ldvt,
+                          (f2c_doublecomplex *)work, &lwork, rwork, iwork,
+                          &k_info);
+        }
+        else {
+            FNAME(dgesdd)(&jobz, &n, &m, (double *)abuf, &n, ps,
+                          (double *)pvt, &ldu, (double *)pu, &ldvt,
+                          (double *)work, &lwork, iwork, &k_info);
+        }
+        if (k_info != 0 && info == 0) {
+            info = k_info;
+        }
+        pa += m*n*elsize;
+        ps += mn;
+        if (compute_uv) {
+            pu += m*nu*elsize;
+            pvt += nvt*n*elsize;
+        }
+    }
+    LAPACK_END_THREADS;
+
+    free(abuf);
+    free(work);
+    free(rwork);
+    free(iwork);
+    if (!compute_uv) {
+        return Py_BuildValue("(Ni)", s, info);
+    }
+    return Py_BuildValue("(NNNi)", u, s, vt, info);
+}
+
+
+/*
+ * Kernels for stacks of 2x2, 3x3 and 4x4 real matrices.
+ *
+ * For matrices this small the cost of the LAPACK path is dominated by
+ * the per-call overhead, so det, slogdet, inv and solve use an LU
+ * factorization with partial pivoting and eigh uses Jacobi rotations, in
+ * loops whose bounds are compile-time constants once inlined into the
+ * per-size cases.  Elements may be float or double; the arithmetic is
+ * always done in double and the results are stored in the element type
+ * of the input.  None of these call into LAPACK, so they always release
+ * the GIL.
+ */
+
+#define SMALL_MAX 4
+
+static int
+check_small(PyObject *ob, int nd, char *obname, char *funname)
+{
+    if (!PyArray_Check(ob) || PyArray_NDIM(ob) != nd) {
+        PyErr_Format(LapackError,
+                     "Parameter %s must be a %d-dimensional array in "
+                     "lapack_lite.%s", obname, nd, funname);
+        return 0;
+    }
+    if (!PyArray_ISCARRAY_RO(ob)) {
+        PyErr_Format(LapackError,
+                     "Parameter %s is not C-contiguous in lapack_lite.%s",
+                     obname, funname);
+        return 0;
+    }
+    if (PyArray_TYPE(ob) == PyArray_FLOAT) {
+        return check_object(ob, PyArray_FLOAT, obname, "PyArray_FLOAT",
+                            funname);
+    }
+    return check_object(ob, PyArray_DOUBLE, obname, "PyArray_DOUBLE",
+                        funname);
+}
+
+static int
+check_small_square(PyObject *a, char *funname)
+{
+    int n = (int)PyArray_DIM(a, 1);
+
+    if (PyArray_DIM(a, 2) != n || n < 2 || n > SMALL_MAX) {
+        PyErr_Format(LapackError,
+                     "matrices must be square and of size 2 to %d in "
+                     "lapack_lite.%s", SMALL_MAX, funname);
+        return 0;
+    }
+    return 1;
+}
+
+static NPY_INLINE void
+small_load(double *dst, char *src, int isfloat, int count)
+{
+    int i;
+
+    if (isfloat) {
+        for (i = 0; i < count; i++) {
+            dst[i] = ((float *)src)[i];
+        }
+    }
+    else {
+        memcpy(dst, src, count*sizeof(double));
+    }
+}
+
+static NPY_INLINE void
+small_store(char *dst, double *src, int isfloat, int count)
+{
+    int i;
+
+    if (isfloat) {
+        for (i = 0; i < count; i++) {
+            ((float *)dst)[i] = (float)src[i];
+        }
+    }
+    else {
+        memcpy(dst, src, count*sizeof(double));
+    }
+}
+
+/*
+ * LU factorization with partial pivoting of m in place, as dgetrf does it:
+ * row k was swapped with row piv[k] at step k.  Returns the sign of the
+ * permutation, or 0 if a pivot is exactly zero.
+ */
+static NPY_INLINE int
+small_lu(double *m, int *piv, int n)
+{
+    int i, j, k, p, s = 1;
+    double t;
+
+    for (k = 0; k < n; k++) {
+        p = k;
+        for (i = k + 1; i < n; i++) {
+            if (fabs(m[i*n + k]) > fabs(m[p*n + k])) {
+                p = i;
+            }
+        }
+        piv[k] = p;
+        if (m[p*n + k] == 0) {
+            return 0;
+        }
+        if (p != k) {
+            for (j = 0; j < n; j++) {
+                t = m[k*n + j];
+                m[k*n + j] = m[p*n + j];
+                m[p*n + j] = t;
+            }
+            s = -s;
+        }
+        for (i = k + 1; i < n; i++) {
+            t = m[i*n + k] /= m[k*n + k];
+            for (j = k + 1; j < n; j++) {
+                m[i*n + j] -= t*m[k*n + j];
+            }
+        }
+    }
+    return s;
+}
+
+/* b = m^-1 b in place, for the factors of m from small_lu */
+static NPY_INLINE void
+small_lu_solve(double *m, int *piv, double *b, int n)
+{
+    int i, j;
+    double t;
+
+    for (i = 0; i < n; i++) {
+        if (piv[i] != i) {
+            t = b[i];
+            b[i] = b[piv[i]];
+            b[piv[i]] = t;
+        }
+    }
+    for (i = 1; i < n; i++) {
+        for (j = 0; j < i; j++) {
+            b[i] -= m[i*n + j]*b[j];
+        }
+    }
+    for (i = n - 1; i >= 0; i--) {
+        for (j = i + 1; j < n; j++) {
+            b[i] -= m[i*n + j]*b[j];
+        }
+        b[i] /= m[i*n + i];
+    }
+}
+
+/*
+ * det(m), destroying m.  The product of the pivots is kept as a fraction
+ * and a binary exponent, so that it only overflows or underflows if the
+ * determinant itself does.
+ */
+static NPY_INLINE double
+small_det(double *m, int n)
+{
+    int piv[SMALL_MAX], i, s, e, ei;
+    double f = 1;
+
+    s = small_lu(m, piv, n);
+    if (s == 0) {
+        return 0;
+    }
+    e = 0;
+    for (i = 0; i < n; i++) {
+        f = frexp(f*m[i*n + i], &ei);
+        e += ei;
+    }
+    return ldexp(s*f, e);
+}
+
+/* x = m^-1, destroying m; returns 0 if m is singular */
+static NPY_INLINE int
+small_inv(double *m, double *x, int n)
+{
+    int piv[SMALL_MAX], i, j;
+    double col[SMALL_MAX];
+
+    if (!small_lu(m, piv, n)) {
+        for (i = 0; i < n*n; i++) {
+            x[i] = 0;
+        }
+        return 0;
+    }
+    for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++) {
+            col[i] = i == j;
+        }
+        small_lu_solve(m, piv, col, n);
+        for (i = 0; i < n; i++) {
+            x[i*n + j] = col[i];
+        }
+    }
+    return 1;
+}
+
+/* Sets the sign and log|det| of m, destroying m */
+static NPY_INLINE void
+small_slogdet(double *m, int n, double *sign, double *logdet)
+{
+    int piv[SMALL_MAX], k, s;
+    double l = 0;
+
+    s = small_lu(m, piv, n);
+    if (s == 0) {
+        *sign = 0;
+        *logdet = -HUGE_VAL;
+        return;
+    }
+    for (k = 0; k < n; k++) {
+        if (m[k*n + k] < 0) {
+            s = -s;
+        }
+        l += log(fabs(m[k*n + k]));
+    }
+    *sign = s;
+    *logdet = l;
+}
+
+/*
+ * Cyclic Jacobi on the symmetric matrix m; the eigenvalues end up in w in
+ * ascending order and, if v is not NULL, the eigenvectors in its columns.
+ */
+static NPY_INLINE void
+small_jacobi(double *m, double *w, double *v, int n)
+{
+    int i, j, k, p, q, sweep;
+    double off, total, theta, t, c, s, x, y;
+
+    if (v != NULL) {
+        for (i = 0; i < n*n; i++) {
+            v[i] = (i % (n + 1) == 0);
+        }
+    }
+    total = 0;
+    for (i = 0; i < n*n; i++) {
+        total += m[i]*m[i];
+    }
+    for (sweep = 0; sweep < 50; sweep++) {
+        off = 0;
+        for (p = 0; p < n; p++) {
+            for (q = p + 1; q < n; q++) {
+                off += m[p*n + q]*m[p*n + q];
+            }
+        }
+        if (off <= 1e-36*total) {
+            break;
+        }
+        for (p = 0; p < n; p++) {
+            for (q = p + 1; q < n; q++) {
+                if (m[p*n + q] == 0) {
+                    continue;
+                }
+                theta = (m[q*n + q] - m[p*n + p])/(2*m[p*n + q]);
+                if (fabs(theta) > 1e150) {
+                    t = 0.5/theta;
+                }
+                else {
+                    t = 1/(fabs(theta) + sqrt(theta*theta + 1));
+                    if (theta < 0) {
+                        t = -t;
+                    }
+                }
+                c = 1/sqrt(t*t + 1);
+                s = t*c;
+                for (k = 0; k < n; k++) {
+                    x = m[k*n + p];
+                    y = m[k*n + q];
+                    m[k*n + p] = c*x - s*y;
+                    m[k*n + q] = s*x + c*y;
+                }
+                for (k = 0; k < n; k++) {
+                    x = m[p*n + k];
+                    y = m[q*n + k];
+                    m[p*n + k] = c*x - s*y;
+                    m[q*n + k] = s*x + c*y;
+                }
+                m[p*n + q] = m[q*n + p] = 0;
+                if (v != NULL) {
+                    for (k = 0; k < n; k++) {
+                        x = v[k*n + p];
+                        y = v[k*n + q];
+                        v[k*n + p] = c*x - s*y;
+                        v[k*n + q] = s*x + c*y;
+                    }
+                }
+            }
+        }
+    }
+    for (i = 0; i < n; i++) {
+        w[i] = m[i*n + i];
+    }
+    /* selection sort, carrying the eigenvectors along */
+    for (i = 0; i < n - 1; i++) {
+        k = i;
+        for (j = i + 1; j < n; j++) {
+            if (w[j] < w[k]) {
+                k = j;
+            }
+        }
+        if (k != i) {
+            t = w[i];
+            w[i] = w[k];
+            w[k] = t;
+            if (v != NULL) {
+                for (j = 0; j < n; j++) {
+                    t = v[j*n + i];
+                    v[j*n + i] = v[j*n + k];
+                    v[j*n + k] = t;
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Expand a per-matrix kernel call into one case per supported size, so
+ * that each is compiled with n known.
+ */
+#define SMALL_DISPATCH(n, call)                 \
+    switch (n) {                                \
+    case 2: { const int n_ = 2; call; break; }  \
+    case 3: { const int n_ = 3; call; break; }  \
+    default: { const int n_ = 4; call; break; } \
+    }
+
+static PyObject *
+lapack_lite_small_det(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *d;
+    int n, isfloat;
+    npy_intp nb, k;
+    char *pa;
+    double m[SMALL_MAX*SMALL_MAX], *pd;
+    NPY_BEGIN_THREADS_DEF;
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_small(a, 3, "a", "small_det"));
+    TRY(check_small_square(a, "small_det"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    isfloat = PyArray_TYPE(a) == PyArray_FLOAT;
+
+    TRY(d = (PyArrayObject *)PyArray_SimpleNew(1, &nb, PyArray_DOUBLE));
+    NPY_BEGIN_THREADS;
+    pa = CHDATA(a);
+    pd = DDATA(d);
+    for (k = 0; k < nb; k++) {
+        SMALL_DISPATCH(n, small_load(m, pa, isfloat, n_*n_);
+                          pd[k] = small_det(m, n_));
+        pa += n*n*PyArray_ITEMSIZE(a);
+    }
+    NPY_END_THREADS;
+
+    return PyArray_Return(d);
+}
+
+static PyObject *
+lapack_lite_small_slogdet(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *sign = NULL, *logdet = NULL;
+    int n, isfloat;
+    npy_intp nb, k;
+    char *pa;
+    double m[SMALL_MAX*SMALL_MAX], *ps, *pl;
+    NPY_BEGIN_THREADS_DEF;
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_small(a, 3, "a", "small_slogdet"));
+    TRY(check_small_square(a, "small_slogdet"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    isfloat = PyArray_TYPE(a) == PyArray_FLOAT;
+
+    sign = (PyArrayObject *)PyArray_SimpleNew(1, &nb, PyArray_DOUBLE);
+    logdet = (PyArrayObject *)PyArray_SimpleNew(1, &nb, PyArray_DOUBLE);
+    if (sign == NULL || logdet == NULL) {
+        Py_XDECREF(sign);
+        Py_XDECREF(logdet);
+        return NULL;
+    }
+    NPY_BEGIN_THREADS;
+    pa = CHDATA(a);
+    ps = DDATA(sign);
+    pl = DDATA(logdet);
+    for (k = 0; k < nb; k++) {
+        SMALL_DISPATCH(n, small_load(m, pa, isfloat, n_*n_);
+                          small_slogdet(m, n_, ps + k, pl + k));
+        pa += n*n*PyArray_ITEMSIZE(a);
+    }
+    NPY_END_THREADS;
+
+    return Py_BuildValue("(NN)", sign, logdet);
+}
+
+static PyObject *
+lapack_lite_small_inv(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *x;
+    int n, isfloat, elsize, info = 0;
+    npy_intp nb, k;
+    char *pa, *px;
+    double m[SMALL_MAX*SMALL_MAX], mi[SMALL_MAX*SMALL_MAX];
+    NPY_BEGIN_THREADS_DEF;
+
+    TRY(PyArg_ParseTuple(args, "O", &a));
+    TRY(check_small(a, 3, "a", "small_inv"));
+    TRY(check_small_square(a, "small_inv"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    isfloat = PyArray_TYPE(a) == PyArray_FLOAT;
+    elsize = PyArray_ITEMSIZE(a);
+
+    TRY(x = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(a),
+                                               PyArray_TYPE(a)));
+    NPY_BEGIN_THREADS;
+    pa = CHDATA(a);
+    px = CHDATA(x);
+    for (k = 0; k < nb; k++) {
+        SMALL_DISPATCH(n, small_load(m, pa, isfloat, n_*n_);
+                          if (!small_inv(m, mi, n_) && info == 0) {
+                              info = 1;
+                          }
+                          small_store(px, mi, isfloat, n_*n_));
+        pa += n*n*elsize;
+        px += n*n*elsize;
+    }
+    NPY_END_THREADS;
+
+    return Py_BuildValue("(Ni)", x, info);
+}
+
+static PyObject *
+lapack_lite_small_solve(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a, *b;
+    PyArrayObject *x;
+    int n, nrhs, isfloat, elsize, info = 0, i, j, singular;
+    int piv[SMALL_MAX];
+    npy_intp nb, k;
+    char *pa, *pb, *px;
+    double m[SMALL_MAX*SMALL_MAX], bb[SMALL_MAX];
+    NPY_BEGIN_THREADS_DEF;
+
+    TRY(PyArg_ParseTuple(args, "OO", &a, &b));
+    TRY(check_small(a, 3, "a", "small_solve"));
+    TRY(check_small_square(a, "small_solve"));
+    TRY(check_small(b, 3, "b", "small_solve"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    nrhs = (int)PyArray_DIM(b, 2);
+    if (PyArray_DIM(b, 0) != nb || PyArray_DIM(b, 1) != n ||
+            PyArray_TYPE(b) != PyArray_TYPE(a)) {
+        PyErr_SetString(LapackError,
+                        "a and b do not match in lapack_lite.small_solve");
+        return NULL;
+    }
+    isfloat = PyArray_TYPE(a) == PyArray_FLOAT;
+    elsize = PyArray_ITEMSIZE(a);
+
+    TRY(x = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(b),
+                                               PyArray_TYPE(b)));
+    NPY_BEGIN_THREADS;
+    pa = CHDATA(a);
+    pb = CHDATA(b);
+    px = CHDATA(x);
+    for (k = 0; k < nb; k++) {
+        SMALL_DISPATCH(n,
+            small_load(m, pa, isfloat, n_*n_);
+            singular = !small_lu(m, piv, n_);
+            if (singular && info == 0) {
+                info = 1;
+            }
+            for (j = 0; j < nrhs; j++) {
+                for (i = 0; i < n_; i++) {
+                    small_load(bb + i, pb + (i*nrhs + j)*elsize, isfloat, 1);
+                    if (singular) {
+                        bb[i] = 0;
+                    }
+                }
+                if (!singular) {
+                    small_lu_solve(m, piv, bb, n_);
+                }
+                for (i = 0; i < n_; i++) {
+                    small_store(px + (i*nrhs + j)*elsize, bb + i, isfloat, 1);
+                }
+            });
+        pa += n*n*elsize;
+        pb += n*nrhs*elsize;
+        px += n*nrhs*elsize;
+    }
+    NPY_END_THREADS;
+
+    return Py_BuildValue("(Ni)", x, info);
+}
+
+static PyObject *
+lapack_lite_small_eigh(PyObject *NPY_UNUSED(self), PyObject *args)
+{
+    PyObject *a;
+    PyArrayObject *w = NULL, *v = NULL;
+    int n, isfloat, elsize, i, j;
+    npy_intp nb, k, dims[2];
+    char *pa, *pw, *pv = NULL;
+    char uplo, jobz;
+    double m[SMALL_MAX*SMALL_MAX], vv[SMALL_MAX*SMALL_MAX], ww[SMALL_MAX];
+    NPY_BEGIN_THREADS_DEF;
+
+    TRY(PyArg_ParseTuple(args, "Occ", &a, &uplo, &jobz));
+    TRY(check_small(a, 3, "a", "small_eigh"));
+    TRY(check_small_square(a, "small_eigh"));
+    nb = PyArray_DIM(a, 0);
+    n = (int)PyArray_DIM(a, 1);
+    isfloat = PyArray_TYPE(a) == PyArray_FLOAT;
+    elsize = PyArray_ITEMSIZE(a);
+
+    dims[0] = nb;
+    dims[1] = n;
+    TRY(w = (PyArrayObject *)PyArray_SimpleNew(2, dims, PyArray_TYPE(a)));
+    if (jobz == 'V') {
+        v = (PyArrayObject *)PyArray_SimpleNew(3, PyArray_DIMS(a),
+                                               PyArray_TYPE(a));
+        if (v == NULL) {
+            Py_DECREF(w);
+            return NULL;
+        }
+        pv = CHDATA(v);
+    }
+    NPY_BEGIN_THREADS;
+    pa = CHDATA(a);
+    pw = CHDATA(w);
+    for (k = 0; k < nb; k++) {
+        SMALL_DISPATCH(n,
+            small_load(m, pa, isfloat, n_*n_);
+            /* only the requested triangle is referenced */
+            for (i = 0; i < n_; i++) {
+                for (j = i + 1; j < n_; j++) {
+                    if (uplo == 'L') {
+                        m[i*n_ + j] = m[j*n_ + i];
+                    }
+                    else {
+                        m[j*n_ + i] = m[i*n_ + j];
+                    }
+                }
+            }
+            small_jacobi(m, ww, pv != NULL ? vv : NULL, n_);
+            small_store(pw, ww, isfloat, n_);
+            if (pv != NULL) {
+                small_store(pv, vv, isfloat, n_*n_);
+                pv += n_*n_*elsize;
+            });
+        pa += n*n*elsize;
+        pw += n*elsize;
+    }
+    NPY_END_THREADS;
+
+    if (v == NULL) {
+        Py_INCREF(Py_None);
+        return Py_BuildValue("(NN)", w, Py_None);
+    }
+    return Py_BuildValue("(NN)", w, v);
+}
 
 #define STR(x) #x
 #define lameth(name) {STR(name), lapack_lite_##name, METH_VARARGS, NULL}
@@ -821,6 +2246,17 @@ static struct PyMethodDef lapack_lite_module_methods[] = {
     lameth(zpotrf),
     lameth(zgeqrf),
     lameth(zungqr),
+    lameth(solve_batched),
+    lameth(inv_batched),
+    lameth(slogdet_batched),
+    lameth(cholesky_batched),
+    lameth(eigh_batched),
+    lameth(svd_batched),
+    lameth(small_det),
+    lameth(small_slogdet),
+    lameth(small_inv),
+    lameth(small_solve),
+    lameth(small_eigh),
     { NULL,NULL,0, NULL}
 };
 
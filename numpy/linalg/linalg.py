@@ -18,7 +18,7 @@ from numpy.core import array, asarray, zeros, empty, transpose, \
         intc, single, double, csingle, cdouble, inexact, complexfloating, \
         newaxis, ravel, all, Inf, dot, add, multiply, identity, sqrt, \
         maximum, flatnonzero, diagonal, arange, fastCopyAndTranspose, sum, \
-        isfinite, size, finfo, absolute, log, exp
+        isfinite, size, finfo, absolute, log, exp, ascontiguousarray
 from numpy.lib import triu
 from numpy.linalg import lapack_lite
 from numpy.matrixlib.defmatrix import matrix_power
@@ -142,7 +142,9 @@ def _fastCopyAndTranspose(type, *arrays):
         if a.dtype.type is type:
             cast_arrays = cast_arrays + (_fastCT(a),)
         else:
-            cast_arrays = cast_arrays + (_fastCT(a.astype(type)),)
+            # cast and transpose in a single copy
+            cast_arrays = cast_arrays + (array(a.transpose(), dtype=type,
+                                               order='C'),)
     if len(cast_arrays) == 1:
         return cast_arrays[0]
     else:
@@ -159,6 +161,30 @@ def _assertSquareness(*arrays):
         if max(a.shape) != min(a.shape):
             raise LinAlgError, 'Array must be square'
 
+def _assertNdSquareness(*arrays):
+    for a in arrays:
+        if a.shape[-1] != a.shape[-2]:
+            raise LinAlgError, 'Last 2 dimensions of the array must be square'
+
+def _stacked(t, a):
+    """Return `a` as a C-contiguous stack of matrices of type `t`."""
+    return ascontiguousarray(a, dtype=t).reshape((-1,) + a.shape[-2:])
+
+def _smallType(*arrays):
+    """
+    Return the type the small-matrix kernels of lapack_lite work in for
+    `arrays`, or None if the first of them is not a stack of real 2x2 to
+    4x4 matrices.
+    """
+    a = arrays[0]
+    if a.ndim < 2 or a.shape[-1] != a.shape[-2] or \
+           a.shape[-1] not in (2, 3, 4):
+        return None
+    t, result_t = _commonType(*arrays)
+    if isComplexType(t):
+        return None
+    return result_t
+
 def _assertFinite(*arrays):
     for a in arrays:
         if not (isfinite(a).all()):
@@ -250,14 +276,14 @@ def solve(a, b):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Coefficient matrix.
-    b : array_like, shape (M,) or (M, N)
+    a : array_like, shape (..., M, M)
+        Coefficient matrix, or a stack of them.
+    b : array_like, shape (..., M) or (..., M, N)
         Ordinate or "dependent variable" values.
 
     Returns
     -------
-    x : ndarray, shape (M,) or (M, N) depending on b
+    x : ndarray, shape (..., M) or (..., M, N) depending on b
         Solution to the system a x = b
 
     Raises
@@ -282,6 +308,13 @@ def solve(a, b):
     `lstsq` for the least-squares best "solution" of the
     system/equation.
 
+    Real 2x2, 3x3 and 4x4 systems are instead solved in C by LU
+    factorization with partial pivoting, as gesv does, which is much
+    cheaper than a LAPACK call at those sizes.
+
+    Stacks of systems are solved in a single loop in C; `b` must then have
+    the same leading dimensions as `a`.
+
     References
     ----------
     .. [1] G. Strang, *Linear Algebra and Its Applications*, 2nd Ed., Orlando,
@@ -305,6 +338,8 @@ def solve(a, b):
     """
     a, _ = _makearray(a)
     b, wrap = _makearray(b)
+    if a.ndim > 2 or _smallType(a, b) is not None:
+        return wrap(_solve_stacked(a, b))
     one_eq = len(b.shape) == 1
     if one_eq:
         b = b[:, newaxis]
@@ -331,6 +366,27 @@ def solve(a, b):
     else:
         return wrap(b.transpose().astype(result_t))
 
+def _solve_stacked(a, b):
+    _assertNdSquareness(a)
+    one_eq = b.ndim == a.ndim - 1
+    if one_eq:
+        b = b[..., newaxis]
+    if b.shape[:-1] != a.shape[:-1]:
+        raise LinAlgError, 'Incompatible dimensions'
+    t, result_t = _commonType(a, b)
+    small_t = _smallType(a, b)
+    if small_t is not None:
+        x, info = lapack_lite.small_solve(_stacked(small_t, a),
+                                          _stacked(small_t, b))
+    else:
+        x, info = lapack_lite.solve_batched(_stacked(t, a), _stacked(t, b))
+    if info > 0:
+        raise LinAlgError, 'Singular matrix'
+    x = x.reshape(b.shape).astype(result_t)
+    if one_eq:
+        x = x[..., 0]
+    return x
+
 
 def tensorinv(a, ind=2):
     """
@@ -410,12 +466,12 @@ def inv(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Matrix to be inverted.
+    a : array_like, shape (..., M, M)
+        Matrix to be inverted, or a stack of them.
 
     Returns
     -------
-    ainv : ndarray or matrix, shape (M, M)
+    ainv : ndarray or matrix, shape (..., M, M)
         (Multiplicative) inverse of the matrix `a`.
 
     Raises
@@ -442,6 +498,19 @@ def inv(a):
 
     """
     a, wrap = _makearray(a)
+    small_t = _smallType(a)
+    if small_t is not None:
+        ainv, info = lapack_lite.small_inv(_stacked(small_t, a))
+        if info > 0:
+            raise LinAlgError, 'Singular matrix'
+        return wrap(ainv.reshape(a.shape))
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        ainv, info = lapack_lite.inv_batched(_stacked(t, a))
+        if info > 0:
+            raise LinAlgError, 'Singular matrix'
+        return wrap(ainv.reshape(a.shape).astype(result_t))
     return wrap(solve(a, identity(a.shape[0], dtype=a.dtype)))
 
 
@@ -459,13 +528,13 @@ def cholesky(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
+    a : array_like, shape (..., M, M)
         Hermitian (symmetric if all elements are real), positive-definite
         input matrix.
 
     Returns
     -------
-    L : ndarray, or matrix object if `a` is, shape (M, M)
+    L : ndarray, or matrix object if `a` is, shape (..., M, M)
         Lower-triangular Cholesky factor of a.
 
     Raises
@@ -514,6 +583,14 @@ def cholesky(a):
 
     """
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        l, info = lapack_lite.cholesky_batched(_stacked(t, a))
+        if info > 0:
+            raise LinAlgError, 'Matrix is not positive definite - \
+            Cholesky decomposition cannot be computed'
+        return wrap(l.reshape(a.shape).astype(result_t))
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -814,7 +891,7 @@ def eigvalsh(a, UPLO='L'):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
+    a : array_like, shape (..., M, M)
         A complex- or real-valued matrix whose eigenvalues are to be
         computed.
     UPLO : {'L', 'U'}, optional
@@ -823,7 +900,7 @@ def eigvalsh(a, UPLO='L'):
 
     Returns
     -------
-    w : ndarray, shape (M,)
+    w : ndarray, shape (..., M)
         The eigenvalues, not necessarily ordered, each repeated according to
         its multiplicity.
 
@@ -845,6 +922,9 @@ def eigvalsh(a, UPLO='L'):
     that sets those routines' flags to return only the eigenvalues of
     real symmetric and complex Hermitian arrays, respectively.
 
+    Real symmetric 2x2, 3x3 and 4x4 matrices are diagonalized with Jacobi
+    rotations instead.
+
     Examples
     --------
     >>> from numpy import linalg as LA
@@ -855,6 +935,8 @@ def eigvalsh(a, UPLO='L'):
     """
     UPLO = asbytes(UPLO)
     a, wrap = _makearray(a)
+    if a.ndim > 2 or _smallType(a) is not None:
+        return _eigh_stacked(a, UPLO, _N)[0]
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -862,38 +944,33 @@ def eigvalsh(a, UPLO='L'):
     a = _fastCopyAndTranspose(t, a)
     a = _to_native_byte_order(a)
     n = a.shape[0]
-    liwork = 5*n+3
-    iwork = zeros((liwork,), fortran_int)
     if isComplexType(t):
-        lapack_routine = lapack_lite.zheevd
         w = zeros((n,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        lrwork = 1
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, -1,
-                                 rwork, -1, iwork, liwork,  0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
-        lrwork = int(rwork[0])
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, lwork,
-                                rwork, lrwork, iwork, liwork,  0)
+        results = lapack_lite.zheevd(_N, UPLO, n, a, n, w, None, 0,
+                                     None, 0, None, 0, 0)
     else:
-        lapack_routine = lapack_lite.dsyevd
         w = zeros((n,), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, -1,
-                                 iwork, liwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
-        results = lapack_routine(_N, UPLO, n, a, n, w, work, lwork,
-                                 iwork, liwork, 0)
+        results = lapack_lite.dsyevd(_N, UPLO, n, a, n, w, None, 0,
+                                     None, 0, 0)
     if results['info'] > 0:
         raise LinAlgError, 'Eigenvalues did not converge'
     return w.astype(result_t)
 
+def _eigh_stacked(a, UPLO, jobz):
+    _assertNdSquareness(a)
+    t, result_t = _commonType(a)
+    small_t = _smallType(a)
+    if small_t is not None:
+        w, v = lapack_lite.small_eigh(_stacked(small_t, a), UPLO, jobz)
+    else:
+        w, v, info = lapack_lite.eigh_batched(_stacked(t, a), UPLO, jobz)
+        if info > 0:
+            raise LinAlgError, 'Eigenvalues did not converge'
+    w = w.reshape(a.shape[:-1]).astype(_realType(result_t))
+    if v is not None:
+        v = v.reshape(a.shape).astype(result_t)
+    return w, v
+
 def _convertarray(a):
     t, result_t = _commonType(a)
     a = _fastCT(a.astype(t))
@@ -1076,7 +1153,7 @@ def eigh(a, UPLO='L'):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
+    a : array_like, shape (..., M, M)
         A complex Hermitian or real symmetric matrix.
     UPLO : {'L', 'U'}, optional
         Specifies whether the calculation is done with the lower triangular
@@ -1084,9 +1161,9 @@ def eigh(a, UPLO='L'):
 
     Returns
     -------
-    w : ndarray, shape (M,)
+    w : ndarray, shape (..., M)
         The eigenvalues, not necessarily ordered.
-    v : ndarray, or matrix object if `a` is, shape (M, M)
+    v : ndarray, or matrix object if `a` is, shape (..., M, M)
         The column ``v[:, i]`` is the normalized eigenvector corresponding
         to the eigenvalue ``w[i]``.
 
@@ -1107,6 +1184,10 @@ def eigh(a, UPLO='L'):
     which compute the eigenvalues and eigenvectors of real symmetric and
     complex Hermitian arrays, respectively.
 
+    Real symmetric 2x2, 3x3 and 4x4 matrices are diagonalized with Jacobi
+    rotations instead, so their eigenvectors may differ from the LAPACK
+    ones in sign.
+
     The eigenvalues of real symmetric or complex Hermitian matrices are
     always real. [1]_ The array `v` of (column) eigenvectors is unitary
     and `a`, `w`, and `v` satisfy the equations
@@ -1148,6 +1229,9 @@ def eigh(a, UPLO='L'):
     """
     UPLO = asbytes(UPLO)
     a, wrap = _makearray(a)
+    if a.ndim > 2 or _smallType(a) is not None:
+        w, v = _eigh_stacked(a, UPLO, _V)
+        return w, wrap(v)
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1155,34 +1239,14 @@ def eigh(a, UPLO='L'):
     a = _fastCopyAndTranspose(t, a)
     a = _to_native_byte_order(a)
     n = a.shape[0]
-    liwork = 5*n+3
-    iwork = zeros((liwork,), fortran_int)
     if isComplexType(t):
-        lapack_routine = lapack_lite.zheevd
         w = zeros((n,), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        lrwork = 1
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, -1,
-                                 rwork, -1, iwork, liwork,  0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
-        lrwork = int(rwork[0])
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, lwork,
-                                 rwork, lrwork, iwork, liwork,  0)
+        results = lapack_lite.zheevd(_V, UPLO, n, a, n, w, None, 0,
+                                     None, 0, None, 0, 0)
     else:
-        lapack_routine = lapack_lite.dsyevd
         w = zeros((n,), t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, -1,
-                iwork, liwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
-        results = lapack_routine(_V, UPLO, n, a, n, w, work, lwork,
-                iwork, liwork, 0)
+        results = lapack_lite.dsyevd(_V, UPLO, n, a, n, w, None, 0,
+                                     None, 0, 0)
     if results['info'] > 0:
         raise LinAlgError, 'Eigenvalues did not converge'
     at = a.transpose().astype(result_t)
@@ -1201,7 +1265,8 @@ def svd(a, full_matrices=1, compute_uv=1):
     Parameters
     ----------
     a : array_like
-        A real or complex matrix of shape (`M`, `N`) .
+        A real or complex matrix of shape (`M`, `N`), or a stack of them
+        of shape (..., `M`, `N`).
     full_matrices : bool, optional
         If True (default), `u` and `v` have the shapes (`M`, `M`) and
         (`N`, `N`), respectively.  Otherwise, the shapes are (`M`, `K`)
@@ -1268,6 +1333,8 @@ def svd(a, full_matrices=1, compute_uv=1):
 
     """
     a, wrap = _makearray(a)
+    if a.ndim > 2:
+        return _svd_stacked(a, wrap, full_matrices, compute_uv)
     _assertRank2(a)
     _assertNonEmpty(a)
     m, n = a.shape
@@ -1294,28 +1361,12 @@ def svd(a, full_matrices=1, compute_uv=1):
         u = empty((1, 1), t)
         vt = empty((1, 1), t)
 
-    iwork = zeros((8*min(m, n),), fortran_int)
     if isComplexType(t):
-        lapack_routine = lapack_lite.zgesdd
-        rwork = zeros((5*min(m, n)*min(m, n) + 5*min(m, n),), real_t)
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, -1, rwork, iwork, 0)
-        lwork = int(abs(work[0]))
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, lwork, rwork, iwork, 0)
+        results = lapack_lite.zgesdd(option, m, n, a, m, s, u, m, vt, nvt,
+                                     None, 0, None, None, 0)
     else:
-        lapack_routine = lapack_lite.dgesdd
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, -1, iwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
-        results = lapack_routine(option, m, n, a, m, s, u, m, vt, nvt,
-                                 work, lwork, iwork, 0)
+        results = lapack_lite.dgesdd(option, m, n, a, m, s, u, m, vt, nvt,
+                                     None, 0, None, 0)
     if results['info'] > 0:
         raise LinAlgError, 'SVD did not converge'
     s = s.astype(_realType(result_t))
@@ -1326,6 +1377,23 @@ def svd(a, full_matrices=1, compute_uv=1):
     else:
         return s
 
+def _svd_stacked(a, wrap, full_matrices, compute_uv):
+    _assertNonEmpty(a)
+    t, result_t = _commonType(a)
+    lead = a.shape[:-2]
+    res = lapack_lite.svd_batched(_stacked(t, a), int(bool(full_matrices)),
+                                  int(bool(compute_uv)))
+    if res[-1] > 0:
+        raise LinAlgError, 'SVD did not converge'
+    if compute_uv:
+        u, s, vt = res[:3]
+        s = s.reshape(lead + s.shape[-1:]).astype(_realType(result_t))
+        u = u.reshape(lead + u.shape[-2:]).astype(result_t)
+        vt = vt.reshape(lead + vt.shape[-2:]).astype(result_t)
+        return wrap(u), s, wrap(vt)
+    s = res[0]
+    return s.reshape(lead + s.shape[-1:]).astype(_realType(result_t))
+
 def cond(x, p=None):
     """
     Compute the condition number of a matrix.
@@ -1567,16 +1635,16 @@ def slogdet(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
-        Input array.
+    a : array_like, shape (..., M, M)
+        Input array, or a stack of them.
 
     Returns
     -------
-    sign : float or complex
+    sign : float or complex, or ndarray for a stack
         A number representing the sign of the determinant. For a real matrix,
         this is 1, 0, or -1. For a complex matrix, this is a complex number
         with absolute value 1 (i.e., it is on the unit circle), or else 0.
-    logdet : float
+    logdet : float, or ndarray for a stack
         The natural log of the absolute value of the determinant.
 
     If the determinant is zero, then `sign` will be 0 and `logdet` will be
@@ -1613,6 +1681,16 @@ def slogdet(a):
 
     """
     a = asarray(a)
+    small_t = _smallType(a)
+    if small_t is not None:
+        sign, logdet = lapack_lite.small_slogdet(_stacked(small_t, a))
+        shape = a.shape[:-2]
+        return sign.reshape(shape)[()], logdet.reshape(shape)[()]
+    if a.ndim > 2:
+        _assertNdSquareness(a)
+        t, result_t = _commonType(a)
+        sign, logdet = lapack_lite.slogdet_batched(_stacked(t, a))
+        return sign.reshape(a.shape[:-2]), logdet.reshape(a.shape[:-2])
     _assertRank2(a)
     _assertSquareness(a)
     t, result_t = _commonType(a)
@@ -1644,7 +1722,7 @@ def det(a):
 
     Parameters
     ----------
-    a : array_like, shape (M, M)
+    a : array_like, shape (..., M, M)
         Input array.
 
     Returns
@@ -1655,7 +1733,8 @@ def det(a):
     Notes
     -----
     The determinant is computed via LU factorization using the LAPACK
-    routine z/dgetrf.
+    routine z/dgetrf.  Real 2x2, 3x3 and 4x4 matrices are factored the
+    same way, with partial pivoting, in C instead of by LAPACK.
 
     Examples
     --------
@@ -1671,6 +1750,11 @@ def det(a):
       for large matrices where underflow/overflow may occur.
 
     """
+    a = asarray(a)
+    small_t = _smallType(a)
+    if small_t is not None:
+        return lapack_lite.small_det(_stacked(small_t, a)).reshape(
+            a.shape[:-2])[()]
     sign, logdet = slogdet(a)
     return sign * exp(logdet)
 
@@ -1758,7 +1842,6 @@ def lstsq(a, b, rcond=-1):
     >>> plt.show()
 
     """
-    import math
     a, _ = _makearray(a)
     b, wrap = _makearray(b)
     is_1d = len(b.shape) == 1
@@ -1773,53 +1856,30 @@ def lstsq(a, b, rcond=-1):
         raise LinAlgError, 'Incompatible dimensions'
     t, result_t = _commonType(a, b)
     real_t = _linalgRealType(t)
-    bstar = zeros((ldb, n_rhs), t)
-    bstar[:b.shape[0],:n_rhs] = b.copy()
-    a, bstar = _fastCopyAndTranspose(t, a, bstar)
-    a, bstar = _to_native_byte_order(a, bstar)
+    # bstar is filled in Fortran order so LAPACK can work on it in place
+    bstar = zeros((ldb, n_rhs), t, order='F')
+    bstar[:m,:] = b
+    a = _fastCopyAndTranspose(t, a)
+    a = _to_native_byte_order(a)
     s = zeros((min(m, n),), real_t)
-    nlvl = max( 0, int( math.log( float(min(m, n))/2. ) ) + 1 )
-    iwork = zeros((3*min(m, n)*nlvl+11*min(m, n),), fortran_int)
+    # work=None lets lapack_lite query and provide the workspace itself
     if isComplexType(t):
-        lapack_routine = lapack_lite.zgelsd
-        lwork = 1
-        rwork = zeros((lwork,), real_t)
-        work = zeros((lwork,), t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, -1, rwork, iwork, 0)
-        lwork = int(abs(work[0]))
-        rwork = zeros((lwork,), real_t)
-        a_real = zeros((m, n), real_t)
-        bstar_real = zeros((ldb, n_rhs,), real_t)
-        results = lapack_lite.dgelsd(m, n, n_rhs, a_real, m,
-                                     bstar_real, ldb, s, rcond,
-                                     0, rwork, -1, iwork, 0)
-        lrwork = int(rwork[0])
-        work = zeros((lwork,), t)
-        rwork = zeros((lrwork,), real_t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, lwork, rwork, iwork, 0)
+        results = lapack_lite.zgelsd(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
+                                     0, None, 0, None, None, 0)
     else:
-        lapack_routine = lapack_lite.dgelsd
-        lwork = 1
-        work = zeros((lwork,), t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, -1, iwork, 0)
-        lwork = int(work[0])
-        work = zeros((lwork,), t)
-        results = lapack_routine(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
-                                 0, work, lwork, iwork, 0)
+        results = lapack_lite.dgelsd(m, n, n_rhs, a, m, bstar, ldb, s, rcond,
+                                     0, None, 0, None, 0)
     if results['info'] > 0:
         raise LinAlgError, 'SVD did not converge in Linear Least Squares'
     resids = array([], t)
     if is_1d:
-        x = array(ravel(bstar)[:n], dtype=result_t, copy=True)
+        x = array(bstar[:n,0], dtype=result_t, copy=True)
         if results['rank'] == n and m > n:
-            resids = array([sum((ravel(bstar)[n:])**2)], dtype=result_t)
+            resids = array([sum((bstar[n:,0])**2)], dtype=result_t)
     else:
-        x = array(transpose(bstar)[:n,:], dtype=result_t, copy=True)
+        x = array(bstar[:n,:], dtype=result_t, copy=True)
         if results['rank'] == n and m > n:
-            resids = sum((transpose(bstar)[n:,:])**2, axis=0).astype(result_t)
+            resids = sum((bstar[n:,:])**2, axis=0).astype(result_t)
     st = s[:min(n, m)].copy().astype(_realType(result_t))
     return wrap(x), wrap(resids), results['rank'], st
 
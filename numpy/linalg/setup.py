@@ -20,6 +20,11 @@ def configuration(parent_package='',top_path=None):
                 return ext.depends[:1]
             return ext.depends[:2]
 
+    if lapack_info:
+        # The f2c sources keep static state and are not thread-safe
+        define_macros = [('HAVE_EXTERNAL_LAPACK', None)]
+    else:
+        define_macros = []
     config.add_extension('lapack_lite',
                          sources = [get_lapack_lite_sources],
                          depends=  ['lapack_litemodule.c',
@@ -27,6 +32,7 @@ def configuration(parent_package='',top_path=None):
                                     'zlapack_lite.c', 'dlapack_lite.c',
                                     'blas_lite.c', 'dlamch.c',
                                     'f2c_lite.c','f2c.h'],
+                         define_macros = define_macros,
                          extra_info = lapack_info
                          )
 
@@ -6,6 +6,7 @@ from numpy.testing import *
 from numpy import array, single, double, csingle, cdouble, dot, identity
 from numpy import multiply, atleast_2d, inf, asarray, matrix
 from numpy import linalg
+from numpy.linalg import lapack_lite
 from numpy.linalg import matrix_power, norm, matrix_rank
 
 def ifthen(a, b):
@@ -277,6 +278,182 @@ class TestEigh(HermitianTestCase, TestCase):
         evalues.sort()
         assert_almost_equal(ev, evalues)
 
+class TestStacked(TestCase):
+    def setUp(self):
+        np.random.seed(1234)
+        a = np.random.rand(2, 3, 4, 4) + 1j*np.random.rand(2, 3, 4, 4)
+        self.a = {double: a.real.copy(), cdouble: a}
+        self.h = {}
+        for t, x in self.a.items():
+            xh = np.swapaxes(x, -1, -2).conj()
+            self.h[t] = np.array([[dot(x[i, j], xh[i, j]) + 4*identity(4)
+                                   for j in range(3)] for i in range(2)])
+
+    def each(self, x):
+        return [(i, j) for i in range(x.shape[0]) for j in range(x.shape[1])]
+
+    def test_solve(self):
+        for a in self.a.values():
+            b = a[..., :2] + 1
+            x = linalg.solve(a, b)
+            xv = linalg.solve(a, b[..., 0])
+            for i, j in self.each(a):
+                assert_almost_equal(x[i, j], linalg.solve(a[i, j], b[i, j]))
+                assert_almost_equal(xv[i, j],
+                                    linalg.solve(a[i, j], b[i, j, :, 0]))
+
+    def test_inv(self):
+        for a in self.a.values():
+            x = linalg.inv(a)
+            for i, j in self.each(a):
+                assert_almost_equal(x[i, j], linalg.inv(a[i, j]))
+
+    def test_det(self):
+        for a in self.a.values():
+            sign, logdet = linalg.slogdet(a)
+            d = linalg.det(a)
+            for i, j in self.each(a):
+                s2, l2 = linalg.slogdet(a[i, j])
+                assert_almost_equal(sign[i, j], s2)
+                assert_almost_equal(logdet[i, j], l2)
+                assert_almost_equal(d[i, j], linalg.det(a[i, j]))
+
+    def test_singular(self):
+        a = self.a[double].copy()
+        a[1, 2] = 0
+        assert_raises(linalg.LinAlgError, linalg.inv, a)
+        sign, logdet = linalg.slogdet(a)
+        assert_equal(sign[1, 2], 0)
+        assert_equal(logdet[1, 2], -inf)
+
+    def test_fortran_order(self):
+        a = self.a[double].reshape(6, 4, 4)
+        for f in [lapack_lite.inv_batched, lapack_lite.small_inv]:
+            assert_raises(lapack_lite.LapackError, f, np.asfortranarray(a))
+        assert_almost_equal(linalg.inv(np.asfortranarray(a)), linalg.inv(a))
+
+    def test_cholesky(self):
+        for h in self.h.values():
+            l = linalg.cholesky(h)
+            for i, j in self.each(h):
+                assert_almost_equal(l[i, j], linalg.cholesky(h[i, j]))
+        assert_raises(linalg.LinAlgError, linalg.cholesky, -self.h[double])
+
+    def test_eigh(self):
+        for h in self.h.values():
+            for uplo in 'LU':
+                w, v = linalg.eigh(h, uplo)
+                w2 = linalg.eigvalsh(h, uplo)
+                for i, j in self.each(h):
+                    x = h[i, j]
+                    assert_almost_equal(dot(x, v[i, j]), w[i, j]*v[i, j])
+                    assert_almost_equal(w2[i, j], linalg.eigvalsh(x, uplo))
+
+    def test_svd(self):
+        for a in self.a.values():
+            a = a[..., :3]
+            for full in [True, False]:
+                u, s, vt = linalg.svd(a, full)
+                for i, j in self.each(a):
+                    k = s.shape[-1]
+                    assert_almost_equal(dot(u[i, j, :, :k]*s[i, j],
+                                            vt[i, j, :k]), a[i, j])
+                    assert_almost_equal(s[i, j], linalg.svd(a[i, j], 0, 0))
+            assert_equal(linalg.svd(a)[0].shape, (2, 3, 4, 4))
+            assert_equal(linalg.svd(a, False)[0].shape, (2, 3, 4, 3))
+            assert_equal(linalg.svd(a, compute_uv=False).shape, (2, 3, 3))
+
+
+class TestSmall(TestCase):
+    """2x2 to 4x4 real matrices take the closed-form kernels."""
+    def setUp(self):
+        np.random.seed(1234)
+
+    def check(self, t, n):
+        dec = {single: 5, double: 12}[t]
+        a = (np.random.rand(5, n, n) + n*identity(n)).astype(t)
+        b = np.random.rand(5, n, 2).astype(t)
+        ad = a.astype(double)
+        sign, logdet = lapack_lite.slogdet_batched(ad)
+        old_assert_almost_equal(linalg.det(a)/(sign*np.exp(logdet)), 1, 12)
+        old_assert_almost_equal(linalg.slogdet(a)[1], logdet, 12)
+        ainv = linalg.inv(a)
+        x = linalg.solve(a, b)
+        assert_equal(ainv.dtype, t)
+        assert_equal(x.dtype, t)
+        for i in range(5):
+            old_assert_almost_equal(dot(a[i], ainv[i]), identity(n), dec)
+            old_assert_almost_equal(dot(a[i], x[i]), b[i], dec)
+            old_assert_almost_equal(linalg.det(a[i]), linalg.det(ad[i]), 12)
+        h = a + np.swapaxes(a, -1, -2)
+        w, v = linalg.eigh(h)
+        assert_equal(w.dtype, t)
+        for i in range(5):
+            old_assert_almost_equal(dot(h[i], v[i]), w[i]*v[i], dec)
+            old_assert_almost_equal(dot(v[i].T, v[i]), identity(n), dec)
+            assert_(np.all(np.diff(w[i]) >= 0))
+        lower = np.tri(n, dtype=t)
+        for uplo, g in [('L', h*lower), ('U', h*lower.T)]:
+            old_assert_almost_equal(linalg.eigvalsh(g, uplo), w, dec)
+
+    def test_sizes(self):
+        for t in [single, double]:
+            for n in [2, 3, 4]:
+                self.check(t, n)
+
+    def test_singular(self):
+        a = array([[1., 2.], [2., 4.]])
+        assert_equal(linalg.det(a), 0)
+        assert_equal(linalg.slogdet(a), (0, -inf))
+        self.assertRaises(linalg.LinAlgError, linalg.inv, a)
+        self.assertRaises(linalg.LinAlgError, linalg.solve, a, [1, 2])
+
+    def test_scaling(self):
+        for n in [2, 3, 4]:
+            for s in [1e-100, 1e-80, 1e80, 1e100]:
+                a = s*identity(n)
+                old_assert_almost_equal(linalg.inv(a)*s, identity(n), 12)
+                old_assert_almost_equal(linalg.solve(a, np.ones(n))*s,
+                                        np.ones(n), 12)
+                old_assert_almost_equal(linalg.slogdet(a)[1], n*np.log(s),
+                                        12)
+        a = np.diag([1e-200, 1e-200, 1e200, 1e200])
+        old_assert_almost_equal(linalg.det(a), 1, 12)
+        a = array([[1e-20, 1.], [1., 1.]])
+        old_assert_almost_equal(linalg.solve(a, [1., 2.]), [1., 1.], 12)
+
+    def test_types(self):
+        a = [[1, 2], [3, 4]]
+        assert_equal(type(linalg.det(a)), double)
+        assert_equal(linalg.det(a), -2)
+        assert_equal(linalg.solve(a, [5, 6]).shape, (2,))
+        assert_(isinstance(linalg.inv(matrix(a)), matrix))
+
+
+class TestWorkspace(TestCase):
+    """Repeated calls of varying size share the internal workspace."""
+    def test_varying_sizes(self):
+        np.random.seed(1234)
+        for n in [40, 3, 17, 1, 40]:
+            for t in [double, cdouble]:
+                a = np.random.rand(n + 2, n).astype(t)
+                h = dot(a.T.conj(), a)
+                w, v = linalg.eigh(h)
+                assert_almost_equal(dot(h, v), w*v)
+                assert_almost_equal(w, linalg.eigvalsh(h))
+                u, s, vt = linalg.svd(a, 0)
+                assert_almost_equal(dot(u*s, vt), a)
+                b = np.random.rand(n + 2, 2)
+                x, resids, rank, sv = linalg.lstsq(a, b)
+                assert_almost_equal(sv, s)
+                assert_almost_equal(dot(a.T.conj(), dot(a, x) - b), 0)
+                if t is double:
+                    r = b - dot(a, x)
+                    assert_almost_equal(resids, (r*r).sum(axis=0))
+                x1 = linalg.lstsq(a, b[:, 0])[0]
+                assert_almost_equal(x1, x[:, 0])
+
+
 class _TestNorm(TestCase):
     dt = None
     dec = None
@@ -43,6 +43,7 @@
 
 #include <math.h>
 #include "distributions.h"
+#include "ziggurat_constants.h"
 #include <stdio.h>
 
 #ifndef min
@@ -110,6 +111,85 @@ double rk_standard_exponential(rk_state *state)
     return -log(1.0 - rk_double(state));
 }
 
+/*
+ * Ziggurat samplers (Marsaglia and Tsang 2000) using 256 layers. Two 32 bit
+ * words are drawn per attempt: the low 8 bits of the first pick the layer,
+ * bit 8 the sign, and the upper 21 bits of the first together with the
+ * second word form a 53 bit magnitude. About 99% of the draws are accepted
+ * by the first comparison and cost no transcendental function at all.
+ */
+double rk_gauss_zig(rk_state *state)
+{
+    unsigned long r;
+    double rabs, x, xx, yy;
+    int idx, sign;
+
+    for (;;)
+    {
+        r = rk_random(state);
+        idx = r & 0xff;
+        sign = (r >> 8) & 0x1;
+        rabs = (double)(r >> 11) * 4294967296.0 + (double)rk_random(state);
+        x = rabs * rk_zig_wi_normal[idx];
+        if (sign)
+        {
+            x = -x;
+        }
+        if (rabs < rk_zig_ki_normal[idx])
+        {
+            return x;
+        }
+        if (idx == 0)
+        {
+            /* Sample from the tail beyond RK_ZIG_NORMAL_R */
+            for (;;)
+            {
+                xx = -RK_ZIG_NORMAL_INV_R * log(1.0 - rk_double(state));
+                yy = -log(1.0 - rk_double(state));
+                if (yy + yy > xx * xx)
+                {
+                    return sign ? -(RK_ZIG_NORMAL_R + xx)
+                                : RK_ZIG_NORMAL_R + xx;
+                }
+            }
+        }
+        if ((rk_zig_fi_normal[idx - 1] - rk_zig_fi_normal[idx])
+                * rk_double(state) + rk_zig_fi_normal[idx] < exp(-0.5 * x * x))
+        {
+            return x;
+        }
+    }
+}
+
+double rk_standard_exponential_zig(rk_state *state)
+{
+    unsigned long r;
+    double rabs, x;
+    int idx;
+
+    for (;;)
+    {
+        r = rk_random(state);
+        idx = r & 0xff;
+        rabs = (double)(r >> 11) * 4294967296.0 + (double)rk_random(state);
+        x = rabs * rk_zig_wi_exp[idx];
+        if (rabs < rk_zig_ki_exp[idx])
+        {
+            return x;
+        }
+        if (idx == 0)
+        {
+            /* The tail of the exponential is again exponential */
+            return RK_ZIG_EXP_R + rk_standard_exponential_zig(state);
+        }
+        if ((rk_zig_fi_exp[idx - 1] - rk_zig_fi_exp[idx]) * rk_double(state)
+                + rk_zig_fi_exp[idx] < exp(-x))
+        {
+            return x;
+        }
+    }
+}
+
 double rk_exponential(rk_state *state, double scale)
 {
     return scale * rk_standard_exponential(state);
@@ -120,21 +200,24 @@ double rk_uniform(rk_state *state, double loc, double scale)
     return loc + scale*rk_double(state);
 }
 
-double rk_standard_gamma(rk_state *state, double shape)
+/* Marsaglia and Tsang with the given normal and exponential generators */
+static double standard_gamma(rk_state *state, double shape,
+                             double (*gauss)(rk_state *state),
+                             double (*standard_exponential)(rk_state *state))
 {
     double b, c;
     double U, V, X, Y;
 
     if (shape == 1.0)
     {
-        return rk_standard_exponential(state);
+        return standard_exponential(state);
     }
     else if (shape < 1.0)
     {
         for (;;)
         {
             U = rk_double(state);
-            V = rk_standard_exponential(state);
+            V = standard_exponential(state);
             if (U <= 1.0 - shape)
             {
                 X = pow(U, 1./shape);
@@ -162,7 +245,7 @@ double rk_standard_gamma(rk_state *state, double shape)
         {
             do
             {
-                X = rk_gauss(state); 
+                X = gauss(state); 
                 V = 1.0 + c*X;
             } while (V <= 0.0);
 
@@ -174,12 +257,29 @@ double rk_standard_gamma(rk_state *state, double shape)
     }
 }
 
+double rk_standard_gamma(rk_state *state, double shape)
+{
+    return standard_gamma(state, shape, rk_gauss, rk_standard_exponential);
+}
+
+double rk_standard_gamma_zig(rk_state *state, double shape)
+{
+    return standard_gamma(state, shape, rk_gauss_zig,
+                          rk_standard_exponential_zig);
+}
+
 double rk_gamma(rk_state *state, double shape, double scale)
 {
     return scale * rk_standard_gamma(state, shape);
 }
 
-double rk_beta(rk_state *state, double a, double b)
+double rk_gamma_zig(rk_state *state, double shape, double scale)
+{
+    return scale * rk_standard_gamma_zig(state, shape);
+}
+
+static double beta(rk_state *state, double a, double b,
+                   double (*std_gamma)(rk_state *state, double shape))
 {
     double Ga, Gb;
 
@@ -203,17 +303,32 @@ double rk_beta(rk_state *state, double a, double b)
     }
     else
     {
-        Ga = rk_standard_gamma(state, a);
-        Gb = rk_standard_gamma(state, b);
+        Ga = std_gamma(state, a);
+        Gb = std_gamma(state, b);
         return Ga/(Ga + Gb);
     }
 }
 
+double rk_beta(rk_state *state, double a, double b)
+{
+    return beta(state, a, b, rk_standard_gamma);
+}
+
+double rk_beta_zig(rk_state *state, double a, double b)
+{
+    return beta(state, a, b, rk_standard_gamma_zig);
+}
+
 double rk_chisquare(rk_state *state, double df)
 {
     return 2.0*rk_standard_gamma(state, df/2.0);
 }
 
+double rk_chisquare_zig(rk_state *state, double df)
+{
+    return 2.0*rk_standard_gamma_zig(state, df/2.0);
+}
+
 double rk_noncentral_chisquare(rk_state *state, double df, double nonc)
 {
     double Chi2, N;
@@ -550,6 +665,16 @@ double rk_standard_t(rk_state *state, double df)
     return X;
 }
 
+double rk_standard_t_zig(rk_state *state, double df)
+{
+    double N, G, X;
+
+    N = rk_gauss_zig(state);
+    G = rk_standard_gamma_zig(state, df/2);
+    X = sqrt(df/2)*N/sqrt(G);
+    return X;
+}
+
 /* Uses the rejection algorithm compared against the wrapped Cauchy
    distribution suggested by Best and Fisher and documented in 
    Chapter 9 of Luc's Non-Uniform Random Variate Generation.
@@ -45,6 +45,9 @@ extern "C" {
  * Marsaglia, G. and Tsang, W. W. A Simple Method for Generating Gamma 
  * Variables. ACM Transactions on Mathematical Software, Vol. 26, No. 3,
  * September 2000, Pages 363–372.
+ *
+ * Marsaglia, G. and Tsang, W. W. The Ziggurat Method for Generating Random
+ * Variables. Journal of Statistical Software, Vol. 5, No. 8, 2000.
  */
  
 /* Normal distribution with mean=loc and standard deviation=scale. */
@@ -54,6 +57,13 @@ extern double rk_normal(rk_state *state, double loc, double scale);
  * CDF. */
 extern double rk_standard_exponential(rk_state *state);
 
+/* Standard normal and standard exponential distributions computed with the
+ * Ziggurat method (Marsaglia and Tsang 2000). These draw different streams
+ * than rk_gauss() and rk_standard_exponential() but are several times
+ * faster. */
+extern double rk_gauss_zig(rk_state *state);
+extern double rk_standard_exponential_zig(rk_state *state);
+
 /* Exponential distribution with mean=scale. */
 extern double rk_exponential(rk_state *state, double scale);
 
@@ -68,16 +78,24 @@ extern double rk_uniform(rk_state *state, double loc, double scale);
  */
 extern double rk_standard_gamma(rk_state *state, double shape);
 
+/* The _zig variants of the gamma family below draw their normal and
+ * exponential variates with rk_gauss_zig() and
+ * rk_standard_exponential_zig(), which gives a different stream. */
+extern double rk_standard_gamma_zig(rk_state *state, double shape);
+
 /* Gamma distribution with shape and scale. */
 extern double rk_gamma(rk_state *state, double shape, double scale);
+extern double rk_gamma_zig(rk_state *state, double shape, double scale);
 
 /* Beta distribution computed by combining two gamma variates (Devroye p. 432).
  */
 extern double rk_beta(rk_state *state, double a, double b);
+extern double rk_beta_zig(rk_state *state, double a, double b);
 
 /* Chi^2 distribution computed by transforming a gamma variate (it being a
  * special case Gamma(df/2, 2)). */
 extern double rk_chisquare(rk_state *state, double df);
+extern double rk_chisquare_zig(rk_state *state, double df);
 
 /* Noncentral Chi^2 distribution computed by modifying a Chi^2 variate. */
 extern double rk_noncentral_chisquare(rk_state *state, double df, double nonc);
@@ -126,6 +144,7 @@ extern double rk_standard_cauchy(rk_state *state);
 /* Standard t-distribution with df degrees of freedom (Devroye p. 445 as
  * corrected in the Errata). */
 extern double rk_standard_t(rk_state *state, double df);
+extern double rk_standard_t_zig(rk_state *state, double df);
 
 /* von Mises circular distribution with center mu and shape kappa on [-pi,pi]
  * (Devroye p. 476 as corrected in the Errata). */
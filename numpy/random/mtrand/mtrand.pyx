@@ -59,27 +59,42 @@ cdef extern from "randomkit.h":
     unsigned long rk_ulong(rk_state *state)
     unsigned long rk_interval(unsigned long max, rk_state *state)
     double rk_double(rk_state *state)
+    void rk_fill_doubles(double *out, size_t n, rk_state *state)
+    void rk_fill_uint32(unsigned int *out, size_t n, rk_state *state)
     void rk_fill(void *buffer, size_t size, rk_state *state)
     rk_error rk_devfill(void *buffer, size_t size, int strong)
     rk_error rk_altfill(void *buffer, size_t size, int strong,
             rk_state *state)
     double rk_gauss(rk_state *state)
+    void rk_jump(rk_state *state)
+    void rk_spawn(rk_state *state, rk_state *children, size_t n)
+
+cdef extern from "mtrand_py_helper.h":
+    int fill_doubles_threaded(double *out, size_t n, rk_state *state,
+                              int nthreads)
 
 cdef extern from "distributions.h":
 
     double rk_normal(rk_state *state, double loc, double scale)
     double rk_standard_exponential(rk_state *state)
+    double rk_gauss_zig(rk_state *state)
+    double rk_standard_exponential_zig(rk_state *state)
     double rk_exponential(rk_state *state, double scale)
     double rk_uniform(rk_state *state, double loc, double scale)
     double rk_standard_gamma(rk_state *state, double shape)
+    double rk_standard_gamma_zig(rk_state *state, double shape)
     double rk_gamma(rk_state *state, double shape, double scale)
+    double rk_gamma_zig(rk_state *state, double shape, double scale)
     double rk_beta(rk_state *state, double a, double b)
+    double rk_beta_zig(rk_state *state, double a, double b)
     double rk_chisquare(rk_state *state, double df)
+    double rk_chisquare_zig(rk_state *state, double df)
     double rk_noncentral_chisquare(rk_state *state, double df, double nonc)
     double rk_f(rk_state *state, double dfnum, double dfden)
     double rk_noncentral_f(rk_state *state, double dfnum, double dfden, double nonc)
     double rk_standard_cauchy(rk_state *state)
     double rk_standard_t(rk_state *state, double df)
+    double rk_standard_t_zig(rk_state *state, double df)
     double rk_vonmises(rk_state *state, double mu, double kappa)
     double rk_pareto(rk_state *state, double a)
     double rk_weibull(rk_state *state, double a)
@@ -141,6 +156,81 @@ cdef object cont0_array(rk_state *state, rk_cont0 func, object size):
             array_data[i] = func(state)
         return array
 
+cdef object uniform_fill(rk_state *state, object size, double loc, double scale,
+                         object threads):
+    # Same draws as rk_uniform, generated a whole state block at a time.
+    # With threads, the draws come from chunked substreams instead.
+    cdef double *array_data
+    cdef ndarray array "arrayObject"
+    cdef npy_intp length
+    cdef npy_intp i
+    cdef int nthreads
+
+    if threads is not None:
+        nthreads = threads
+        if nthreads < 1:
+            raise ValueError("threads < 1")
+    if size is None:
+        return loc + scale*rk_double(state)
+    else:
+        array = <ndarray>np.empty(size, np.float64)
+        length = PyArray_SIZE(array)
+        array_data = <double *>array.data
+        if threads is None:
+            # The GIL is kept, as it is what serializes all use of the state.
+            rk_fill_doubles(array_data, length, state)
+        elif fill_doubles_threaded(array_data, length, state, nthreads) < 0:
+            raise MemoryError
+        if loc != 0.0 or scale != 1.0:
+            for i from 0 <= i < length:
+                array_data[i] = loc + scale*array_data[i]
+        return array
+
+cdef object exponential_fill(rk_state *state, object size, double scale):
+    # Same draws as rk_exponential, from a block of uniforms.
+    cdef double *array_data
+    cdef ndarray array "arrayObject"
+    cdef npy_intp length
+    cdef npy_intp i
+
+    if size is None:
+        return rk_exponential(state, scale)
+    else:
+        array = <ndarray>np.empty(size, np.float64)
+        length = PyArray_SIZE(array)
+        array_data = <double *>array.data
+        rk_fill_doubles(array_data, length, state)
+        for i from 0 <= i < length:
+            array_data[i] = scale * -log(1.0 - array_data[i])
+        return array
+
+
+cdef void shuffle_raw(rk_state *state, char *data, npy_intp n,
+                      npy_intp stride, npy_intp rowbytes, char *buf):
+    # Fisher-Yates on rows of rowbytes bytes, stride bytes apart. The
+    # indices are drawn as in the generic shuffle so the streams agree.
+    cdef npy_intp i, j
+    cdef char *a
+    cdef char *b
+
+    i = n - 1
+    while i > 0:
+        j = rk_interval(i, state)
+        if j != i:
+            a = data + i*stride
+            b = data + j*stride
+            memcpy(buf, a, rowbytes)
+            memcpy(a, b, rowbytes)
+            memcpy(b, buf, rowbytes)
+        i = i - 1
+
+cdef int use_ziggurat(object method) except -1:
+    # The method argument of the gamma family: 1 for 'zig', 0 for 'polar'.
+    if method == 'zig':
+        return 1
+    if method != 'polar':
+        raise ValueError("method must be 'polar' or 'zig'")
+    return 0
 
 cdef object cont1_array_sc(rk_state *state, rk_cont1 func, object size, double a):
     cdef double *array_data
@@ -704,6 +794,70 @@ cdef class RandomState:
         self.internal_state.has_gauss = has_gauss
         self.internal_state.gauss = cached_gaussian
 
+    def jump(self):
+        """
+        jump()
+
+        Advance the generator by 2**128 draws.
+
+        The jump takes about as long as drawing 20000 numbers and discards
+        a cached Gaussian deviate.
+
+        See Also
+        --------
+        spawn : Independent generators derived from this one.
+
+        """
+        rk_jump(self.internal_state)
+
+    def spawn(self, n):
+        """
+        spawn(n)
+
+        Return `n` independent generators derived from this one.
+
+        The i-th generator continues from the current state advanced by i
+        jumps of 2**128 draws (see `jump`), and this generator is left `n`
+        jumps ahead, so none of the streams overlap in practice. The result
+        only depends on the state of this generator, which makes it a
+        reproducible way to give every thread its own stream.
+
+        Parameters
+        ----------
+        n : int
+            Number of generators.
+
+        Returns
+        -------
+        out : list of RandomState
+
+        Examples
+        --------
+        Fill a large array in fixed chunks of 2**20 values, one stream per
+        chunk. The chunks can be handed to any number of threads, and the
+        result does not depend on how many there are or in which order
+        they run:
+
+        >>> out = np.empty(2**24)
+        >>> chunks = range(0, out.size, 2**20)
+        >>> streams = np.random.RandomState(1234).spawn(len(chunks))
+        >>> def work(i):
+        ...     start = chunks[i]
+        ...     out[start:start + 2**20] = streams[i].random_sample(2**20)
+
+        """
+        cdef RandomState child
+        cdef long i
+
+        if n < 0:
+            raise ValueError("n < 0")
+        children = []
+        for i from 0 <= i < n:
+            child = RandomState(0)
+            rk_spawn(self.internal_state, child.internal_state, 1)
+            children.append(child)
+        return children
+
     # Pickling support:
     def __getstate__(self):
         return self.get_state()
@@ -715,9 +869,9 @@ cdef class RandomState:
         return (np.random.__RandomState_ctor, (), self.get_state())
 
     # Basic distributions:
-    def random_sample(self, size=None):
+    def random_sample(self, size=None, threads=None):
         """
-        random_sample(size=None)
+        random_sample(size=None, threads=None)
 
         Return random floats in the half-open interval [0.0, 1.0).
 
@@ -732,6 +886,9 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Defines the shape of the returned array of random floats. If None
             (the default), returns a single float.
+        threads : int, optional
+            Number of threads to fill the array with; see Notes.  If None
+            (the default), the array is filled from the generator itself.
 
         Returns
         -------
@@ -739,6 +896,15 @@ cdef class RandomState:
             Array of random floats of shape `size` (unless ``size=None``, in which
             case a single float is returned).
 
+        Notes
+        -----
+        If `threads` is given, the array is filled in chunks of 2**21
+        values, chunk ``i`` from the substream ``spawn`` would return as
+        child ``i``, using up to `threads` threads.  The values are the
+        same for any number of threads, but differ from those drawn with
+        ``threads=None``, and the generator is left as if ``spawn`` had
+        been called with the number of chunks.
+
         Examples
         --------
         >>> np.random.random_sample()
@@ -756,7 +922,7 @@ cdef class RandomState:
                [-1.23204345, -1.75224494]])
 
         """
-        return cont0_array(self.internal_state, rk_double, size)
+        return uniform_fill(self.internal_state, size, 0.0, 1.0, threads)
 
     def tomaxint(self, size=None):
         """
@@ -890,9 +1056,9 @@ cdef class RandomState:
         rk_fill(bytes, length, self.internal_state)
         return bytestring
 
-    def uniform(self, low=0.0, high=1.0, size=None):
+    def uniform(self, low=0.0, high=1.0, size=None, threads=None):
         """
-        uniform(low=0.0, high=1.0, size=1)
+        uniform(low=0.0, high=1.0, size=1, threads=None)
 
         Draw samples from a uniform distribution.
 
@@ -913,6 +1079,9 @@ cdef class RandomState:
             Shape of output.  If the given size is, for example, (m,n,k),
             m*n*k samples are generated.  If no shape is specified, a single sample
             is returned.
+        threads : int, optional
+            Number of threads to fill the output with when `low` and `high`
+            are scalars, as in `random_sample`.
 
         Returns
         -------
@@ -968,7 +1137,8 @@ cdef class RandomState:
         flow = PyFloat_AsDouble(low)
         fhigh = PyFloat_AsDouble(high)
         if not PyErr_Occurred():
-            return cont2_array_sc(self.internal_state, rk_uniform, size, flow, fhigh-flow)
+            return uniform_fill(self.internal_state, size, flow, fhigh-flow,
+                                threads)
         PyErr_Clear()
         olow = <ndarray>PyArray_FROM_OTF(low, NPY_DOUBLE, NPY_ALIGNED)
         ohigh = <ndarray>PyArray_FROM_OTF(high, NPY_DOUBLE, NPY_ALIGNED)
@@ -1155,9 +1325,9 @@ cdef class RandomState:
         return self.randint(low, high+1, size)
 
     # Complicated, continuous distributions:
-    def standard_normal(self, size=None):
+    def standard_normal(self, size=None, method='polar'):
         """
-        standard_normal(size=None)
+        standard_normal(size=None, method='polar')
 
         Returns samples from a Standard Normal distribution (mean=0, stdev=1).
 
@@ -1166,6 +1336,10 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Output shape. Default is None, in which case a single value is
             returned.
+        method : {'polar', 'zig'}, optional
+            Sampling algorithm. 'polar' is the polar Box-Muller method used
+            by default to keep seeded streams reproducible; 'zig' uses the
+            faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -1185,6 +1359,10 @@ cdef class RandomState:
         (3, 4, 2)
 
         """
+        if method == 'zig':
+            return cont0_array(self.internal_state, rk_gauss_zig, size)
+        if method != 'polar':
+            raise ValueError("method must be 'polar' or 'zig'")
         return cont0_array(self.internal_state, rk_gauss, size)
 
     def normal(self, loc=0.0, scale=1.0, size=None):
@@ -1287,9 +1465,9 @@ cdef class RandomState:
             raise ValueError("scale <= 0")
         return cont2_array(self.internal_state, rk_normal, size, oloc, oscale)
 
-    def beta(self, a, b, size=None):
+    def beta(self, a, b, size=None, method='polar'):
         """
-        beta(a, b, size=None)
+        beta(a, b, size=None, method='polar')
 
         The Beta distribution over ``[0, 1]``.
 
@@ -1316,6 +1494,10 @@ cdef class RandomState:
         size : tuple of ints, optional
             The number of samples to draw.  The ouput is packed according to
             the size given.
+        method : {'polar', 'zig'}, optional
+            Algorithm for the underlying normal and exponential variates.
+            'polar' (the default) keeps seeded streams reproducible; 'zig'
+            uses the faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -1326,6 +1508,12 @@ cdef class RandomState:
         """
         cdef ndarray oa, ob
         cdef double fa, fb
+        cdef rk_cont2 func
+
+        if use_ziggurat(method):
+            func = rk_beta_zig
+        else:
+            func = rk_beta
 
         fa = PyFloat_AsDouble(a)
         fb = PyFloat_AsDouble(b)
@@ -1334,7 +1522,7 @@ cdef class RandomState:
                 raise ValueError("a <= 0")
             if fb <= 0:
                 raise ValueError("b <= 0")
-            return cont2_array_sc(self.internal_state, rk_beta, size, fa, fb)
+            return cont2_array_sc(self.internal_state, func, size, fa, fb)
 
         PyErr_Clear()
 
@@ -1344,7 +1532,7 @@ cdef class RandomState:
             raise ValueError("a <= 0")
         if np.any(np.less_equal(ob, 0)):
             raise ValueError("b <= 0")
-        return cont2_array(self.internal_state, rk_beta, size, oa, ob)
+        return cont2_array(self.internal_state, func, size, oa, ob)
 
     def exponential(self, scale=1.0, size=None):
         """
@@ -1391,7 +1579,7 @@ cdef class RandomState:
         if not PyErr_Occurred():
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont1_array_sc(self.internal_state, rk_exponential, size, fscale)
+            return exponential_fill(self.internal_state, size, fscale)
 
         PyErr_Clear()
 
@@ -1400,9 +1588,9 @@ cdef class RandomState:
             raise ValueError("scale <= 0")
         return cont1_array(self.internal_state, rk_exponential, size, oscale)
 
-    def standard_exponential(self, size=None):
+    def standard_exponential(self, size=None, method='inv'):
         """
-        standard_exponential(size=None)
+        standard_exponential(size=None, method='inv')
 
         Draw samples from the standard exponential distribution.
 
@@ -1413,6 +1601,10 @@ cdef class RandomState:
         ----------
         size : int or tuple of ints
             Shape of the output.
+        method : {'inv', 'zig'}, optional
+            Sampling algorithm. 'inv' inverts the CDF and is the default;
+            'zig' uses the faster Ziggurat method, which draws a different
+            stream.
 
         Returns
         -------
@@ -1426,11 +1618,16 @@ cdef class RandomState:
         >>> n = np.random.standard_exponential((3, 8000))
 
         """
-        return cont0_array(self.internal_state, rk_standard_exponential, size)
-
-    def standard_gamma(self, shape, size=None):
+        if method == 'zig':
+            return cont0_array(self.internal_state,
+                               rk_standard_exponential_zig, size)
+        if method != 'inv':
+            raise ValueError("method must be 'inv' or 'zig'")
+        return exponential_fill(self.internal_state, size, 1.0)
+
+    def standard_gamma(self, shape, size=None, method='polar'):
         """
-        standard_gamma(shape, size=None)
+        standard_gamma(shape, size=None, method='polar')
 
         Draw samples from a Standard Gamma distribution.
 
@@ -1444,6 +1641,10 @@ cdef class RandomState:
         size : int or tuple of ints
             Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
             ``m * n * k`` samples are drawn.
+        method : {'polar', 'zig'}, optional
+            Algorithm for the underlying normal and exponential variates.
+            'polar' (the default) keeps seeded streams reproducible; 'zig'
+            uses the faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -1497,22 +1698,28 @@ cdef class RandomState:
         """
         cdef ndarray oshape
         cdef double fshape
+        cdef rk_cont1 func
+
+        if use_ziggurat(method):
+            func = rk_standard_gamma_zig
+        else:
+            func = rk_standard_gamma
 
         fshape = PyFloat_AsDouble(shape)
         if not PyErr_Occurred():
             if fshape <= 0:
                 raise ValueError("shape <= 0")
-            return cont1_array_sc(self.internal_state, rk_standard_gamma, size, fshape)
+            return cont1_array_sc(self.internal_state, func, size, fshape)
 
         PyErr_Clear()
         oshape = <ndarray> PyArray_FROM_OTF(shape, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(oshape, 0.0)):
             raise ValueError("shape <= 0")
-        return cont1_array(self.internal_state, rk_standard_gamma, size, oshape)
+        return cont1_array(self.internal_state, func, size, oshape)
 
-    def gamma(self, shape, scale=1.0, size=None):
+    def gamma(self, shape, scale=1.0, size=None, method='polar'):
         """
-        gamma(shape, scale=1.0, size=None)
+        gamma(shape, scale=1.0, size=None, method='polar')
 
         Draw samples from a Gamma distribution.
 
@@ -1529,6 +1736,10 @@ cdef class RandomState:
         size : shape_tuple, optional
             Output shape.  If the given shape is, e.g., ``(m, n, k)``, then
             ``m * n * k`` samples are drawn.
+        method : {'polar', 'zig'}, optional
+            Algorithm for the underlying normal and exponential variates.
+            'polar' (the default) keeps seeded streams reproducible; 'zig'
+            uses the faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -1582,6 +1793,12 @@ cdef class RandomState:
         """
         cdef ndarray oshape, oscale
         cdef double fshape, fscale
+        cdef rk_cont2 func
+
+        if use_ziggurat(method):
+            func = rk_gamma_zig
+        else:
+            func = rk_gamma
 
         fshape = PyFloat_AsDouble(shape)
         fscale = PyFloat_AsDouble(scale)
@@ -1590,7 +1807,7 @@ cdef class RandomState:
                 raise ValueError("shape <= 0")
             if fscale <= 0:
                 raise ValueError("scale <= 0")
-            return cont2_array_sc(self.internal_state, rk_gamma, size, fshape, fscale)
+            return cont2_array_sc(self.internal_state, func, size, fshape, fscale)
 
         PyErr_Clear()
         oshape = <ndarray>PyArray_FROM_OTF(shape, NPY_DOUBLE, NPY_ALIGNED)
@@ -1599,7 +1816,7 @@ cdef class RandomState:
             raise ValueError("shape <= 0")
         if np.any(np.less_equal(oscale, 0.0)):
             raise ValueError("scale <= 0")
-        return cont2_array(self.internal_state, rk_gamma, size, oshape, oscale)
+        return cont2_array(self.internal_state, func, size, oshape, oscale)
 
     def f(self, dfnum, dfden, size=None):
         """
@@ -1799,9 +2016,9 @@ cdef class RandomState:
         return cont3_array(self.internal_state, rk_noncentral_f, size, odfnum,
             odfden, ononc)
 
-    def chisquare(self, df, size=None):
+    def chisquare(self, df, size=None, method='polar'):
         """
-        chisquare(df, size=None)
+        chisquare(df, size=None, method='polar')
 
         Draw samples from a chi-square distribution.
 
@@ -1817,6 +2034,10 @@ cdef class RandomState:
         size : tuple of ints, int, optional
              Size of the returned array.  By default, a scalar is
              returned.
+        method : {'polar', 'zig'}, optional
+             Algorithm for the underlying normal and exponential variates.
+             'polar' (the default) keeps seeded streams reproducible; 'zig'
+             uses the faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -1865,19 +2086,25 @@ cdef class RandomState:
         """
         cdef ndarray odf
         cdef double fdf
+        cdef rk_cont1 func
+
+        if use_ziggurat(method):
+            func = rk_chisquare_zig
+        else:
+            func = rk_chisquare
 
         fdf = PyFloat_AsDouble(df)
         if not PyErr_Occurred():
             if fdf <= 0:
                 raise ValueError("df <= 0")
-            return cont1_array_sc(self.internal_state, rk_chisquare, size, fdf)
+            return cont1_array_sc(self.internal_state, func, size, fdf)
 
         PyErr_Clear()
 
         odf = <ndarray>PyArray_FROM_OTF(df, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(odf, 0.0)):
             raise ValueError("df <= 0")
-        return cont1_array(self.internal_state, rk_chisquare, size, odf)
+        return cont1_array(self.internal_state, func, size, odf)
 
     def noncentral_chisquare(self, df, nonc, size=None):
         """
@@ -2032,9 +2259,9 @@ cdef class RandomState:
         """
         return cont0_array(self.internal_state, rk_standard_cauchy, size)
 
-    def standard_t(self, df, size=None):
+    def standard_t(self, df, size=None, method='polar'):
         """
-        standard_t(df, size=None)
+        standard_t(df, size=None, method='polar')
 
         Standard Student's t distribution with df degrees of freedom.
 
@@ -2049,6 +2276,10 @@ cdef class RandomState:
         size : int or tuple of ints, optional
             Output shape. Default is None, in which case a single value is
             returned.
+        method : {'polar', 'zig'}, optional
+            Algorithm for the underlying normal and exponential variates.
+            'polar' (the default) keeps seeded streams reproducible; 'zig'
+            uses the faster Ziggurat method, which draws a different stream.
 
         Returns
         -------
@@ -2119,19 +2350,25 @@ cdef class RandomState:
         """
         cdef ndarray odf
         cdef double fdf
+        cdef rk_cont1 func
+
+        if use_ziggurat(method):
+            func = rk_standard_t_zig
+        else:
+            func = rk_standard_t
 
         fdf = PyFloat_AsDouble(df)
         if not PyErr_Occurred():
             if fdf <= 0:
                 raise ValueError("df <= 0")
-            return cont1_array_sc(self.internal_state, rk_standard_t, size, fdf)
+            return cont1_array_sc(self.internal_state, func, size, fdf)
 
         PyErr_Clear()
 
         odf = <ndarray> PyArray_FROM_OTF(df, NPY_DOUBLE, NPY_ALIGNED)
         if np.any(np.less_equal(odf, 0.0)):
             raise ValueError("df <= 0")
-        return cont1_array(self.internal_state, rk_standard_t, size, odf)
+        return cont1_array(self.internal_state, func, size, odf)
 
     def vonmises(self, mu, kappa, size=None):
         """
@@ -4172,8 +4409,29 @@ cdef class RandomState:
         """
         cdef long i, j
         cdef int copy
+        cdef ndarray arr "arrayObject_arr"
+        cdef npy_intp rowbytes
+        cdef char *buf
 
         i = len(x) - 1
+        if i > 0 and type(x) is np.ndarray and x.flags.writeable and \
+                (x.ndim == 1 or x[0].flags.c_contiguous):
+            # Swap the raw bytes of the elements or rows in place; subclasses
+            # such as MaskedArray carry more than the data and are swapped
+            # through __setitem__ below.
+            arr = <ndarray>x
+            if arr.nd == 1:
+                rowbytes = arr.descr.elsize
+            else:
+                rowbytes = x[0].nbytes
+            buf = <char *>PyMem_Malloc(rowbytes)
+            if buf == NULL:
+                raise MemoryError
+            shuffle_raw(self.internal_state, arr.data, i + 1, arr.strides[0],
+                        rowbytes, buf)
+            PyMem_Free(buf)
+            return
+
         try:
             j = len(x[0])
         except:
@@ -2,6 +2,8 @@
 #define _MTRAND_PY_HELPER_H_
 
 #include <Python.h>
+#include "pythread.h"
+#include "randomkit.h"
 
 static PyObject *empty_py_bytes(unsigned long length, void **bytes)
 {
@@ -20,4 +22,118 @@ static PyObject *empty_py_bytes(unsigned long length, void **bytes)
     return b;
 }
 
+/*
+ * Doubles per chunk of fill_doubles_threaded.  Each chunk costs one
+ * rk_jump, which takes about as long as drawing a quarter of a chunk.
+ */
+#define FILL_CHUNK ((size_t)1 << 21)
+
+typedef struct {
+    double *out;
+    size_t n;
+    rk_state *children;
+    size_t nchunks;
+    size_t next;
+    int running;
+    PyThread_type_lock lock;
+    PyThread_type_lock done;
+} fill_job;
+
+static void fill_job_chunks(fill_job *job)
+{
+    size_t c, len;
+    int last;
+
+    for (;;) {
+        PyThread_acquire_lock(job->lock, WAIT_LOCK);
+        c = job->next++;
+        PyThread_release_lock(job->lock);
+        if (c >= job->nchunks) {
+            break;
+        }
+        len = job->n - c*FILL_CHUNK;
+        if (len > FILL_CHUNK) {
+            len = FILL_CHUNK;
+        }
+        rk_fill_doubles(job->out + c*FILL_CHUNK, len, &job->children[c]);
+    }
+
+    /* the last thread out lets the caller return and free the job */
+    PyThread_acquire_lock(job->lock, WAIT_LOCK);
+    last = (--job->running == 0);
+    PyThread_release_lock(job->lock);
+    if (last) {
+        PyThread_release_lock(job->done);
+    }
+}
+
+static void fill_job_worker(void *arg)
+{
+    fill_job_chunks((fill_job *)arg);
+}
+
+/*
+ * Fill out with n doubles in chunks of FILL_CHUNK, chunk c coming from
+ * the substream rk_spawn gives as child c, so the values do not depend
+ * on nthreads.  state is jumped once per chunk while the GIL is still
+ * held; the chunks are then filled by up to nthreads threads, the caller
+ * included, with the GIL released.  Fewer threads are used if they
+ * cannot be started.  Returns -1 if out of memory, 0 otherwise.
+ */
+static int fill_doubles_threaded(double *out, size_t n, rk_state *state,
+                                 int nthreads)
+{
+    fill_job job;
+    int i;
+
+    job.out = out;
+    job.n = n;
+    job.nchunks = (n + FILL_CHUNK - 1)/FILL_CHUNK;
+    job.next = 0;
+    job.running = 1;
+    if (job.nchunks == 0) {
+        return 0;
+    }
+    job.children = PyMem_Malloc(job.nchunks*sizeof(rk_state));
+    job.lock = PyThread_allocate_lock();
+    job.done = PyThread_allocate_lock();
+    if (job.children == NULL || job.lock == NULL || job.done == NULL) {
+        PyMem_Free(job.children);
+        if (job.lock != NULL) {
+            PyThread_free_lock(job.lock);
+        }
+        if (job.done != NULL) {
+            PyThread_free_lock(job.done);
+        }
+        return -1;
+    }
+    rk_spawn(state, job.children, job.nchunks);
+    if ((size_t)nthreads > job.nchunks) {
+        nthreads = (int)job.nchunks;
+    }
+
+    PyThread_acquire_lock(job.done, WAIT_LOCK);
+    Py_BEGIN_ALLOW_THREADS
+    for (i = 1; i < nthreads; i++) {
+        PyThread_acquire_lock(job.lock, WAIT_LOCK);
+        job.running++;
+        PyThread_release_lock(job.lock);
+        if ((long)PyThread_start_new_thread(fill_job_worker, &job) == -1) {
+            PyThread_acquire_lock(job.lock, WAIT_LOCK);
+            job.running--;
+            PyThread_release_lock(job.lock);
+            break;
+        }
+    }
+    fill_job_chunks(&job);
+    PyThread_acquire_lock(job.done, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+
+    PyThread_release_lock(job.done);
+    PyThread_free_lock(job.done);
+    PyThread_free_lock(job.lock);
+    PyMem_Free(job.children);
+    return 0;
+}
+
 #endif /* _MTRAND_PY_HELPER_H_ */
@@ -116,6 +116,7 @@
 #endif
 
 #include "randomkit.h"
+#include "randomkit_jump.h"
 
 #ifndef RK_DEV_URANDOM
 #define RK_DEV_URANDOM "/dev/urandom"
@@ -207,6 +208,39 @@ rk_randomseed(rk_state *state)
 #define UPPER_MASK 0x80000000UL
 #define LOWER_MASK 0x7fffffffUL
 
+/* Tempering of one state word */
+#define RK_TEMPER(y) do {                   \
+        (y) ^= ((y) >> 11);                 \
+        (y) ^= ((y) << 7) & 0x9d2c5680UL;   \
+        (y) ^= ((y) << 15) & 0xefc60000UL;  \
+        (y) ^= ((y) >> 18);                 \
+    } while (0)
+
+/*
+ * Regenerate the whole state block.  Neither loop carries a dependency
+ * shorter than the vector width (the second one reads words the first one
+ * wrote M - N positions back), so compilers are free to vectorize them.
+ */
+static void
+rk_reload(rk_state *state)
+{
+    unsigned long y;
+    int i;
+
+    for (i = 0; i < N - M; i++) {
+        y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
+        state->key[i] = state->key[i+M] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+    }
+    for (; i < N - 1; i++) {
+        y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
+        state->key[i] = state->key[i+(M-N)] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
+    }
+    y = (state->key[N - 1] & UPPER_MASK) | (state->key[0] & LOWER_MASK);
+    state->key[N - 1] = state->key[M - 1] ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
+
+    state->pos = 0;
+}
+
 /* Slightly optimised reference implementation of the Mersenne Twister */
 unsigned long
 rk_random(rk_state *state)
@@ -214,32 +248,40 @@ rk_random(rk_state *state)
     unsigned long y;
 
     if (state->pos == RK_STATE_LEN) {
-        int i;
-
-        for (i = 0; i < N - M; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+M] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
-        }
-        for (; i < N - 1; i++) {
-            y = (state->key[i] & UPPER_MASK) | (state->key[i+1] & LOWER_MASK);
-            state->key[i] = state->key[i+(M-N)] ^ (y>>1) ^ (-(y & 1) & MATRIX_A);
-        }
-        y = (state->key[N - 1] & UPPER_MASK) | (state->key[0] & LOWER_MASK);
-        state->key[N - 1] = state->key[M - 1] ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
-
-        state->pos = 0;
+        rk_reload(state);
     }
     y = state->key[state->pos++];
-
-    /* Tempering */
-    y ^= (y >> 11);
-    y ^= (y << 7) & 0x9d2c5680UL;
-    y ^= (y << 15) & 0xefc60000UL;
-    y ^= (y >> 18);
+    RK_TEMPER(y);
 
     return y;
 }
 
+void
+rk_fill_uint32(unsigned int *out, size_t n, rk_state *state)
+{
+    unsigned long y, *key;
+    size_t i, cnt;
+
+    while (n > 0) {
+        if (state->pos == RK_STATE_LEN) {
+            rk_reload(state);
+        }
+        cnt = RK_STATE_LEN - state->pos;
+        if (cnt > n) {
+            cnt = n;
+        }
+        key = state->key + state->pos;
+        for (i = 0; i < cnt; i++) {
+            y = key[i];
+            RK_TEMPER(y);
+            out[i] = (unsigned int)y;
+        }
+        state->pos += cnt;
+        out += cnt;
+        n -= cnt;
+    }
+}
+
 long
 rk_long(rk_state *state)
 {
@@ -296,6 +338,42 @@ rk_double(rk_state *state)
     return (a * 67108864.0 + b) / 9007199254740992.0;
 }
 
+void
+rk_fill_doubles(double *out, size_t n, rk_state *state)
+{
+    unsigned long a, b, *key;
+    size_t i, cnt;
+
+    while (n > 0) {
+        if (state->pos == RK_STATE_LEN) {
+            rk_reload(state);
+        }
+        cnt = (RK_STATE_LEN - state->pos)/2;
+        if (cnt == 0) {
+            /* the two words of this double straddle a state block */
+            *out++ = rk_double(state);
+            n--;
+            continue;
+        }
+        if (cnt > n) {
+            cnt = n;
+        }
+        key = state->key + state->pos;
+        for (i = 0; i < cnt; i++) {
+            a = key[2*i];
+            b = key[2*i + 1];
+            RK_TEMPER(a);
+            RK_TEMPER(b);
+            /* same conversion as rk_double, through signed longs */
+            out[i] = ((long)(a >> 5) * 67108864.0 + (long)(b >> 6))
+                        / 9007199254740992.0;
+        }
+        state->pos += 2*cnt;
+        out += cnt;
+        n -= cnt;
+    }
+}
+
 void
 rk_fill(void *buffer, size_t size, rk_state *state)
 {
@@ -363,7 +441,6 @@ rk_devfill(void *buffer, size_t size, int strong)
 
 rk_error
 rk_altfill(void *buffer, size_t size, int strong, rk_state *state)
-rk_error rk_altfill(void *buffer, size_t size, int strong, rk_state *state)
 {
     rk_error err;
 
@@ -401,3 +478,70 @@ rk_gauss(rk_state *state)
         return f*x2;
     }
 }
+
+/*
+ * Jump ahead with the polynomial method: if p(x) = sum c_i x**i is x**J
+ * reduced modulo the characteristic polynomial of the transition, the state
+ * J words ahead is sum c_i T**i(state), where T advances the generator by
+ * one word.  The state is kept as the window of the next N output words, so
+ * T is a shift of the window by one word.
+ */
+static void
+rk_jump_poly(rk_state *state, const unsigned char *poly)
+{
+    unsigned long ring[N], acc[N], y;
+    rk_state tmp;
+    int i, j, head, k;
+
+    /* Next N untempered words */
+    tmp = *state;
+    for (j = 0; j < N; j++) {
+        if (tmp.pos == RK_STATE_LEN) {
+            rk_reload(&tmp);
+        }
+        ring[j] = tmp.key[tmp.pos++];
+        acc[j] = 0;
+    }
+
+    head = 0;
+    for (i = 0; i < RK_JUMP_DEGREE; i++) {
+        if ((poly[i >> 3] >> (i & 7)) & 1) {
+            for (j = 0, k = head; k < N; j++, k++) {
+                acc[j] ^= ring[k];
+            }
+            for (k = 0; k < head; j++, k++) {
+                acc[j] ^= ring[k];
+            }
+        }
+        /* Replace the oldest word of the window by the next one */
+        y = (ring[head] & UPPER_MASK) | (ring[head + 1 < N ? head + 1 : 0]
+                                         & LOWER_MASK);
+        ring[head] = ring[head + M < N ? head + M : head + M - N]
+                     ^ (y >> 1) ^ (-(y & 1) & MATRIX_A);
+        head = head + 1 < N ? head + 1 : 0;
+    }
+
+    for (j = 0; j < N; j++) {
+        state->key[j] = acc[j];
+    }
+    state->pos = 0;
+    state->has_gauss = 0;
+    state->gauss = 0;
+}
+
+void
+rk_jump(rk_state *state)
+{
+    rk_jump_poly(state, rk_jump_poly_128);
+}
+
+void
+rk_spawn(rk_state *state, rk_state *children, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++) {
+        children[i] = *state;
+        rk_jump(state);
+    }
+}
@@ -153,6 +153,19 @@ extern unsigned long rk_interval(unsigned long max, rk_state *state);
  */
 extern double rk_double(rk_state *state);
 
+/*
+ * Fill out with n random doubles between 0.0 and 1.0, 1.0 excluded.
+ * The values are those n calls to rk_double would return, but they are
+ * converted a whole state block at a time.
+ */
+extern void rk_fill_doubles(double *out, size_t n, rk_state *state);
+
+/*
+ * Fill out with n random 32 bit words, the values n calls to rk_random
+ * would return, a whole state block at a time.
+ */
+extern void rk_fill_uint32(unsigned int *out, size_t n, rk_state *state);
+
 /*
  * fill the buffer with size random bytes
  */
@@ -182,6 +195,19 @@ extern rk_error rk_altfill(void *buffer, size_t size, int strong,
  */
 extern double rk_gauss(rk_state *state);
 
+/*
+ * Advance the state by 2^128 draws of rk_random in about the time of
+ * 20000 draws. A cached gaussian deviate is discarded.
+ */
+extern void rk_jump(rk_state *state);
+
+/*
+ * Fill children with n independent substreams of state: children[i] starts
+ * where state was after i jumps, and state is left n jumps ahead, so
+ * neither overlaps the others for 2^128 draws.
+ */
+extern void rk_spawn(rk_state *state, rk_state *children, size_t n);
+
 #ifdef __cplusplus
 }
 #endif
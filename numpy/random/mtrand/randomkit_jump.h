@@ -0,0 +1,227 @@
+/* Jump polynomial for the Mersenne Twister MT19937 used by randomkit.c.
+ *
+ * Bit j of byte i is the coefficient of x**(8*i + j) in x**(2**128) reduced
+ * modulo the characteristic polynomial of the MT19937 transition, which was
+ * obtained with the Berlekamp-Massey algorithm from the output sequence.
+ * See Haramoto, Matsumoto, Nishimura, Panneton and L'Ecuyer, "Efficient
+ * Jump Ahead for F2-Linear Random Number Generators", INFORMS Journal on
+ * Computing 20 (2008).
+ */
+
+#ifndef _RANDOMKIT_JUMP_
+#define _RANDOMKIT_JUMP_
+
+#define RK_JUMP_DEGREE 19937
+
+static const unsigned char rk_jump_poly_128[2493] = {
+    0x63, 0x39, 0xde, 0x72, 0xc4, 0x9e, 0x70, 0xb5, 0xb6, 0x9b, 0x27, 0x88,
+    0xe5, 0xf8, 0x23, 0xa8, 0x59, 0x3e, 0xd8, 0x26, 0x59, 0x22, 0x1f, 0x04,
+    0x15, 0xbb, 0xfd, 0xe7, 0x77, 0x17, 0x52, 0x8b, 0x56, 0xe7, 0xb5, 0x48,
+    0xd5, 0x12, 0x28, 0xbf, 0xb9, 0xad, 0xb0, 0xe4, 0xaa, 0x49, 0x48, 0x0b,
+    0x83, 0x8b, 0x92, 0x3e, 0xce, 0x39, 0x6d, 0xe9, 0xd3, 0x31, 0x61, 0xaf,
+    0xe8, 0xf2, 0xea, 0x09, 0x56, 0x84, 0x54, 0x33, 0x7b, 0x4c, 0x81, 0xc1,
+    0x83, 0x7c, 0x3a, 0x89, 0xbc, 0x07, 0xbd, 0xfe, 0x67, 0x82, 0xbd, 0x01,
+    0xbf, 0xdc, 0x47, 0x51, 0xe6, 0x7d, 0xa6, 0xe2, 0x74, 0xf5, 0xfe, 0x9a,
+    0x09, 0x4d, 0x33, 0xb8, 0xca, 0xde, 0xd3, 0xf0, 0x58, 0xfd, 0x61, 0x55,
+    0x3b, 0x70, 0x84, 0xd8, 0x3b, 0x80, 0x5c, 0xef, 0x42, 0x8f, 0x9b, 0xb3,
+    0x61, 0xb7, 0xdf, 0x20, 0xd3, 0xfe, 0x1c, 0xd6, 0x5b, 0x3e, 0x5f, 0xcf,
+    0x77, 0x61, 0x41, 0x47, 0xe9, 0x42, 0x84, 0x8e, 0xab, 0xcf, 0xa9, 0x8e,
+    0xc0, 0x0e, 0x5d, 0x58, 0x8d, 0xf7, 0xdd, 0x60, 0x28, 0x85, 0x9b, 0x2c,
+    0x0e, 0xd6, 0xf7, 0xf0, 0xfc, 0x3b, 0xbb, 0xb2, 0x7d, 0xe3, 0x3e, 0xca,
+    0x59, 0xe6, 0xc9, 0x81, 0x69, 0xd9, 0x0e, 0x87, 0xde, 0xa0, 0x73, 0x95,
+    0x51, 0x48, 0x52, 0xce, 0x94, 0x3b, 0x68, 0x77, 0xed, 0xa5, 0xcd, 0x73,
+    0xbc, 0xfc, 0xbc, 0x56, 0x6c, 0x95, 0x3b, 0xf4, 0x14, 0xde, 0x91, 0x1f,
+    0x00, 0xb4, 0x04, 0xbf, 0x81, 0xc4, 0x38, 0x94, 0x31, 0x98, 0x85, 0x1d,
+    0xa2, 0xe0, 0x6a, 0xca, 0xd5, 0xae, 0x97, 0x9d, 0x18, 0x42, 0x46, 0x9e,
+    0x19, 0x95, 0x5c, 0xe7, 0x86, 0x54, 0x3c, 0x25, 0x5c, 0x45, 0x43, 0xcd,
+    0xd8, 0xcc, 0xb5, 0x73, 0xd4, 0x82, 0x82, 0x7f, 0x44, 0xcd, 0xca, 0xc8,
+    0x99, 0xdf, 0x2d, 0x19, 0x46, 0x85, 0xbe, 0xd6, 0x89, 0xb5, 0x88, 0x52,
+    0xa7, 0x6c, 0xf2, 0xb4, 0x7f, 0x55, 0x19, 0x98, 0xeb, 0x70, 0x05, 0x20,
+    0x28, 0x3d, 0xe7, 0x03, 0x04, 0xcc, 0x4a, 0x26, 0xc9, 0x14, 0xa1, 0x78,
+    0x7b, 0xfb, 0xf0, 0x95, 0x97, 0xe8, 0xee, 0x42, 0xc2, 0x80, 0xcc, 0xab,
+    0xe8, 0x51, 0xe7, 0x67, 0x85, 0xcc, 0x30, 0x13, 0xef, 0x87, 0x0e, 0x14,
+    0x96, 0x9a, 0x3b, 0x91, 0x5e, 0x52, 0xf8, 0xd3, 0x05, 0xd2, 0xe3, 0x3e,
+    0x8f, 0x15, 0xa1, 0x1b, 0x89, 0xdb, 0x4c, 0x2c, 0x7d, 0xa8, 0x6a, 0x1f,
+    0x3a, 0x9a, 0x5e, 0x9b, 0x23, 0x32, 0x8b, 0x87, 0xed, 0xc3, 0x98, 0xa4,
+    0x78, 0x77, 0x8c, 0xa4, 0x66, 0xc0, 0x4a, 0x97, 0x55, 0xf0, 0x08, 0x1d,
+    0x42, 0x82, 0xa0, 0xc8, 0xe9, 0x80, 0xde, 0xd6, 0x40, 0x0b, 0xcf, 0xa1,
+    0x4c, 0xce, 0x92, 0x28, 0xc7, 0x31, 0x27, 0x84, 0xae, 0x68, 0x41, 0x60,
+    0x6d, 0xee, 0x23, 0xdd, 0xb2, 0xf8, 0xcf, 0xbe, 0x87, 0x72, 0xac, 0xdf,
+    0x51, 0x97, 0x36, 0xa4, 0x9d, 0xc8, 0x8b, 0xba, 0xd9, 0x40, 0x58, 0x4a,
+    0x82, 0x85, 0xa5, 0xa7, 0xed, 0xdb, 0x3b, 0xf5, 0x97, 0x49, 0xba, 0xcf,
+    0x1c, 0x9d, 0x14, 0xa4, 0xc3, 0x6f, 0xc6, 0xd5, 0x05, 0x29, 0xc7, 0xf2,
+    0x39, 0xad, 0x68, 0xce, 0x96, 0x8e, 0x4d, 0xae, 0xb5, 0xa9, 0x13, 0xf2,
+    0x96, 0xf3, 0x88, 0xc5, 0xbb, 0x16, 0x61, 0x9d, 0x4e, 0x8d, 0x61, 0x2c,
+    0xd1, 0x20, 0x44, 0xb3, 0xf3, 0x61, 0xfb, 0xeb, 0xd7, 0x2e, 0x70, 0x3b,
+    0xf2, 0xa6, 0xdc, 0xcb, 0x66, 0x81, 0xb7, 0x7c, 0x95, 0x33, 0x28, 0xbe,
+    0x6a, 0x43, 0xa2, 0x03, 0x96, 0xd0, 0xc0, 0x20, 0x6f, 0xaa, 0x90, 0xe1,
+    0x15, 0xb8, 0x49, 0xbf, 0xc3, 0x8d, 0xd7, 0x49, 0x03, 0xb9, 0x45, 0x9b,
+    0xc8, 0xc4, 0xa4, 0x0a, 0xe3, 0x90, 0xeb, 0x67, 0xf0, 0x13, 0x2b, 0xf3,
+    0xb1, 0xea, 0x5c, 0x7f, 0x94, 0x82, 0xc4, 0xcc, 0xdb, 0xae, 0x1e, 0x64,
+    0xb6, 0xaf, 0x6a, 0x6d, 0x58, 0x53, 0xb5, 0x80, 0x32, 0x58, 0xb5, 0x72,
+    0x9a, 0x77, 0xfa, 0xf1, 0x74, 0xaf, 0x60, 0x3b, 0xfd, 0xae, 0x92, 0x89,
+    0xf2, 0x09, 0xa6, 0x4f, 0x72, 0x94, 0x35, 0x28, 0xf1, 0xaa, 0xe7, 0x61,
+    0xa9, 0xc1, 0x7d, 0x52, 0x87, 0x80, 0x4e, 0x83, 0x3f, 0x69, 0xad, 0xbc,
+    0xf6, 0x3b, 0xca, 0xc9, 0x96, 0x17, 0x17, 0x95, 0x4a, 0x16, 0x41, 0x9f,
+    0x75, 0x67, 0xd3, 0xb7, 0x3b, 0xcf, 0x20, 0xcf, 0x7b, 0x67, 0x77, 0x5c,
+    0x01, 0x5b, 0x76, 0xf4, 0x9f, 0xd6, 0xdf, 0x47, 0x15, 0x6e, 0x0d, 0xd9,
+    0x7f, 0x24, 0x08, 0xd7, 0x13, 0x51, 0xe9, 0x5f, 0x28, 0x96, 0x79, 0xad,
+    0xf2, 0xf9, 0x27, 0xc6, 0xe2, 0x0c, 0xfb, 0xfc, 0xce, 0x41, 0x24, 0x0f,
+    0x80, 0x33, 0x00, 0x4b, 0x00, 0x11, 0x16, 0x72, 0x0b, 0x78, 0xfa, 0x50,
+    0x1a, 0xb1, 0x72, 0x1f, 0xb7, 0xa8, 0x1c, 0xb7, 0xfd, 0x42, 0xab, 0xff,
+    0xce, 0xba, 0x75, 0x54, 0x39, 0x8b, 0xc2, 0x91, 0x78, 0xef, 0x6e, 0x35,
+    0xc3, 0xc9, 0x41, 0x14, 0x6d, 0x08, 0x80, 0xdc, 0x91, 0x74, 0xc4, 0x96,
+    0xc9, 0x0e, 0xc3, 0xb5, 0x2d, 0xe4, 0x54, 0xa2, 0xdd, 0x1a, 0x32, 0xa9,
+    0x12, 0x36, 0x3a, 0x96, 0x5b, 0xee, 0x0b, 0xc3, 0xc7, 0x75, 0x5c, 0x63,
+    0x23, 0x13, 0x14, 0xdf, 0x58, 0x8f, 0x30, 0x38, 0x8f, 0xe3, 0x26, 0x89,
+    0x92, 0x95, 0xb6, 0x71, 0xd8, 0x54, 0x77, 0x89, 0x5e, 0xde, 0xdd, 0x3c,
+    0x74, 0x61, 0xc0, 0x5b, 0x04, 0x09, 0x52, 0xad, 0xa7, 0x80, 0xbb, 0xbe,
+    0xd4, 0x84, 0xc2, 0x5c, 0x33, 0x5d, 0x1d, 0xd9, 0x48, 0xa7, 0x6b, 0x8c,
+    0x41, 0x0e, 0x09, 0x11, 0x29, 0x99, 0xbb, 0x33, 0xbc, 0xff, 0x2c, 0x46,
+    0x8e, 0x50, 0x2a, 0xc4, 0x05, 0x86, 0xc6, 0xef, 0x14, 0x3a, 0x2a, 0x60,
+    0xd9, 0x6c, 0x0e, 0x23, 0xf4, 0xf9, 0xc6, 0x26, 0x31, 0xeb, 0xb8, 0x49,
+    0x8f, 0x35, 0xbd, 0x51, 0xa4, 0xe7, 0x49, 0x7c, 0xcb, 0x92, 0xb5, 0x47,
+    0x39, 0xbb, 0x10, 0x19, 0x5b, 0x6a, 0xed, 0x3c, 0x18, 0xa5, 0x0c, 0xad,
+    0xcb, 0x1d, 0x46, 0x93, 0x79, 0xa5, 0x8c, 0xd9, 0x8e, 0x94, 0x26, 0x95,
+    0x65, 0xcb, 0xc5, 0xec, 0x1b, 0x43, 0x1a, 0xfd, 0x7d, 0xc8, 0xdd, 0x0b,
+    0x24, 0x40, 0x69, 0x5d, 0xac, 0x20, 0x98, 0x7d, 0x38, 0x55, 0xeb, 0xff,
+    0xe1, 0x1a, 0x6c, 0x71, 0x2f, 0xfb, 0xcf, 0x13, 0x86, 0xed, 0xf8, 0x04,
+    0x39, 0xf0, 0x77, 0xd7, 0x97, 0xeb, 0x32, 0x1b, 0x5f, 0xa9, 0xc1, 0x87,
+    0xee, 0xa4, 0x3d, 0x89, 0x6c, 0xf1, 0x35, 0xc2, 0xd4, 0x18, 0x51, 0x96,
+    0xba, 0x94, 0x79, 0xe8, 0xe2, 0x23, 0x90, 0xf9, 0x45, 0x45, 0x8c, 0xbb,
+    0xa5, 0x68, 0x12, 0x89, 0xb4, 0x46, 0xcf, 0xe7, 0x61, 0x38, 0x16, 0x4d,
+    0x81, 0x56, 0x2c, 0x0b, 0x0e, 0x8c, 0x68, 0xca, 0x5f, 0x2e, 0x70, 0x36,
+    0xb5, 0x46, 0x63, 0xb8, 0xbb, 0x11, 0xe3, 0x55, 0x37, 0x01, 0xa6, 0x72,
+    0x5c, 0xdc, 0x2f, 0x14, 0x13, 0x0e, 0xd1, 0x47, 0xcb, 0xe0, 0x4c, 0xa3,
+    0x30, 0x8c, 0x08, 0xac, 0xfe, 0x03, 0x95, 0x8f, 0xe8, 0xa2, 0x79, 0x4d,
+    0xc7, 0x70, 0x76, 0x93, 0x95, 0xc0, 0xb4, 0x02, 0xe0, 0xf5, 0xf8, 0x20,
+    0xc0, 0x33, 0x05, 0x08, 0x32, 0x8f, 0xfe, 0x81, 0x25, 0x0c, 0x1d, 0xab,
+    0x6d, 0x77, 0x8f, 0x04, 0x28, 0xbb, 0x01, 0xb6, 0x47, 0x4a, 0x00, 0x96,
+    0x6e, 0xe1, 0xb8, 0xf8, 0x7b, 0xaf, 0x62, 0x68, 0x42, 0xa0, 0x9f, 0x4a,
+    0x62, 0xf6, 0xb6, 0xb0, 0xd4, 0x4a, 0x38, 0x54, 0xee, 0xc0, 0x50, 0xa3,
+    0x57, 0x0a, 0x67, 0x81, 0xc1, 0x1d, 0x06, 0x26, 0x20, 0x28, 0x2c, 0x3a,
+    0x99, 0xf8, 0x75, 0xb5, 0x67, 0x96, 0x74, 0xb9, 0x2a, 0xfc, 0x8d, 0x73,
+    0x38, 0x38, 0x85, 0xaa, 0x42, 0xc4, 0xcc, 0x00, 0xa4, 0x92, 0x3a, 0xa5,
+    0x3e, 0x5a, 0xaf, 0xcf, 0xa2, 0xcf, 0xc8, 0xbd, 0x65, 0x42, 0x88, 0x09,
+    0x9d, 0xee, 0x9f, 0x52, 0x4f, 0xf8, 0xd7, 0xa4, 0x9e, 0x70, 0x6c, 0x96,
+    0x42, 0xbc, 0x80, 0x4c, 0xd4, 0x65, 0x42, 0xd1, 0xf3, 0xe7, 0xeb, 0xf5,
+    0xed, 0x2a, 0x3c, 0xb2, 0xf1, 0x23, 0x45, 0x80, 0x42, 0x7c, 0xd4, 0xb7,
+    0xa9, 0x0a, 0xcb, 0xa7, 0x68, 0x05, 0x37, 0x73, 0xc5, 0x0a, 0xd9, 0x06,
+    0x1e, 0x8a, 0x15, 0x66, 0xad, 0xc7, 0x05, 0x98, 0x8c, 0x89, 0xa3, 0xc4,
+    0xde, 0xad, 0x90, 0x78, 0x90, 0x36, 0xc5, 0x7f, 0x20, 0x9b, 0xc3, 0x85,
+    0x08, 0x7e, 0x42, 0xc5, 0xf8, 0x64, 0xc8, 0xc0, 0xed, 0x05, 0xba, 0x2f,
+    0x7a, 0x01, 0x65, 0xc3, 0xbf, 0xd2, 0x0a, 0x21, 0xea, 0x95, 0xfb, 0x8f,
+    0x03, 0xa0, 0x9c, 0x60, 0x72, 0x4f, 0x6c, 0x8e, 0xc4, 0x63, 0xe6, 0x84,
+    0x62, 0x05, 0x11, 0x3c, 0xa8, 0x1c, 0x3c, 0x75, 0x23, 0xb7, 0x00, 0x87,
+    0xfc, 0x2a, 0x64, 0x48, 0x2c, 0x95, 0xac, 0x14, 0x3e, 0x12, 0xf1, 0xce,
+    0x3c, 0x97, 0x84, 0xed, 0xb8, 0xb8, 0x75, 0xf0, 0xc9, 0xc5, 0xea, 0x0c,
+    0x5a, 0x25, 0x0a, 0xf0, 0x7c, 0x48, 0xcd, 0xdf, 0xda, 0xe0, 0x77, 0x7e,
+    0x0c, 0x75, 0xe5, 0x8b, 0x97, 0xcb, 0x71, 0x00, 0xfe, 0x27, 0x08, 0x56,
+    0x6f, 0x38, 0xc4, 0x28, 0xf0, 0x49, 0x40, 0xaf, 0xd6, 0x3a, 0x6b, 0xbf,
+    0xdd, 0xaa, 0x11, 0xa9, 0xd1, 0x06, 0x30, 0x2e, 0x74, 0xbb, 0xb5, 0x5e,
+    0xf9, 0x89, 0x84, 0x2e, 0x3d, 0xb8, 0x6f, 0xc3, 0x64, 0x81, 0x27, 0x84,
+    0x47, 0x2b, 0x30, 0x82, 0xbe, 0xe6, 0xe0, 0x61, 0x0e, 0x26, 0x22, 0x04,
+    0x56, 0x9c, 0xb5, 0x11, 0x9c, 0x0c, 0xf2, 0xe4, 0xaa, 0xec, 0xd5, 0x9c,
+    0xda, 0xe2, 0x66, 0xf8, 0x23, 0x25, 0xc7, 0x9b, 0x67, 0x16, 0xc4, 0x52,
+    0x3c, 0x53, 0x6f, 0x81, 0x5e, 0x23, 0xa3, 0x47, 0x9e, 0xff, 0xdb, 0xa0,
+    0x56, 0xa7, 0x62, 0x0c, 0xa3, 0xa5, 0x9c, 0xea, 0xa6, 0x61, 0x07, 0xde,
+    0xe9, 0x67, 0x12, 0xc5, 0xf6, 0x2a, 0xed, 0x3e, 0x66, 0x88, 0x8b, 0xf2,
+    0x1f, 0xd0, 0x5e, 0x69, 0x63, 0x96, 0x76, 0xfd, 0x4e, 0xaf, 0x65, 0x90,
+    0xdf, 0xfc, 0x47, 0xbc, 0x59, 0x62, 0xca, 0xdf, 0x9c, 0x38, 0x4e, 0x42,
+    0x1b, 0x2c, 0x6c, 0x16, 0x5e, 0x33, 0x03, 0xbb, 0xa1, 0xa1, 0x73, 0x2a,
+    0xdd, 0x33, 0xbe, 0xc4, 0x58, 0xd0, 0x90, 0xe6, 0xc2, 0x6b, 0x74, 0x45,
+    0x07, 0x34, 0xb4, 0x94, 0x7f, 0x8d, 0xd3, 0x07, 0xb3, 0x4f, 0x85, 0x60,
+    0xe4, 0x51, 0xb8, 0x74, 0xc2, 0x2a, 0x3d, 0xdb, 0x07, 0xf5, 0x9d, 0xd9,
+    0x3b, 0x32, 0xd3, 0x86, 0x4c, 0x25, 0x6c, 0x5d, 0x22, 0xac, 0xbf, 0x82,
+    0x32, 0x30, 0xdd, 0xb4, 0x3b, 0x02, 0x7e, 0xb2, 0x5f, 0x1a, 0x26, 0xb7,
+    0x79, 0x81, 0xfe, 0x34, 0xbf, 0x61, 0xf3, 0x40, 0x58, 0x78, 0x9e, 0x6c,
+    0x0e, 0x50, 0x16, 0xe7, 0x06, 0x3b, 0x87, 0x65, 0x0b, 0xee, 0xc6, 0x35,
+    0xe7, 0x64, 0x28, 0xfb, 0xfc, 0xd4, 0xc5, 0xe4, 0xc6, 0x01, 0x19, 0x28,
+    0x84, 0xe2, 0x8e, 0x85, 0xcd, 0xa3, 0xfc, 0xe5, 0x65, 0x3a, 0x80, 0x44,
+    0xf6, 0xf7, 0x50, 0xf8, 0x41, 0x1e, 0xf4, 0xf9, 0x39, 0x55, 0xeb, 0x65,
+    0xc9, 0xf3, 0xcb, 0x87, 0x74, 0x80, 0x2f, 0xbe, 0x12, 0x64, 0x05, 0xae,
+    0x55, 0xb9, 0x5c, 0x3c, 0x6f, 0x91, 0xfe, 0xd8, 0xdf, 0x89, 0xc2, 0xae,
+    0x5e, 0xcb, 0x8c, 0xd1, 0xbf, 0x81, 0xef, 0x0e, 0xf2, 0x57, 0x61, 0x44,
+    0x4a, 0x36, 0x90, 0x46, 0x75, 0x21, 0x98, 0xde, 0xa0, 0x7e, 0x59, 0xc1,
+    0x1b, 0x59, 0x94, 0xd0, 0x17, 0x3e, 0xed, 0xb1, 0x7a, 0x6e, 0x67, 0x79,
+    0xc1, 0xeb, 0x95, 0xc4, 0xf6, 0xbd, 0x83, 0xa2, 0x70, 0x35, 0x8c, 0x64,
+    0x5c, 0xb2, 0x06, 0x6a, 0x80, 0x05, 0x8b, 0x39, 0x8c, 0x13, 0xeb, 0x0d,
+    0xed, 0x08, 0x11, 0xe5, 0x6a, 0x09, 0x3d, 0x4e, 0x16, 0x74, 0xda, 0x1d,
+    0x2b, 0x01, 0xde, 0xaf, 0x17, 0x03, 0x2f, 0x72, 0x92, 0x18, 0x00, 0xcb,
+    0xf7, 0x5c, 0x87, 0x23, 0xd2, 0x56, 0xd7, 0x82, 0xde, 0x14, 0x91, 0xc9,
+    0x44, 0xce, 0x91, 0x20, 0xb4, 0x57, 0x47, 0xd2, 0xf9, 0x4e, 0x94, 0x8a,
+    0x5a, 0x14, 0x94, 0x85, 0x2b, 0xf1, 0xf8, 0xed, 0xff, 0x4a, 0x8c, 0x99,
+    0xe9, 0x0c, 0x0c, 0xf3, 0xa0, 0x01, 0xe6, 0x9c, 0x58, 0x7a, 0x65, 0xba,
+    0xdd, 0x51, 0xa8, 0x36, 0x8d, 0xec, 0xe6, 0x94, 0x38, 0xb9, 0x46, 0xed,
+    0x70, 0xa4, 0xad, 0x86, 0x7d, 0x50, 0x9b, 0x40, 0xb9, 0x14, 0xc7, 0x46,
+    0xa8, 0x62, 0xc8, 0x05, 0x3e, 0x04, 0x28, 0xb6, 0x88, 0xa1, 0xc4, 0x7a,
+    0x8c, 0x3a, 0x76, 0x8d, 0xb6, 0x18, 0xdc, 0x0a, 0x97, 0xa7, 0x5b, 0x7f,
+    0x99, 0x35, 0x07, 0x69, 0x6b, 0xbc, 0xb4, 0x5d, 0xd3, 0x59, 0x4d, 0x44,
+    0x22, 0x7e, 0x08, 0x3d, 0x89, 0x4e, 0xc0, 0xe9, 0x51, 0x6f, 0x46, 0x61,
+    0xe6, 0xa4, 0x8a, 0x54, 0x05, 0xd4, 0x1f, 0x15, 0x89, 0x53, 0x55, 0x91,
+    0x61, 0x56, 0x90, 0x60, 0x19, 0x56, 0x8d, 0x5e, 0x61, 0x85, 0x3c, 0x3e,
+    0x1c, 0xb8, 0xc6, 0x39, 0x6c, 0x15, 0x91, 0x24, 0xa6, 0xd4, 0x2f, 0xfc,
+    0x2c, 0xd4, 0xb4, 0x17, 0xf9, 0xbc, 0xc9, 0x82, 0xcf, 0x04, 0xd7, 0x2b,
+    0xec, 0x68, 0x25, 0x7b, 0x40, 0x32, 0x40, 0x05, 0xd9, 0x68, 0x22, 0x5d,
+    0x6b, 0x7b, 0x03, 0x7e, 0x7a, 0xec, 0x6b, 0xd8, 0xe7, 0x10, 0x1f, 0x23,
+    0x30, 0x68, 0x01, 0xba, 0x01, 0x85, 0x4f, 0x96, 0x1f, 0x32, 0xb7, 0xa3,
+    0x21, 0xc3, 0x73, 0x98, 0xdd, 0xc2, 0x0a, 0x35, 0xe1, 0x50, 0xa2, 0xa5,
+    0x85, 0x83, 0x57, 0x26, 0x47, 0xd2, 0x38, 0xc7, 0xca, 0x41, 0x25, 0x01,
+    0x3c, 0x87, 0x33, 0xcd, 0x19, 0x7f, 0x90, 0xc5, 0x2c, 0xc8, 0xcd, 0xd0,
+    0x0a, 0x54, 0x2b, 0x5c, 0xa4, 0xcc, 0x56, 0x56, 0xd1, 0x7d, 0x88, 0x1f,
+    0xb8, 0x87, 0xd9, 0xa3, 0x48, 0xfe, 0xe7, 0x83, 0x78, 0x84, 0xa2, 0x06,
+    0xdb, 0x82, 0x56, 0x94, 0xf8, 0x2d, 0x5f, 0x46, 0xe1, 0x4c, 0x49, 0x9b,
+    0xbc, 0xff, 0xc8, 0xfa, 0xcd, 0x39, 0x8f, 0x59, 0x25, 0xc8, 0x2a, 0xb1,
+    0x1b, 0x23, 0x99, 0xfa, 0x7e, 0x21, 0x5c, 0x3e, 0xa2, 0x8b, 0x2d, 0x3b,
+    0xba, 0xfd, 0x50, 0xe5, 0x06, 0x00, 0x51, 0x8e, 0x33, 0x67, 0x6a, 0x84,
+    0x94, 0x31, 0x57, 0x3e, 0x26, 0xa9, 0x48, 0xee, 0xbd, 0x36, 0xcd, 0x5c,
+    0xc8, 0x94, 0xc3, 0x41, 0x20, 0x96, 0xa7, 0x10, 0xf2, 0x67, 0x9b, 0xa1,
+    0xa6, 0xd2, 0x3f, 0x8b, 0x06, 0x5c, 0x28, 0x8a, 0xd9, 0x97, 0x17, 0x3a,
+    0x0a, 0x05, 0x37, 0x36, 0x07, 0xca, 0xdf, 0x63, 0x7e, 0x64, 0x95, 0x72,
+    0xba, 0x3b, 0x7b, 0x7a, 0x01, 0x76, 0x8e, 0xbe, 0x49, 0x05, 0x66, 0xea,
+    0x1a, 0x51, 0x1e, 0x3c, 0x1a, 0x93, 0xa1, 0xc7, 0x25, 0x0c, 0xc4, 0x06,
+    0x70, 0xcf, 0x96, 0x37, 0x64, 0x86, 0x18, 0x7d, 0x38, 0xfa, 0xd9, 0xcc,
+    0x31, 0x00, 0xf7, 0xb9, 0x75, 0x2c, 0x1e, 0x60, 0x35, 0x97, 0xfe, 0x87,
+    0xb0, 0x68, 0xcd, 0xf8, 0xd6, 0x5d, 0x64, 0xef, 0x23, 0xb3, 0x05, 0x7d,
+    0x38, 0x71, 0x5d, 0x53, 0x7f, 0xf4, 0x02, 0x5c, 0x26, 0x7a, 0x32, 0x90,
+    0xb2, 0xd3, 0xec, 0x63, 0x25, 0xea, 0xd5, 0xab, 0x25, 0x43, 0x62, 0x01,
+    0x41, 0x16, 0x2c, 0x30, 0x93, 0xeb, 0xfb, 0xdb, 0xbc, 0xa6, 0xdf, 0x1c,
+    0xa2, 0x19, 0x65, 0x86, 0xed, 0x87, 0x59, 0xb1, 0xf1, 0x96, 0x32, 0x11,
+    0x84, 0xec, 0x31, 0x0c, 0xb2, 0x35, 0x2a, 0x23, 0x90, 0x20, 0x13, 0xb4,
+    0xc5, 0xc3, 0xd0, 0x92, 0xe3, 0x72, 0x51, 0x53, 0xcb, 0xfc, 0x5f, 0x09,
+    0xa9, 0xa0, 0x24, 0xfc, 0x8e, 0x03, 0x2c, 0x93, 0x6e, 0x32, 0x46, 0x25,
+    0x47, 0x5e, 0xc1, 0xcc, 0x54, 0xfc, 0xba, 0x1b, 0x38, 0xa8, 0xf2, 0x3c,
+    0x30, 0x66, 0x48, 0xa8, 0x25, 0xe0, 0x57, 0x10, 0xae, 0xb4, 0x05, 0x84,
+    0x8d, 0x73, 0x36, 0xda, 0x73, 0x4c, 0xec, 0x1e, 0x90, 0x0f, 0xb3, 0x88,
+    0x04, 0xf1, 0x9f, 0x4f, 0x80, 0xa7, 0xee, 0x85, 0xa8, 0x7d, 0xab, 0x6e,
+    0xbe, 0xfd, 0xd9, 0x40, 0x3d, 0x59, 0xe9, 0x6f, 0x3c, 0x0d, 0x85, 0x3c,
+    0x0c, 0x6c, 0x60, 0x65, 0x31, 0xa2, 0x78, 0xb0, 0x34, 0x8a, 0x30, 0x70,
+    0xbd, 0xf9, 0x5a, 0x63, 0xbe, 0x7c, 0x9a, 0x6d, 0x32, 0xee, 0x73, 0xed,
+    0x19, 0x05, 0x66, 0x63, 0x8d, 0xdd, 0x01, 0x17, 0x5f, 0x95, 0x62, 0x0e,
+    0xe9, 0xb0, 0x0d, 0x18, 0x13, 0x6a, 0xb6, 0x9c, 0x3e, 0xcd, 0xc2, 0xd3,
+    0xaa, 0x88, 0xfb, 0x78, 0x48, 0xbe, 0xfd, 0x85, 0x52, 0x9c, 0x85, 0xa2,
+    0xf8, 0xf8, 0x79, 0x95, 0x41, 0xfd, 0x2f, 0x90, 0x7b, 0x6a, 0x7c, 0x4b,
+    0x8a, 0x04, 0x5e, 0x1f, 0x89, 0x2d, 0x26, 0x8e, 0x95, 0x24, 0x6d, 0x70,
+    0x78, 0xd8, 0xbb, 0xeb, 0x42, 0x7f, 0x6d, 0x81, 0xf1, 0xfb, 0xcd, 0x88,
+    0x8a, 0xc5, 0x6c, 0x3e, 0xab, 0x64, 0x4a, 0x75, 0xfd, 0xfa, 0x7d, 0xaa,
+    0x02, 0x0a, 0x8d, 0xe9, 0xf7, 0xd2, 0x3c, 0xb6, 0x5c, 0xc8, 0xc8, 0x38,
+    0x7f, 0xb5, 0xc5, 0x72, 0x0a, 0x2b, 0x7f, 0xb9, 0x34, 0xda, 0x79, 0xe4,
+    0xf7, 0x33, 0x3e, 0x55, 0x2a, 0x23, 0x86, 0x7c, 0xf8, 0xc8, 0x5c, 0xb3,
+    0x6d, 0x26, 0xc6, 0xed, 0xfe, 0xe7, 0x67, 0xca, 0x88, 0xf6, 0xb7, 0x14,
+    0x7b, 0x99, 0x2d, 0x07, 0x6f, 0xd6, 0xd3, 0xb3, 0x42, 0x6a, 0x8c, 0x52,
+    0xb9, 0x05, 0x10, 0x12, 0x22, 0xb6, 0xf2, 0x0d, 0x39, 0x1f, 0xd3, 0x87,
+    0xd4, 0x5f, 0xce, 0x12, 0x37, 0xdb, 0xae, 0xed, 0xf4, 0xc2, 0xde, 0x49,
+    0x25, 0xff, 0x53, 0x8e, 0x5a, 0x43, 0x9e, 0xe7, 0xaa, 0x41, 0x40, 0x76,
+    0x70, 0xee, 0xa3, 0x29, 0x5e, 0xbd, 0x59, 0xb3, 0x47, 0xb0, 0xa2, 0x5a,
+    0x04, 0xcd, 0x3a, 0x30, 0x07, 0x2d, 0x2a, 0xb8, 0xc2, 0x95, 0x57, 0x16,
+    0x33, 0xb7, 0x4a, 0xa6, 0xc1, 0xaa, 0x0f, 0x95, 0x1f, 0x86, 0xa2, 0xdf,
+    0x03, 0x5e, 0x19, 0xff, 0x65, 0xe8, 0xd6, 0x8c, 0xec, 0x60, 0xb3, 0x5e,
+    0x63, 0xb0, 0x9c, 0x63, 0x4d, 0xa7, 0xe1, 0x19, 0x28, 0x25, 0xc1, 0x7e,
+    0xd6, 0x20, 0x5c, 0x77, 0xdf, 0x4d, 0x4c, 0xa4, 0x7f, 0x2d, 0x72, 0x08,
+    0x32, 0x2d, 0xc9, 0xb0, 0xbc, 0x45, 0xd1, 0x83, 0xe8, 0x07, 0x22, 0x3b,
+    0xe4, 0x60, 0xda, 0x73, 0x29, 0x09, 0x3d, 0xa1, 0xb9, 0x13, 0x28, 0x96,
+    0x0b, 0x42, 0x8f, 0x73, 0xd6, 0x72, 0x65, 0xeb, 0xca, 0x52, 0x1a, 0x15,
+    0xef, 0xa0, 0xa4, 0x80, 0x57, 0xe4, 0xee, 0x23, 0x00
+};
+
+#endif
@@ -0,0 +1,558 @@
+/* Tables for the 256-layer Ziggurat samplers in distributions.c.
+ *
+ * The layers are built as in Marsaglia and Tsang (2000) for the
+ * unnormalized densities exp(-x*x/2) (r = 3.6541528853610088,
+ * v = 0.00492867323399) and exp(-x) (r = 7.69711747013104972,
+ * v = 0.0039496598225815571993), scaled for a 53 bit random integer:
+ *
+ *   ki[i]  acceptance threshold x[i-1]/x[i] * 2**53 (ki[0] for the base
+ *          strip, ki[1] == 0 since the top layer is always a wedge)
+ *   wi[i]  x[i] / 2**53
+ *   fi[i]  f(x[i])
+ *
+ * The thresholds are integers below 2**53 and are therefore exact as
+ * doubles, which avoids the need for a 64 bit integer type.
+ */
+
+#ifndef _RK_ZIGGURAT_CONSTANTS_
+#define _RK_ZIGGURAT_CONSTANTS_
+
+#define RK_ZIG_NORMAL_R 3.6541528853610088
+#define RK_ZIG_NORMAL_INV_R 0.27366123732975828
+#define RK_ZIG_EXP_R 7.69711747013104972
+
+static const double rk_zig_ki_normal[256] = {
+    8416190284920947.0, 0.0, 6774628846754132.0,
+    7677520152659052.0, 8061537608569706.0, 8273463477662850.0,
+    8407514496123960.0, 8499835136350465.0, 8567234683134558.0,
+    8618578446237483.0, 8658979550320583.0, 8691591814763085.0,
+    8718465117470087.0, 8740989007458224.0, 8760138492417274.0,
+    8776617738072653.0, 8790947915088034.0, 8803522963558493.0,
+    8814646152034174.0, 8824554724428979.0, 8833436927219712.0,
+    8841444029026801.0, 8848698969548666.0, 8855302690813572.0,
+    8861338844005866.0, 8866877337946155.0, 8871977048552789.0,
+    8876687911856517.0, 8881052558151494.0, 8885107600466198.0,
+    8888884659728808.0, 8892411187313549.0, 8895711130184076.0,
+    8898805472677839.0, 8901712680814989.0, 8904449068990837.0,
+    8907029104419008.0, 8909465661311690.0, 8911770234216932.0,
+    8913953117968370.0, 8916023560187258.0, 8917989891099221.0,
+    8919859634506764.0, 8921639603032983.0, 8923335980176995.0,
+    8924954391263249.0, 8926499964999537.0, 8927977387062535.0,
+    8929390946889872.0, 8930744578662654.0, 8932041897302797.0,
+    8933286230178526.0, 8934480645103322.0, 8935627975124157.0,
+    8936730840520449.0, 8937791668373126.0, 8938812710011249.0,
+    8939796056599925.0, 8940743653096490.0, 8941657310770789.0,
+    8942538718458958.0, 8943389452697679.0, 8944210986866669.0,
+    8945004699450818.0, 8945771881519230.0, 8946513743506430.0,
+    8947231421370463.0, 8947925982193667.0, 8948598429284025.0,
+    8949249706828286.0, 8949880704142075.0, 8950492259557096.0,
+    8951085163981048.0, 8951660164161897.0, 8952217965684740.0,
+    8952759235726383.0, 8953284605590188.0, 8953794673041287.0,
+    8954290004460246.0, 8954771136831346.0, 8955238579580123.0,
+    8955692816273207.0, 8956134306192367.0, 8956563485793388.0,
+    8956980770059460.0, 8957386553757799.0, 8957781212607453.0,
+    8958165104365423.0, 8958538569837653.0, 8958901933820840.0,
+    8959255505980417.0, 8959599581669657.0, 8959934442694393.0,
+    8960260358027436.0, 8960577584476434.0, 8960886367308626.0,
+    8961186940835588.0, 8961479528960890.0, 8961764345693266.0,
+    8962041595627745.0, 8962311474396955.0, 8962574169094642.0,
+    8962829858673310.0, 8963078714317695.0, 8963320899795673.0,
+    8963556571788085.0, 8963785880198839.0, 8964008968446530.0,
+    8964225973738754.0, 8964437027330181.0, 8964642254765379.0,
+    8964841776107297.0, 8965035706152275.0, 8965224154632340.0,
+    8965407226405534.0, 8965585021634947.0, 8965757635957052.0,
+    8965925160639953.0, 8966087682732055.0, 8966245285201657.0,
+    8966398047067923.0, 8966546043523656.0, 8966689346050266.0,
+    8966828022525266.0, 8966962137322676.0, 8967091751406581.0,
+    8967216922418168.0, 8967337704756474.0, 8967454149653080.0,
+    8967566305240962.0, 8967674216617702.0, 8967777925903211.0,
+    8967877472292128.0, 8967972892101036.0, 8968064218810590.0,
+    8968151483102689.0, 8968234712892753.0, 8968313933357176.0,
+    8968389166956015.0, 8968460433450955.0, 8968527749918546.0,
+    8968591130758759.0, 8968650587698807.0, 8968706129792232.0,
+    8968757763413213.0, 8968805492246014.0, 8968849317269534.0,
+    8968889236736817.0, 8968925246149460.0, 8968957338226741.0,
+    8968985502869353.0, 8969009727117536.0, 8969029995103450.0,
+    8969046287997544.0, 8969058583948667.0, 8969066858017693.0,
+    8969071082104321.0, 8969071224866729.0, 8969067251633735.0,
+    8969059124309045.0, 8969046801267160.0, 8969030237240468.0,
+    8969009383196996.0, 8968984186208218.0, 8968954589306352.0,
+    8968920531330395.0, 8968881946760199.0, 8968838765537728.0,
+    8968790912874633.0, 8968738309045138.0, 8968680869163176.0,
+    8968618502942615.0, 8968551114439256.0, 8968478601773210.0,
+    8968400856830126.0, 8968317764939530.0, 8968229204528444.0,
+    8968135046748221.0, 8968035155072334.0, 8967929384862633.0,
+    8967817582901332.0, 8967699586885679.0, 8967575224881977.0,
+    8967444314735228.0, 8967306663430302.0, 8967162066400074.0,
+    8967010306775436.0, 8966851154571576.0, 8966684365804223.0,
+    8966509681528852.0, 8966326826795004.0, 8966135509506982.0,
+    8965935419181038.0, 8965726225588057.0, 8965507577269295.0,
+    8965279099911185.0, 8965040394563353.0, 8964791035682066.0,
+    8964530568978732.0, 8964258509050525.0, 8963974336766888.0,
+    8963677496382064.0, 8963367392339478.0, 8963043385728847.0,
+    8962704790351056.0, 8962350868339047.0, 8961980825274930.0,
+    8961593804734187.0, 8961188882176582.0, 8960765058090368.0,
+    8960321250280539.0, 8959856285173244.0, 8959368887986041.0,
+    8958857671586717.0, 8958321123830820.0, 8957757593128693.0,
+    8957165271944704.0, 8956542177872731.0, 8955886131859835.0,
+    8955194733060995.0, 8954465329697326.0, 8953694985152301.0,
+    8952880438367481.0, 8952018057380786.0, 8951103784572767.0,
+    8950133071831210.0, 8949100803386929.0, 8948001203479725.0,
+    8946827725236315.0, 8945572916116506.0, 8944228253917923.0,
+    8942783945492901.0, 8941228677835351.0, 8939549307766225.0,
+    8937730471677702.0, 8935754090078970.0, 8933598732090616.0,
+    8931238791116700.0, 8928643402399174.0, 8925775002338468.0,
+    8922587382248582.0, 8919023015271841.0, 8915009316506028.0,
+    8910453300649909.0, 8905233768484580.0, 8899189566881475.0,
+    8892101391295202.0, 8883662533319100.0, 8873429784347971.0,
+    8860736633794510.0, 8844529650149292.0, 8823034015404043.0,
+    8792993062619681.0, 8747665408408210.0, 8670250209926708.0,
+    8502199523357717.0
+};
+
+static const double rk_zig_wi_normal[256] = {
+    4.3418135304141737e-16, 2.3896650870688797e-17, 3.1771762082051292e-17,
+    3.7274352402467621e-17, 4.1646834075866415e-17, 4.5340302022634032e-17,
+    4.8574300380484232e-17, 5.1473751569082543e-17, 5.4117151440297643e-17,
+    5.6557350978751297e-17, 5.8831797283442356e-17, 6.0968086392002218e-17,
+    6.2987199571703848e-17, 6.4905499429914999e-17, 6.6736018682782607e-17,
+    6.8489324211577556e-17, 7.0174115004986674e-17, 7.1797647259107414e-17,
+    7.3366043710688221e-17, 7.4884523340860873e-17, 7.6357575016922943e-17,
+    7.7789090846279102e-17, 7.9182470045460499e-17, 8.0540700875409271e-17,
+    8.1866426018910435e-17, 8.3161995291190133e-17, 8.4429508542492112e-17,
+    8.5670850881929201e-17, 8.688772182847568e-17, 8.8081659614175665e-17,
+    8.9254061584072552e-17, 9.0406201428201921e-17, 9.1539243823356279e-17,
+    9.2654256942328178e-17, 9.3752223196122271e-17, 9.4834048503140761e-17,
+    9.5900570323473535e-17, 9.695256465241881e-17, 9.799075213244969e-17,
+    9.9015803414958234e-17, 1.0002834388069532e-16, 1.0102895780969778e-16,
+    1.02018192076751e-16, 1.0299655943637851e-16, 1.0396454145143972e-16,
+    1.0492259111123072e-16, 1.0587113517818965e-16, 1.0681057629664595e-16,
+    1.0774129489231228e-16, 1.0866365088723492e-16, 1.0957798525155729e-16,
+    1.1048462141060512e-16, 1.1138386652338366e-16, 1.1227601264651482e-16,
+    1.1316133779587836e-16, 1.1404010691670755e-16, 1.1491257277158665e-16,
+    1.1577897675467358e-16, 1.1663954963949753e-16, 1.1749451226683654e-16,
+    1.1834407617844563e-16, 1.1918844420176452e-16, 1.2002781099017417e-16,
+    1.208623635228794e-16, 1.2169228156806472e-16, 1.225177381125895e-16,
+    1.2333889976115503e-16, 1.2415592710757905e-16, 1.2496897508055209e-16,
+    1.2577819326601702e-16, 1.2658372620810663e-16, 1.2738571369039041e-16,
+    1.2818429099901738e-16, 1.2897958916919519e-16, 1.2977173521631455e-16,
+    1.3056085235291113e-16, 1.3134706019255046e-16, 1.3213047494162762e-16,
+    1.3291120957998736e-16, 1.3368937403119398e-16, 1.3446507532321031e-16,
+    1.3523841774018292e-16, 1.3600950296597336e-16, 1.3677843022002424e-16,
+    1.3754529638610207e-16, 1.3831019613441663e-16, 1.3907322203757765e-16,
+    1.398344646808152e-16, 1.4059401276685794e-16, 1.4135195321583402e-16,
+    1.4210837126053347e-16, 1.4286335053734627e-16, 1.436169731731682e-16,
+    1.4436931986854626e-16, 1.4512046997731719e-16, 1.4587050158297521e-16,
+    1.4661949157198985e-16, 1.4736751570428027e-16, 1.4811464868103959e-16,
+    1.4886096421009044e-16, 1.4960653506894231e-16, 1.5035143316571082e-16,
+    1.5109572959804994e-16, 1.5183949471023949e-16, 1.5258279814856285e-16,
+    1.5332570891510211e-16, 1.5406829542007168e-16, 1.5481062553280536e-16,
+    1.5555276663150625e-16, 1.5629478565186389e-16, 1.5703674913463857e-16,
+    1.5777872327230859e-16, 1.5852077395487222e-16, 1.5926296681489332e-16,
+    1.6000536727187576e-16, 1.6074804057604971e-16, 1.6149105185165028e-16,
+    1.6223446613976653e-16, 1.6297834844083768e-16, 1.6372276375687117e-16,
+    1.6446777713345637e-16, 1.6521345370164635e-16, 1.6595985871977952e-16,
+    1.6670705761531252e-16, 1.6745511602673479e-16, 1.6820409984563605e-16,
+    1.6895407525899721e-16, 1.697051087917761e-16, 1.7045726734985979e-16,
+    1.7121061826345624e-16, 1.7196522933099873e-16, 1.7272116886363819e-16,
+    1.7347850573039999e-16, 1.7423730940408327e-16, 1.7499765000798338e-16,
+    1.7575959836351978e-16, 1.7652322603885479e-16, 1.772886053985913e-16,
+    1.7805580965464063e-16, 1.7882491291835541e-16, 1.7959599025402609e-16,
+    1.8036911773384383e-16, 1.8114437249443749e-16, 1.8192183279509679e-16,
+    1.8270157807779967e-16, 1.8348368902916784e-16, 1.8426824764448008e-16,
+    1.8505533729388087e-16, 1.8584504279092866e-16, 1.8663745046363626e-16,
+    1.8743264822816505e-16, 1.8823072566534355e-16, 1.8903177410019166e-16,
+    1.8983588668464236e-16, 1.906431584836655e-16, 1.9145368656501024e-16,
+    1.9226757009279751e-16, 1.9308491042520848e-16, 1.9390581121653183e-16,
+    1.9473037852385024e-16, 1.9555872091866563e-16, 1.9639094960378389e-16,
+    1.9722717853580207e-16, 1.9806752455356639e-16, 1.9891210751299515e-16,
+    1.9976105042869066e-16, 2.0061447962279526e-16, 2.0147252488158159e-16,
+    2.0233531962030407e-16, 2.0320300105688045e-16, 2.0407571039501622e-16,
+    2.0495359301743396e-16, 2.0583679868992323e-16, 2.0672548177698505e-16,
+    2.0761980146990898e-16, 2.0851992202819166e-16, 2.0942601303528279e-16,
+    2.1033824966972926e-16, 2.1125681299288228e-16, 2.1218189025443504e-16,
+    2.1311367521717238e-16, 2.1405236850243961e-16, 2.149981779579767e-16,
+    2.1595131904991781e-16, 2.1691201528092719e-16, 2.1788049863663138e-16,
+    2.1885701006271959e-16, 2.1984179997531754e-16, 2.2083512880750293e-16,
+    2.2183726759512237e-16, 2.2284849860539744e-16, 2.2386911601217327e-16,
+    2.2489942662207529e-16, 2.2593975065630198e-16, 2.2699042259330202e-16,
+    2.280517920781727e-16, 2.2912422490528122e-16, 2.3020810408136181e-16,
+    2.3130383097719773e-16, 2.3241182657696705e-16, 2.3353253283543949e-16,
+    2.3466641415447564e-16, 2.3581395899172804e-16, 2.3697568161610507e-16,
+    2.3815212402646986e-16, 2.3934385805225037e-16, 2.4055148765718637e-16,
+    2.41775651470393e-16, 2.4301702557235857e-16, 2.4427632656749942e-16,
+    2.4555431497958406e-16, 2.4685179901183859e-16, 2.4816963872002251e-16,
+    2.4950875065441555e-16, 2.5087011303573023e-16, 2.5225477154076347e-16,
+    2.5366384578650548e-16, 2.550985366169078e-16, 2.5656013431517022e-16,
+    2.5805002788699383e-16, 2.5956971558771873e-16, 2.6112081689984689e-16,
+    2.6270508620871642e-16, 2.6432442847508519e-16, 2.6598091726675939e-16,
+    2.6767681559066564e-16, 2.6941460006654494e-16, 2.7119698910992937e-16,
+    2.7302697595358431e-16, 2.7490786754448752e-16, 2.7684333062324214e-16,
+    2.7883744664617874e-16, 2.8089477767762238e-16, 2.8302044600397433e-16,
+    2.8522023106442435e-16, 2.8750068844585144e-16, 2.8986929728608818e-16,
+    2.9233464467263432e-16, 2.9490665882375727e-16, 2.9759690748193647e-16,
+    3.0041898481346175e-16, 3.0338902046654093e-16, 3.0652636043613485e-16,
+    3.0985449472895452e-16, 3.1340234816494007e-16, 3.1720612035625401e-16,
+    3.2131198297728459e-16, 3.257801658671349e-16, 3.3069139425477232e-16,
+    3.3615752312517293e-16, 3.4234017087811187e-16, 3.4948591681928653e-16,
+    3.5799974674144742e-16, 3.6862121508986668e-16, 3.8294681854022677e-16,
+    4.0569246688282421e-16
+};
+
+static const double rk_zig_fi_normal[256] = {
+    1, 0.97710170128273133, 0.95987909181241593,
+    0.94519895345307803, 0.93206007596899021, 0.91999150504836025,
+    0.90872644006056291, 0.89809592190630405, 0.88798466076339988,
+    0.87830965581614684, 0.86900868804379316, 0.86003362120300864,
+    0.85134625846512368, 0.84291565311844108, 0.83471629299293038,
+    0.82672683395209423, 0.8189291916094148, 0.81130787431821993,
+    0.80384948317638949, 0.79654233042825462, 0.78937614357119856,
+    0.7823418326598619, 0.77543130498613833, 0.76863731580333483,
+    0.76195334684154647, 0.7553735065117545, 0.74889244722372672,
+    0.74250529634463625, 0.73620759813126668, 0.72999526456580244,
+    0.7238645334728816, 0.7178119326349014, 0.71183424888235847,
+    0.70592850133679741, 0.7000919181404901, 0.69432191613003258,
+    0.68861608300852706, 0.68297216164879138, 0.67738803622251309,
+    0.67186171990076637, 0.66639134391238064, 0.66097514778024136,
+    0.65561147058322466, 0.65029874311429459, 0.64503548082425188,
+    0.63982027745643899, 0.63465179929096005, 0.62952877992812828,
+    0.62445001555027424, 0.61941436060903921, 0.6144207238920768,
+    0.60946806492889538, 0.60455539070054953, 0.59968175262216772,
+    0.59484624377099127, 0.59004799633579197, 0.58528617926630033,
+    0.58055999610368347, 0.57586868297521054, 0.57121150673807497,
+    0.56658776325895177, 0.56199677581727792, 0.55743789362148632,
+    0.55291049042851992, 0.54841396325792113, 0.54394773119264994,
+    0.53951123425954461, 0.53510393238301956, 0.53072530440619392,
+    0.5263748471741867, 0.52205207467479486, 0.51775651723220062,
+    0.51348772074974303, 0.50924524599813614, 0.50502866794582879,
+    0.50083757512848215, 0.49667156905479631, 0.49253026364614866,
+    0.48841328470771206, 0.4843202694289116, 0.48025086591124971,
+    0.47620473272168379, 0.47218153846988326, 0.46818096140782217,
+    0.46420268905027884, 0.46024641781492348, 0.45631185268077357,
+    0.4523987068638825, 0.44850670150921407, 0.44463556539772775,
+    0.44078503466776991, 0.43695485254992927, 0.43314476911457406,
+    0.42935454103134152, 0.42558393133990058, 0.4218327092313533,
+    0.41810064983968459, 0.41438753404270678, 0.41069314827198322,
+    0.40701728433124795, 0.40335973922286888, 0.39972031498193167,
+    0.39609881851754708, 0.39249506146101076, 0.3889088600204646,
+    0.38534003484173396, 0.38178841087503135, 0.37825381724723811,
+    0.37473608713949141, 0.37123505766982134, 0.36775056978059623,
+    0.3642824681305496, 0.36083060099117575, 0.35739482014729052,
+    0.35397498080156925, 0.3505709414828812, 0.34718256395825148,
+    0.34380971314829134, 0.34045225704594545, 0.33711006663841281,
+    0.33378301583210851, 0.3304709813805371, 0.32717384281495859,
+    0.32389148237773202, 0.32062378495823013, 0.3173706380312224,
+    0.31413193159763014, 0.31090755812756371, 0.30769741250555377,
+    0.30450139197789627, 0.30131939610203412, 0.29815132669790134,
+    0.29499708780116257, 0.29185658561828098, 0.28872972848335393,
+    0.28561642681665811, 0.28251659308484939, 0.27943014176276532,
+    0.27635698929678126, 0.2732970540696758, 0.27025025636695998,
+    0.26721651834463184, 0.26419576399831757, 0.26118791913376371,
+    0.25819291133864802, 0.25521066995567715, 0.25224112605694377,
+    0.2492842124195167, 0.24633986350223877, 0.24340801542371199,
+    0.24048860594144911, 0.23758157443217368, 0.23468686187325269,
+    0.23180441082524852, 0.22893416541557748, 0.22607607132326488,
+    0.22323007576478959, 0.22039612748101159, 0.21757417672517837,
+    0.2147641752520085, 0.21196607630785294, 0.20917983462193565,
+    0.20640540639867933, 0.2036427493111215, 0.20089182249543133,
+    0.19815258654653811, 0.19542500351488559, 0.19270903690432881,
+    0.19000465167119307, 0.18731181422451693, 0.18463049242750454,
+    0.18196065560021649, 0.1793022745235304, 0.17665532144440665,
+    0.17401977008249936, 0.17139559563815562, 0.16878277480185033,
+    0.16618128576511007, 0.16359110823298295, 0.16101222343811766,
+    0.15844461415652022, 0.15588826472506456, 0.15334316106083767,
+    0.15080929068241017, 0.14828664273312872, 0.14577520800653793,
+    0.14327497897404712, 0.14078594981496831, 0.13830811644906432,
+    0.13584147657175735, 0.13338602969216284, 0.13094177717412817,
+    0.12850872228047364, 0.12608687022065035, 0.1236762282020514,
+    0.12127680548523544, 0.1188886134433457, 0.11651166562603701,
+    0.11414597782825521, 0.11179156816424558, 0.10944845714721002,
+    0.10711666777507288, 0.10479622562286706, 0.10248715894230627,
+    0.10018949876917202, 0.097903279039215627, 0.095628536713353335,
+    0.093365311913026619, 0.091113648066700734, 0.088873592068594229,
+    0.086645194450867782, 0.084428509570654661, 0.082223595813495684,
+    0.080030515814947509, 0.077849336702372207, 0.075680130359194964,
+    0.073522973714240991, 0.071377949059141965, 0.069245144397250269,
+    0.067124653828023989, 0.065016577971470438, 0.062921024437977854,
+    0.060838108349751806, 0.058767952921137984, 0.056710690106399467,
+    0.054666461325077916, 0.052635418276973649, 0.050617723861121788,
+    0.048613553216035145, 0.046623094902089664, 0.044646552251446536,
+    0.042684144916619378, 0.040736110656078753, 0.038802707404656918,
+    0.036884215688691151, 0.034980941461833073, 0.033093219458688698,
+    0.03122141719202369, 0.029365939758230111, 0.027527235669693315,
+    0.025705804008632656, 0.023902203305873237, 0.022117062707379922,
+    0.020351096230109354, 0.01860512127578335, 0.016880083152595839,
+    0.015177088307982072, 0.013497450601780807, 0.011842757857943104,
+    0.0102149714397311, 0.0086165827694229171, 0.0070508754713921101,
+    0.005522403299264754, 0.0040379725933718715, 0.0026090727461063629,
+    0.001260285930498598
+};
+
+static const double rk_zig_ki_exp[256] = {
+    7971545857431493.0, 0.0, 5485857970336037.0,
+    6877400373607409.0, 7489560515621019.0, 7829793950745714.0,
+    8045251395085587.0, 8193552821270896.0, 8301707212298418.0,
+    8384003209374830.0, 8448689755168200.0, 8500854585063477.0,
+    8543802742323104.0, 8579772857648237.0, 8610334328270396.0,
+    8636619566280862.0, 8659465946817879.0, 8679505875409357.0,
+    8697225801520777.0, 8713005977443535.0, 8727147906454691.0,
+    8739893704890037.0, 8751440024696698.0, 8761948238062960.0,
+    8771552003860597.0, 8780362968290612.0, 8788475114930439.0,
+    8795968123070796.0, 8802909988292859.0, 8809359087581713.0,
+    8815365821575971.0, 8820973931588801.0, 8826221564107157.0,
+    8831142137483406.0, 8835765052397424.0, 8840116277974650.0,
+    8844218838221543.0, 8848093218006260.0, 8851757703688505.0,
+    8855228670347737.0, 8858520825126080.0, 8861647414312949.0,
+    8864620400320394.0, 8867450613535033.0, 8870147883110754.0,
+    8872721150032147.0, 8875178565190243.0, 8877527574738172.0,
+    8879774994610605.0, 8881927075778635.0, 8883989561556502.0,
+    8885967738067170.0, 8887866478800855.0, 8889690284057819.0,
+    8891443315947668.0, 8893129429518481.0, 8894752200505985.0,
+    8896314950123265.0, 8897820767252858.0, 8899272528353284.0,
+    8900672915349967.0, 8902024431744704.0, 8903329417147195.0,
+    8904590060406012.0, 8905808411494019.0, 8906986392283811.0,
+    8908125806332287.0, 8909228347778946.0, 8910295609450181.0,
+    8911329090250870.0, 8912330201915376.0, 8913300275181656.0,
+    8914240565445169.0, 8915152257942917.0, 8916036472512491.0,
+    8916894267966146.0, 8917726646115692.0, 8918534555480191.0,
+    8919318894705171.0, 8920080515719157.0, 8920820226650620.0,
+    8921538794526265.0, 8922236947769419.0, 8922915378515481.0,
+    8923574744759821.0, 8924215672351959.0, 8924838756848638.0,
+    8925444565237162.0, 8926033637539418.0, 8926606488305931.0,
+    8927163608008600.0, 8927705464339880.0, 8928232503425546.0,
+    8928745150957558.0, 8929243813252980.0, 8929728878244356.0,
+    8930200716406566.0, 8930659681624711.0, 8931106112007191.0,
+    8931540330647877.0, 8931962646340836.0, 8932373354250909.0,
+    8932772736543126.0, 8933161062973653.0, 8933538591444896.0,
+    8933905568527004.0, 8934262229948012.0, 8934608801054530.0,
+    8934945497244895.0, 8935272524376416.0, 8935590079148329.0,
+    8935898349461877.0, 8936197514758883.0, 8936487746340036.0,
+    8936769207664050.0, 8937042054628745.0, 8937306435835060.0,
+    8937562492834856.0, 8937810360363403.0, 8938050166557285.0,
+    8938282033158467.0, 8938506075705164.0, 8938722403710132.0,
+    8938931120826947.0, 8939132325004767.0, 8939326108632064.0,
+    8939512558669762.0, 8939691756774160.0, 8939863779409990.0,
+    8940028697953973.0, 8940186578789102.0, 8940337483389967.0,
+    8940481468399304.0, 8940618585695992.0, 8940748882454663.0,
+    8940872401197050.0, 8940989179835209.0, 8941099251706688.0,
+    8941202645601705.0, 8941299385782369.0, 8941389491993960.0,
+    8941472979468231.0, 8941549858918699.0, 8941620136527849.0,
+    8941683813926149.0, 8941740888162738.0, 8941791351667642.0,
+    8941835192205303.0, 8941872392819228.0, 8941902931767473.0,
+    8941926782448692.0, 8941943913318396.0, 8941954287795085.0,
+    8941957864155807.0, 8941954595420726.0, 8941944429226145.0,
+    8941927307685494.0, 8941903167237603.0, 8941871938481652.0,
+    8941833545998017.0, 8941787908154234.0, 8941734936895207.0,
+    8941674537516675.0, 8941606608420920.0, 8941531040853538.0,
+    8941447718620058.0, 8941356517781006.0, 8941257306323959.0,
+    8941149943810914.0, 8941034280999230.0, 8940910159434165.0,
+    8940777411010893.0, 8940635857503636.0, 8940485310059378.0,
+    8940325568653339.0, 8940156421503112.0, 8939977644438116.0,
+    8939789000220576.0, 8939590237814000.0, 8939381091594596.0,
+    8939161280500638.0, 8938930507114327.0, 8938688456670013.0,
+    8938434795982095.0, 8938169172285112.0, 8937891211977750.0,
+    8937600519261604.0, 8937296674664433.0, 8936979233436517.0,
+    8936647723807418.0, 8936301645088912.0, 8935940465608205.0,
+    8935563620453574.0, 8935170509012444.0, 8934760492279317.0,
+    8934332889908232.0, 8933886976981030.0, 8933421980459035.0,
+    8932937075281381.0, 8932431380068266.0, 8931903952381602.0,
+    8931353783488910.0, 8930779792568493.0, 8930180820284954.0,
+    8929555621653500.0, 8928902858099224.0, 8928221088602964.0,
+    8927508759808349.0, 8926764194944404.0, 8925985581394243.0,
+    8925170956711906.0, 8924318192855507.0, 8923424978364231.0,
+    8922488798157888.0, 8921506910578772.0, 8920476321224197.0,
+    8919393753031107.0, 8918255611967911.0, 8917057947558150.0,
+    8915796407299443.0, 8914466183841291.0, 8913061953535785.0,
+    8911577804662434.0, 8910007153233213.0, 8908342643782163.0,
+    8906576031902208.0, 8904698044465301.0, 8902698212389654.0,
+    8900564669414923.0, 8898283908495805.0, 8895840484961221.0,
+    8893216652275641.0, 8890391911743354.0, 8887342451323379.0,
+    8884040440144925.0, 8880453133239800.0, 8876541723776520.0,
+    8872259855113104.0, 8867551668208539.0, 8862349204777254.0,
+    8856568902200014.0, 8850106784293917.0, 8842831740745004.0,
+    8834575940248167.0, 8825120832349126.0, 8814176156651891.0,
+    8801347484544987.0, 8786084197194148.0, 8767592496903177.0,
+    8744682338845716.0, 8715480686119911.0, 8676850260251934.0,
+    8623083654098354.0, 8542525795804797.0, 8406823688997809.0,
+    8122426762520768.0
+};
+
+static const double rk_zig_wi_exp[256] = {
+    9.6557400632091869e-16, 7.0890142439552017e-18, 1.1639412496691068e-17,
+    1.5243915123532025e-17, 1.8332848857237325e-17, 2.1089651094644762e-17,
+    2.361128077843129e-17, 2.595595772310885e-17, 2.8161735541977431e-17,
+    3.0255041303213737e-17, 3.2255082548363667e-17, 3.417632340185019e-17,
+    3.6029969787344457e-17, 3.7824907768696417e-17, 3.9568321980975465e-17,
+    4.1266117781759396e-17, 4.2923218084425182e-17, 4.4543777432823646e-17,
+    4.6131339814831792e-17, 4.7688957252646292e-17, 4.9219280437279567e-17,
+    5.0724629045031415e-17, 5.2207047027926668e-17, 5.3668346617181879e-17,
+    5.5110143728350898e-17, 5.653388673239661e-17, 5.7940880048527605e-17,
+    5.9332303652089369e-17, 6.0709229328471734e-17, 6.2072634311631861e-17,
+    6.3423412803030691e-17, 6.4762385759561335e-17, 6.6090309257693978e-17,
+    6.7407881678727136e-17, 6.871574991183805e-17, 7.0014514734039222e-17,
+    7.130473549660636e-17, 7.258693422414641e-17, 7.3861599213817846e-17,
+    7.5129188207237195e-17, 7.6390131195508172e-17, 7.7644832907978407e-17,
+    7.8893675027297832e-17, 8.013701816675447e-17, 8.1375203640417548e-17,
+    8.2608555052100308e-17, 8.383737972539132e-17, 8.5061969993853145e-17,
+    8.6282604367841044e-17, 8.7499548592161739e-17, 8.8713056606902449e-17,
+    8.9923371422153484e-17, 9.1130725915979018e-17, 9.2335343563817807e-17,
+    9.3537439106491203e-17, 9.4737219163129422e-17, 9.5934882794579899e-17,
+    9.7130622022215126e-17, 9.8324622306495027e-17, 9.9517062989150632e-17,
+    1.0070811770242941e-16, 1.0189795474846933e-16, 1.0308673745154211e-16,
+    1.0427462448561878e-16, 1.0546177017945757e-16, 1.0664832480119141e-16,
+    1.0783443482419478e-16, 1.0902024317583499e-16, 1.1020588947055775e-16,
+    1.1139151022861968e-16, 1.1257723908165667e-16, 1.137632069661684e-16,
+    1.1494954230590088e-16, 1.1613637118402178e-16, 1.1732381750590453e-16,
+    1.1851200315326689e-16, 1.1970104813034647e-16, 1.208910707027385e-16,
+    1.2208218752947057e-16, 1.2327451378884147e-16, 1.244681632985112e-16,
+    1.2566324863028983e-16, 1.2685988122003975e-16, 1.2805817147307494e-16,
+    1.2925822886541193e-16, 1.3046016204120288e-16, 1.3166407890665723e-16,
+    1.3287008672073809e-16, 1.3407829218289992e-16, 1.3528880151811752e-16,
+    1.3650172055943978e-16, 1.3771715482828812e-16, 1.3893520961270639e-16,
+    1.4015599004375715e-16, 1.4137960117024852e-16, 1.4260614803196654e-16,
+    1.4383573573157904e-16, 1.4506846950536879e-16, 1.463044547929476e-16,
+    1.4754379730609519e-16, 1.4878660309686261e-16, 1.5003297862507372e-16,
+    1.5128303082535397e-16, 1.525368671738126e-16, 1.5379459575449972e-16,
+    1.5505632532575776e-16, 1.563221653865838e-16, 1.5759222624311766e-16,
+    1.5886661907536844e-16, 1.601454560042917e-16, 1.6142885015932789e-16,
+    1.6271691574651307e-16, 1.6400976811727184e-16, 1.6530752383800374e-16,
+    1.6661030076057423e-16, 1.6791821809382291e-16, 1.6923139647620225e-16,
+    1.7054995804966301e-16, 1.7187402653490319e-16, 1.7320372730810086e-16,
+    1.7453918747925342e-16, 1.7588053597224916e-16, 1.7722790360680067e-16,
+    1.7858142318237329e-16, 1.799412295642464e-16, 1.8130745977185018e-16,
+    1.8268025306952525e-16, 1.8405975105985881e-16, 1.8544609777975697e-16,
+    1.8683943979941929e-16, 1.8823992632438923e-16, 1.896477093008617e-16,
+    1.9106294352443768e-16, 1.9248578675252443e-16, 1.9391639982058999e-16,
+    1.9535494676249096e-16, 1.9680159493510381e-16, 1.9825651514750198e-16,
+    1.9971988179493426e-16, 2.0119187299787352e-16, 2.026726707464199e-16,
+    2.0416246105035895e-16, 2.0566143409519184e-16, 2.0716978440447375e-16,
+    2.0868771100881602e-16, 2.1021541762192933e-16, 2.1175311282410764e-16,
+    2.1330101025357796e-16, 2.1485932880616636e-16, 2.1642829284376052e-16,
+    2.1800813241207843e-16, 2.195990834682871e-16, 2.2120138811904962e-16,
+    2.228152948696181e-16, 2.2444105888463086e-16, 2.2607894226131737e-16,
+    2.277292143158621e-16, 2.2939215188373114e-16, 2.3106803963482138e-16,
+    2.3275717040435351e-16, 2.3445984554049584e-16, 2.3617637526977745e-16,
+    2.3790707908142772e-16, 2.396522861318624e-16, 2.4141233567062933e-16,
+    2.431875774892256e-16, 2.4497837239430707e-16, 2.4678509270692892e-16,
+    2.4860812278958522e-16, 2.504478596029557e-16, 2.523047132944217e-16,
+    2.5417910782058122e-16, 2.5607148160617708e-16, 2.5798228824205309e-16,
+    2.5991199722497464e-16, 2.6186109474239242e-16, 2.6383008450549423e-16,
+    2.6581948863418446e-16, 2.6782984859795252e-16, 2.6986172621694889e-16,
+    2.7191570472798185e-16, 2.7399238992058148e-16, 2.7609241134876166e-16,
+    2.7821642362464361e-16, 2.8036510780069835e-16, 2.8253917284802532e-16,
+    2.8473935723881741e-16, 2.8696643064198177e-16, 2.8922119574179956e-16,
+    2.9150449019052932e-16, 2.9381718870700281e-16, 2.9616020533454652e-16,
+    2.9853449587300448e-16, 3.0094106050126176e-16, 3.0338094660850024e-16,
+    3.0585525185448599e-16, 3.0836512748153095e-16, 3.1091178190342659e-16,
+    3.1349648459966631e-16, 3.1612057034671057e-16, 3.1878544382197131e-16,
+    3.2149258462067974e-16, 3.2424355273094516e-16, 3.2703999451822404e-16,
+    3.2988364927722831e-16, 3.3277635641716714e-16, 3.3572006335532441e-16,
+    3.3871683420455047e-16, 3.4176885935256365e-16, 3.4487846604534239e-16,
+    3.4804813010374418e-16, 3.5128048892229789e-16, 3.5457835592247914e-16,
+    3.579447366604276e-16, 3.6138284682190601e-16, 3.6489613237645421e-16,
+    3.6848829220956203e-16, 3.7216330360802068e-16, 3.7592545104162555e-16,
+    3.7977935876688739e-16, 3.8373002787892132e-16, 3.8778287856078948e-16,
+    3.9194379843114284e-16, 3.9621919807867745e-16, 4.0061607510565417e-16,
+    4.0514208829565732e-16, 4.0980564389030625e-16, 4.1461599642909046e-16,
+    4.1958336720733989e-16, 4.247190841824385e-16, 4.3003574816674707e-16,
+    4.355474314693952e-16, 4.4126991690360704e-16, 4.4722098742599323e-16,
+    4.5342077985658345e-16, 4.5989222049059325e-16, 4.6666156647114758e-16,
+    4.737590853262492e-16, 4.8121991728292379e-16, 4.8908518273922099e-16,
+    4.9740342361919398e-16, 5.0623250721441597e-16, 5.156421828878083e-16,
+    5.2571758020222748e-16, 5.3656409771120206e-16, 5.4831440342587029e-16,
+    5.6113874546751586e-16, 5.7526064815033307e-16, 5.909817641652102e-16,
+    6.0872314161809077e-16, 6.290979034877557e-16, 6.5304920535640408e-16,
+    6.8213930790289286e-16, 7.1924449660893616e-16, 7.7060953500320968e-16,
+    8.5455170385840274e-16
+};
+
+static const double rk_zig_fi_exp[256] = {
+    1, 0.93814368086217648, 0.9004699299257477,
+    0.87170433238120471, 0.8477855006239905, 0.8269932966430511,
+    0.80842165152300904, 0.79152763697249628, 0.77595685204011622,
+    0.76146338884989684, 0.74786862198519566, 0.73503809243142404,
+    0.72286765959357246, 0.71127476080507646, 0.70019265508278861,
+    0.68956649611707843, 0.67935057226476581, 0.66950631673192518,
+    0.66000084107900014, 0.65080583341457143, 0.64189671642726642,
+    0.6332519942143664, 0.6248527387036662, 0.61668218091520788,
+    0.60872538207962235, 0.60096896636523256, 0.59340090169173376,
+    0.58601031847726837, 0.57878735860284536, 0.57172304866482615,
+    0.56480919291240061, 0.55803828226258789, 0.55140341654064173,
+    0.54489823767244006, 0.53851687200286225, 0.53225388026304365,
+    0.52610421398362006, 0.52006317736823393, 0.51412639381474889,
+    0.50828977641064321, 0.50254950184134806, 0.49690198724154988,
+    0.49134386959403287, 0.48587198734188525, 0.48048336393045454,
+    0.47517519303737771, 0.46994482528396031, 0.46478975625042651,
+    0.45970761564213802, 0.45469615747461584, 0.44975325116275533,
+    0.44487687341454885, 0.44006510084235417, 0.43531610321563691,
+    0.43062813728845917, 0.42599954114303468, 0.42142872899761691,
+    0.41691418643300321, 0.41245446599716146, 0.40804818315203267,
+    0.40369401253053055, 0.39939068447523135, 0.39513698183329043,
+    0.39093173698479738, 0.38677382908413793, 0.38266218149601006,
+    0.37859575940958107, 0.37457356761590238, 0.37059464843514622,
+    0.36665807978151438, 0.362762973354818, 0.35890847294875,
+    0.35509375286678763, 0.35131801643748345, 0.34758049462163715,
+    0.34388044470450257, 0.34021714906678019, 0.33658991402867772,
+    0.3329980687618091, 0.32944096426413644, 0.32591797239355635,
+    0.32242848495608922, 0.31897191284495724, 0.31554768522712895,
+    0.31215524877417961, 0.30879406693456019, 0.30546361924459026,
+    0.30216340067569353, 0.29889292101558185, 0.29565170428126125,
+    0.29243928816189263, 0.28925522348967769, 0.28609907373707683,
+    0.28297041453878075, 0.27986883323697287, 0.2767939284485173,
+    0.27374530965280292, 0.27072259679905997, 0.26772541993204474,
+    0.26475341883506215, 0.26180624268936292, 0.25888354974901617,
+    0.25598500703041532, 0.2531102900156294, 0.25025908236886224,
+    0.24743107566532754, 0.24462596913189202, 0.24184346939887713,
+    0.23908329026244909, 0.23634515245705956, 0.23362878343743329,
+    0.23093391716962736, 0.22826029393071662, 0.22560766011668396,
+    0.22297576805812011, 0.22036437584335944, 0.21777324714870047,
+    0.21520215107537863, 0.21265086199297822, 0.21011915938898823,
+    0.20760682772422198, 0.20511365629383765, 0.20263943909370896,
+    0.20018397469191121, 0.19774706610509882, 0.19532852067956319,
+    0.1929281499767713, 0.19054576966319536, 0.18818119940425426,
+    0.18583426276219708, 0.18350478709776744, 0.18119260347549626,
+    0.17889754657247828, 0.17661945459049483, 0.17435816917135341,
+    0.17211353531531998, 0.16988540130252755, 0.16767361861725008,
+    0.16547804187493592, 0.16329852875190173, 0.16113493991759195,
+    0.15898713896931413, 0.15685499236936515, 0.15473836938446803,
+    0.1526371420274428, 0.15055118500103984, 0.14848037564386674,
+    0.14642459387834489, 0.14438372216063472, 0.14235764543247215,
+    0.1403462510748624, 0.13834942886358018, 0.13636707092642883,
+    0.1343990717022136, 0.13244532790138749, 0.13050573846833077,
+    0.1285802045452282, 0.12666862943751067, 0.12477091858083093,
+    0.12288697950954511, 0.12101672182667479, 0.11916005717532764,
+    0.11731689921155553, 0.11548716357863351, 0.11367076788274429,
+    0.11186763167005628, 0.11007767640518536, 0.10830082545103376,
+    0.10653700405000163, 0.10478613930657016, 0.1030481601712577,
+    0.10132299742595363, 0.099610583670637132, 0.097910853311492213,
+    0.096223742550432825, 0.094549189376055873, 0.092887133556043569,
+    0.091237516631040197, 0.089600281910032886, 0.087975374467270231,
+    0.086362741140756927, 0.084762330532368146, 0.083174093009632397,
+    0.081597980709237419, 0.080033947542319905, 0.078481949201606435,
+    0.076941943170480517, 0.07541388873405841, 0.073897746992364746,
+    0.072393480875708752, 0.070901055162371843, 0.069420436498728783,
+    0.067951593421936643, 0.066494496385339816, 0.065049117786753805,
+    0.063615431999807376, 0.062193415408541036, 0.06078304644547966,
+    0.05938430563342028, 0.057997175631200659, 0.05662164128374287,
+    0.05525768967669703, 0.05390531019604608, 0.052564494593071685,
+    0.051235237055126281, 0.049917534282706379, 0.048611385573379504,
+    0.047316792913181561, 0.046033761076175184, 0.044762297732943289,
+    0.043502413568888197, 0.042254122413316254, 0.04101744138041484,
+    0.039792391023374139, 0.038578995503074871, 0.037377282772959382,
+    0.036187284781931443, 0.035009037697397431, 0.033842582150874358,
+    0.032687963508959555, 0.031545232172893622, 0.030414443910466622,
+    0.029295660224637411, 0.028188948763978646, 0.027094383780955803,
+    0.026012046645134221, 0.024942026419731787, 0.023884420511558174,
+    0.02283933540638524, 0.021806887504283581, 0.020787204072578114,
+    0.01978042433800974, 0.018786700744696024, 0.017806200410911355,
+    0.016839106826039941, 0.015885621839973156, 0.014945968011691148,
+    0.014020391403181943, 0.013109164931254991, 0.012212592426255378,
+    0.0113310135978346, 0.010464810181029981, 0.0096144136425022116,
+    0.008780314985808977, 0.0079630774380170435, 0.0071633531836349908,
+    0.0063819059373191834, 0.0056196422072054891, 0.0048776559835423958,
+    0.004157295120833797, 0.003460264777836904, 0.0027887987935740757,
+    0.0021459677437189071, 0.0015362997803015726, 0.00096726928232717432,
+    0.0004541343538414966
+};
+
+#endif
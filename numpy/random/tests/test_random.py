@@ -50,6 +50,209 @@ class TestMultinomial(TestCase):
 
 
 
+class TestBulkFill(TestCase):
+    def setUp(self):
+        self.prng = random.RandomState(1234)
+        # leave the generator in the middle of a state block
+        self.prng.randint(10)
+        self.state = self.prng.get_state()
+
+    def test_random_sample(self):
+        x = self.prng.random_sample(1001)
+        self.prng.set_state(self.state)
+        y = [self.prng.random_sample() for i in range(1001)]
+        assert_array_equal(x, y)
+
+    def test_uniform(self):
+        x = self.prng.uniform(-2, 3, size=(10, 70))
+        self.prng.set_state(self.state)
+        y = [self.prng.uniform(-2, 3) for i in range(700)]
+        assert_array_equal(x.ravel(), y)
+
+    def test_exponential(self):
+        x = self.prng.exponential(2.5, size=700)
+        self.prng.set_state(self.state)
+        y = [self.prng.exponential(2.5) for i in range(700)]
+        assert_array_equal(x, y)
+
+
+class TestZiggurat(TestCase):
+    def setUp(self):
+        self.prng = random.RandomState(1234)
+
+    def test_normal_moments(self):
+        x = self.prng.standard_normal(200000, method='zig')
+        assert_(abs(x.mean()) < 0.01)
+        assert_(abs(x.var() - 1) < 0.02)
+        assert_(abs((x**4).mean() - 3) < 0.1)
+
+    def test_normal_cdf(self):
+        x = np.sort(self.prng.standard_normal(100000, method='zig'))
+        y = np.sort(self.prng.standard_normal(100000, method='polar'))
+        # two sample Kolmogorov-Smirnov statistic against the polar method
+        both = np.concatenate((x, y))
+        d = np.abs(np.searchsorted(x, both, side='right') -
+                   np.searchsorted(y, both, side='right')).max() / 1e5
+        assert_(d < 0.01)
+        assert_(abs(x).max() > 3.7)
+
+    def test_exponential_moments(self):
+        x = self.prng.standard_exponential(200000, method='zig')
+        assert_(x.min() >= 0)
+        assert_(abs(x.mean() - 1) < 0.01)
+        assert_(abs(x.var() - 1) < 0.03)
+        assert_(abs(np.mean(x > 8) - np.exp(-8)) < 1e-3)
+
+    def test_default_streams(self):
+        # the other samplers keep drawing from the default methods
+        assert_array_equal(random.RandomState(3).standard_gamma(1.0, 10),
+                           random.RandomState(3).standard_exponential(10))
+
+    def test_gamma_family(self):
+        for shape in [0.5, 1.0, 4.0]:
+            x = self.prng.standard_gamma(shape, 200000, method='zig')
+            assert_(abs(x.mean() - shape) < 0.02*shape)
+            assert_(abs(x.var() - shape) < 0.05*shape)
+        x = self.prng.gamma(4.0, 2.0, 200000, method='zig')
+        assert_(abs(x.mean() - 8) < 0.05)
+        x = self.prng.beta(2.0, 3.0, 200000, method='zig')
+        assert_(abs(x.mean() - 0.4) < 0.005)
+        x = self.prng.chisquare(3.0, 200000, method='zig')
+        assert_(abs(x.mean() - 3) < 0.03)
+        assert_(abs(x.var() - 6) < 0.15)
+        x = self.prng.standard_t(10.0, 200000, method='zig')
+        assert_(abs(x.mean()) < 0.01)
+        assert_(abs(x.var() - 1.25) < 0.04)
+
+    def test_gamma_family_streams(self):
+        # 'polar' is the default, and 'zig' is a separate stream
+        for name, args in [('standard_gamma', (4.0,)), ('gamma', (4.0, 2.0)),
+                           ('beta', (2.0, 3.0)), ('chisquare', (3.0,)),
+                           ('standard_t', (10.0,))]:
+            a = getattr(random.RandomState(3), name)(*args + (10,))
+            b = getattr(random.RandomState(3), name)(*args + (10, 'polar'))
+            c = getattr(random.RandomState(3), name)(*args + (10, 'zig'))
+            assert_array_equal(a, b)
+            assert_(not np.any(a == c))
+
+    def test_bad_method(self):
+        assert_raises(ValueError, self.prng.standard_normal, 3, 'zigg')
+        assert_raises(ValueError, self.prng.standard_exponential, 3, 'polar')
+        assert_raises(ValueError, self.prng.standard_gamma, 1.0, 3, 'inv')
+        assert_raises(ValueError, self.prng.beta, 1.0, 2.0, 3, 'zigg')
+
+
+class TestSpawn(TestCase):
+    def test_reproducible(self):
+        a = [r.random_sample(5) for r in random.RandomState(7).spawn(3)]
+        b = [r.random_sample(5) for r in random.RandomState(7).spawn(3)]
+        assert_array_equal(a, b)
+
+    def test_streams(self):
+        prng = random.RandomState(7)
+        state = prng.get_state()
+        children = prng.spawn(3)
+        # the first child continues the parent stream
+        prng2 = random.RandomState()
+        prng2.set_state(state)
+        assert_array_equal(children[0].random_sample(10),
+                           prng2.random_sample(10))
+        # the others are the parent advanced by whole jumps
+        prng2.set_state(state)
+        prng2.jump()
+        prng2.jump()
+        assert_array_equal(children[2].randint(1000, size=10),
+                           prng2.randint(1000, size=10))
+        x = [c.random_sample(1000) for c in children]
+        assert_(not np.any(x[0] == x[1]))
+        assert_(abs(np.corrcoef(x[1], x[2])[0, 1]) < 0.15)
+
+    def test_parallel_fill(self):
+        import threading
+        chunk = 1000
+        out = np.empty(10*chunk)
+        streams = random.RandomState(3).spawn(10)
+        def work(idx):
+            for i in idx:
+                out[i*chunk:(i+1)*chunk] = streams[i].random_sample(chunk)
+        threads = [threading.Thread(target=work, args=(range(k, 10, 4),))
+                   for k in range(4)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        expected = np.concatenate([r.random_sample(chunk)
+                                   for r in random.RandomState(3).spawn(10)])
+        assert_array_equal(out, expected)
+
+    def test_threaded_fill(self):
+        chunk = 2**21
+        n = 2*chunk + 5
+        prng = random.RandomState(3)
+        x = prng.random_sample(n, threads=4)
+        assert_array_equal(random.RandomState(3).random_sample(n, threads=1),
+                           x)
+        parent = random.RandomState(3)
+        streams = parent.spawn(3)
+        assert_array_equal(x[:chunk], streams[0].random_sample(chunk))
+        assert_array_equal(x[2*chunk:], streams[2].random_sample(5))
+        assert_array_equal(prng.random_sample(10), parent.random_sample(10))
+        assert_array_equal(
+            random.RandomState(3).uniform(2, 5, (n, 1), threads=3)[:, 0],
+            2 + 3*x)
+        self.assertRaises(ValueError, random.random_sample, 10, 0)
+
+
+class TestShuffle(TestCase):
+    def shuffled_list(self, n, seed):
+        x = range(n)
+        random.RandomState(seed).shuffle(x)
+        return x
+
+    def test_1d(self):
+        for dt in [np.int8, np.float64, np.complex128, object, 'S5']:
+            x = np.arange(50).astype(dt)
+            random.RandomState(5).shuffle(x)
+            assert_array_equal(x, np.arange(50).astype(dt)[
+                                        self.shuffled_list(50, 5)])
+
+    def test_rows(self):
+        x = np.arange(300).reshape(50, 3, 2)
+        random.RandomState(5).shuffle(x)
+        assert_array_equal(x, np.arange(300).reshape(50, 3, 2)[
+                                    self.shuffled_list(50, 5)])
+
+    def test_strided(self):
+        a = np.arange(400).reshape(100, 2, 2)
+        b = a.copy()
+        x = a[::2, :, ::-1]
+        random.RandomState(5).shuffle(x)
+        assert_array_equal(x, b[::2, :, ::-1][self.shuffled_list(50, 5)])
+        assert_array_equal(a[1::2], b[1::2])
+        # contiguous rows, swapped in place with a stride of two rows
+        a = np.arange(400).reshape(100, 2, 2)
+        b = a.copy()
+        x = a[::2]
+        random.RandomState(5).shuffle(x)
+        assert_array_equal(x, b[::2][self.shuffled_list(50, 5)])
+        assert_array_equal(a[1::2], b[1::2])
+
+    def test_masked(self):
+        mask = np.arange(50) % 3 == 0
+        x = np.ma.array(np.arange(50), mask=mask.copy())
+        random.RandomState(5).shuffle(x)
+        order = self.shuffled_list(50, 5)
+        assert_array_equal(x.mask, mask[order])
+        assert_array_equal(x.compressed(),
+                           np.arange(50)[order][~mask[order]])
+
+    def test_permutation(self):
+        assert_array_equal(random.RandomState(5).permutation(50),
+                           self.shuffled_list(50, 5))
+        assert_array_equal(np.sort(random.permutation(np.arange(10.))),
+                           np.arange(10.))
+
+
 class TestSetState(TestCase):
     def setUp(self):
         self.seed = 1234567890